@@ -0,0 +1,143 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <system_error>
+#include <tuple>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/sockaddr.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+/* Compares draining a non-blocking socket until EAGAIN with the
+ * throwing recv, which ends every drain with an exception, against
+ * the std::nothrow recv
+ *
+ * Each wakeup sends a burst of datagrams to the socket and drains it.
+ *
+ * Usage: bench-nothrow_drain [wakeups] [burst size]
+ */
+
+struct sockets
+{
+    sockets():
+        receiver {AF_INET},
+        sender {AF_INET}
+    {
+        receiver.bind(linuxpp::net::inaddr_loopback);
+        const int fd = receiver.descriptor();
+        linuxpp::fcntl(fd, F_SETFL, linuxpp::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+        ndgpp::net::ipv4_address addr;
+        ndgpp::net::port port;
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(fd);
+        destination = linuxpp::net::make_sockaddr(addr, port);
+    }
+
+    void burst(const std::size_t burst_size)
+    {
+        for (std::size_t i = 0; i < burst_size; ++i)
+        {
+            sender.send(buffer.data(), 64, destination);
+        }
+    }
+
+    linuxpp::net::udp_socket receiver;
+    linuxpp::net::udp_socket sender;
+    struct ::sockaddr_in destination;
+    std::array<char, 2048> buffer {};
+};
+
+static std::chrono::nanoseconds run_throwing(const std::size_t wakeups,
+                                             const std::size_t burst_size)
+{
+    sockets s;
+    std::size_t received = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t w = 0; w < wakeups; ++w)
+    {
+        s.burst(burst_size);
+        try
+        {
+            while (true)
+            {
+                s.receiver.recv(s.buffer.data(), s.buffer.size());
+                ++received;
+            }
+        }
+        catch (const std::system_error & error)
+        {
+            if (error.code().value() != EAGAIN)
+            {
+                throw;
+            }
+        }
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (received != wakeups * burst_size)
+    {
+        std::cerr << "datagrams were dropped\n";
+    }
+
+    return elapsed;
+}
+
+static std::chrono::nanoseconds run_nothrow(const std::size_t wakeups,
+                                            const std::size_t burst_size)
+{
+    sockets s;
+    std::size_t received = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t w = 0; w < wakeups; ++w)
+    {
+        s.burst(burst_size);
+        while (s.receiver.recv(std::nothrow, s.buffer.data(), s.buffer.size()))
+        {
+            ++received;
+        }
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (received != wakeups * burst_size)
+    {
+        std::cerr << "datagrams were dropped\n";
+    }
+
+    return elapsed;
+}
+
+static void report(const char * const name,
+                   const std::size_t wakeups,
+                   const std::chrono::nanoseconds elapsed)
+{
+    std::cout << name << ": " << elapsed.count() / wakeups << " ns/wakeup\n";
+}
+
+int main(int argc, char ** argv)
+{
+    const std::size_t wakeups = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::size_t burst_size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1;
+    if (wakeups == 0 || burst_size == 0)
+    {
+        std::cerr << "invalid arguments\n";
+        return 1;
+    }
+
+    std::cout << wakeups << " wakeups of " << burst_size << " datagrams\n";
+
+    report("throwing recv", wakeups, run_throwing(wakeups, burst_size));
+    report("std::nothrow recv", wakeups, run_nothrow(wakeups, burst_size));
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <sys/eventfd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <liblinuxpp/eventfd.hpp>
+#include <liblinuxpp/notifier.hpp>
+
+/* Compares signaling a consumer with an eventfd write per event
+ * against linuxpp::notifier under producer contention
+ *
+ * Usage: bench-notifier [producers] [events per producer]
+ */
+
+struct result
+{
+    std::chrono::nanoseconds elapsed;
+    std::uint64_t syscalls;
+};
+
+static result run_eventfd(const unsigned int producers, const std::uint64_t events)
+{
+    linuxpp::eventfd eventfd;
+    std::atomic<std::uint64_t> produced {0};
+    const std::uint64_t total = producers * events;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&] () {
+                for (std::uint64_t i = 0; i < events; ++i)
+                {
+                    produced.fetch_add(1, std::memory_order_relaxed);
+                    eventfd.write();
+                }
+            });
+    }
+
+    std::uint64_t consumed = 0;
+    while (consumed < total)
+    {
+        eventfd.read();
+        consumed = produced.load(std::memory_order_relaxed);
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    return result {std::chrono::steady_clock::now() - start, total};
+}
+
+static result run_notifier(const unsigned int producers, const std::uint64_t events)
+{
+    linuxpp::notifier notifier;
+    std::atomic<std::uint64_t> produced {0};
+    std::atomic<std::uint64_t> syscalls {0};
+    const std::uint64_t total = producers * events;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&] () {
+                std::uint64_t writes = 0;
+                for (std::uint64_t i = 0; i < events; ++i)
+                {
+                    produced.fetch_add(1, std::memory_order_relaxed);
+                    writes += notifier.notify() ? 1 : 0;
+                }
+
+                syscalls += writes;
+            });
+    }
+
+    std::uint64_t consumed = 0;
+    while (consumed < total)
+    {
+        notifier.prepare_wait();
+        if (produced.load(std::memory_order_relaxed) == consumed)
+        {
+            notifier.wait();
+        }
+
+        notifier.finish_wait();
+        consumed = produced.load(std::memory_order_relaxed);
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    return result {std::chrono::steady_clock::now() - start, syscalls.load()};
+}
+
+static void report(const char * const name, const result r, const std::uint64_t total)
+{
+    const double seconds = r.elapsed.count() / 1e9;
+    std::cout << name
+              << ": " << seconds * 1000 << " ms, "
+              << total / seconds / 1e6 << " M events/s, "
+              << r.syscalls << " eventfd writes ("
+              << 100.0 * r.syscalls / total << "% of events)\n";
+}
+
+int main(int argc, char ** argv)
+{
+    const unsigned int producers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    const std::uint64_t events = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    if (producers == 0 || events == 0)
+    {
+        std::cerr << "producers and events must be greater than 0\n";
+        return 1;
+    }
+
+    report("eventfd ", run_eventfd(producers, events), producers * events);
+    report("notifier", run_notifier(producers, events), producers * events);
+    return 0;
+}
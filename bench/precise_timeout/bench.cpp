@@ -0,0 +1,107 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <liblinuxpp/ioloop.hpp>
+
+/* Measures how late ioloop timeout callbacks are called
+ *
+ * Usage: bench-precise_timeout [count] [interval in microseconds]
+ *
+ * Schedules count timeouts, one at a time, each interval after the
+ * previous timeout, and reports the lateness distribution of regular
+ * and precise timeouts.
+ */
+
+struct run_state
+{
+    linuxpp::ioloop * ioloop;
+    bool precise;
+    std::size_t remaining;
+    std::chrono::microseconds interval;
+    linuxpp::ioloop::time_type timeout;
+    std::vector<std::chrono::nanoseconds> lateness;
+};
+
+static void schedule(run_state & state);
+
+static void expired(run_state & state)
+{
+    state.lateness.push_back(std::chrono::steady_clock::now() - state.timeout);
+    if (--state.remaining == 0)
+    {
+        state.ioloop->stop();
+        return;
+    }
+
+    schedule(state);
+}
+
+static void schedule(run_state & state)
+{
+    state.timeout = std::chrono::steady_clock::now() + state.interval;
+    if (state.precise)
+    {
+        state.ioloop->add_timeout(linuxpp::precise, state.timeout, [&state] () { expired(state); });
+    }
+    else
+    {
+        state.ioloop->add_timeout(state.timeout, [&state] () { expired(state); });
+    }
+}
+
+static void report(const char * const name,
+                   std::vector<std::chrono::nanoseconds> lateness)
+{
+    std::sort(lateness.begin(), lateness.end());
+    auto percentile = [&lateness] (const double p) {
+        const auto index = static_cast<std::size_t>(p * (lateness.size() - 1));
+        return lateness[index].count() / 1000.0;
+    };
+
+    std::cout << name
+              << " lateness us: p50 " << percentile(0.5)
+              << " p90 " << percentile(0.9)
+              << " p99 " << percentile(0.99)
+              << " p99.9 " << percentile(0.999)
+              << " max " << lateness.back().count() / 1000.0
+              << '\n';
+}
+
+static std::vector<std::chrono::nanoseconds> run(const bool precise,
+                                                 const std::size_t count,
+                                                 const std::chrono::microseconds interval,
+                                                 std::chrono::nanoseconds & margin)
+{
+    linuxpp::ioloop ioloop;
+    run_state state {&ioloop, precise, count, interval, {}, {}};
+    state.lateness.reserve(count);
+
+    schedule(state);
+    ioloop.start();
+
+    margin = ioloop.precise_timeout_margin();
+    return state.lateness;
+}
+
+int main(int argc, char ** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const std::chrono::microseconds interval {argc > 2 ? std::strtol(argv[2], nullptr, 10) : 1000};
+
+    if (count == 0)
+    {
+        std::cerr << "count must be greater than 0\n";
+        return 1;
+    }
+
+    std::chrono::nanoseconds margin;
+    report("regular", run(false, count, interval, margin));
+    report("precise", run(true, count, interval, margin));
+    std::cout << "final precise margin us: " << margin.count() / 1000.0 << '\n';
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <tuple>
+
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/message_batch.hpp>
+#include <liblinuxpp/net/sockaddr.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+/* Compares moving datagrams over loopback one per system call
+ * against sendmmsg and recvmmsg batches
+ *
+ * Usage: bench-udp_batch [bursts] [burst size] [datagram size]
+ */
+
+struct sockets
+{
+    sockets():
+        receiver {AF_INET},
+        sender {AF_INET}
+    {
+        receiver.bind(linuxpp::net::inaddr_loopback);
+        ndgpp::net::ipv4_address addr;
+        ndgpp::net::port port;
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(receiver.descriptor());
+        destination = linuxpp::net::make_sockaddr(addr, port);
+
+        sender.bind(linuxpp::net::inaddr_loopback);
+    }
+
+    linuxpp::net::udp_socket receiver;
+    linuxpp::net::udp_socket sender;
+    struct ::sockaddr_in destination;
+};
+
+static std::chrono::nanoseconds run_single(const std::size_t bursts,
+                                           const std::size_t burst_size,
+                                           const std::size_t datagram_size)
+{
+    sockets s;
+    std::array<char, 65536> buffer {};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t b = 0; b < bursts; ++b)
+    {
+        // The burst size is kept well below the socket's receive
+        // buffer so no datagrams are dropped
+        for (std::size_t i = 0; i < burst_size; ++i)
+        {
+            s.sender.send(buffer.data(), datagram_size, s.destination);
+        }
+
+        for (std::size_t i = 0; i < burst_size; ++i)
+        {
+            s.receiver.recv(buffer.data(), buffer.size());
+        }
+    }
+
+    return std::chrono::steady_clock::now() - start;
+}
+
+static std::chrono::nanoseconds run_batch(const std::size_t bursts,
+                                          const std::size_t burst_size,
+                                          const std::size_t datagram_size)
+{
+    sockets s;
+    linuxpp::net::message_batch send_batch {burst_size, datagram_size};
+    linuxpp::net::message_batch recv_batch {burst_size, datagram_size};
+    for (std::size_t i = 0; i < burst_size; ++i)
+    {
+        std::memset(send_batch.buffer(i), 0, datagram_size);
+        send_batch.set_address(i, s.destination);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t b = 0; b < bursts; ++b)
+    {
+        std::size_t sent = 0;
+        while (sent < burst_size)
+        {
+            sent += s.sender.send(send_batch, burst_size - sent);
+        }
+
+        std::size_t received = 0;
+        while (received < burst_size)
+        {
+            received += s.receiver.recv(recv_batch, MSG_WAITFORONE);
+        }
+    }
+
+    return std::chrono::steady_clock::now() - start;
+}
+
+static void report(const char * const name,
+                   const std::size_t packets,
+                   const std::chrono::nanoseconds elapsed)
+{
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << name << ": "
+              << static_cast<unsigned long>(packets / seconds) << " packets/s, "
+              << elapsed.count() / packets << " ns/packet\n";
+}
+
+int main(int argc, char ** argv)
+{
+    const std::size_t bursts = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t burst_size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 32;
+    const std::size_t datagram_size = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 64;
+    if (bursts == 0 || burst_size == 0 || datagram_size == 0 || datagram_size > 65507)
+    {
+        std::cerr << "invalid arguments\n";
+        return 1;
+    }
+
+    const std::size_t packets = bursts * burst_size;
+    std::cout << packets << " datagrams of " << datagram_size
+              << " bytes in bursts of " << burst_size << '\n';
+
+    report("send/recv", packets, run_single(bursts, burst_size, datagram_size));
+    report("sendmmsg/recvmmsg", packets, run_batch(bursts, burst_size, datagram_size));
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <liblinuxpp/epoll.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/tcp_options.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/net/zerocopy_sender.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+/* Compares copying sends against MSG_ZEROCOPY sends over a loopback
+ * TCP connection for a range of send sizes, to find the size where
+ * zero-copy starts to pay off
+ *
+ * Zero-copy sends cycle through a set of buffers, and a buffer is
+ * only reused once the kernel reports its sends as complete.  A TCP
+ * send completes when its data is acknowledged, so the set has to
+ * cover the ACK latency, or small sends stall on delayed ACKs.
+ *
+ * Loopback can't actually send from the pages, the kernel copies
+ * them when they're delivered to the receiving socket, so this
+ * measures the cost of the completion handling on top of a copy.  A
+ * real NIC is needed to see the benefit.
+ *
+ * Usage: bench-zerocopy_send [megabytes per size]
+ */
+
+namespace
+{
+    constexpr std::size_t buffer_count = 64;
+
+    struct connection
+    {
+        connection():
+            server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback},
+            client {AF_INET}
+        {
+            server.listen(1);
+
+            ndgpp::net::ipv4_address addr;
+            ndgpp::net::port port;
+            std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+            client.connect(addr, port);
+            accepted.reset(server.accept());
+            linuxpp::net::setsockopt<linuxpp::net::so::tcp_nodelay>(client.descriptor(), 1);
+        }
+
+        linuxpp::net::tcp_socket server;
+        linuxpp::net::tcp_socket client;
+        linuxpp::unique_fd<> accepted;
+    };
+
+    /// Drains total bytes from the connection in another thread
+    std::thread start_receiver(connection & c, const std::size_t total)
+    {
+        return std::thread {[&c, total] () {
+            std::vector<char> buffer(1 << 20);
+            std::size_t received = 0;
+            while (received < total)
+            {
+                received += linuxpp::net::recv(c.accepted.get(), buffer.data(), buffer.size());
+            }
+        }};
+    }
+
+    std::chrono::nanoseconds run_copy(const std::size_t size, const std::size_t total)
+    {
+        connection c;
+        std::vector<char> buffer(size, 'c');
+        std::thread receiver = start_receiver(c, total);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t sent = 0;
+        while (sent < total)
+        {
+            sent += linuxpp::net::send(c.client.descriptor(), buffer.data(), size);
+        }
+
+        receiver.join();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    std::chrono::nanoseconds run_zerocopy(const std::size_t size, const std::size_t total)
+    {
+        connection c;
+        linuxpp::net::zerocopy_sender sender {c.client.descriptor(), 0};
+        std::array<std::vector<char>, buffer_count> buffers;
+        std::array<std::size_t, buffer_count> in_flight {};
+        for (auto & buffer : buffers)
+        {
+            buffer.assign(size, 'z');
+        }
+
+        linuxpp::epoll epoll;
+        epoll.add(c.client.descriptor(), EPOLLERR);
+
+        std::thread receiver = start_receiver(c, total);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t sent = 0;
+        for (std::size_t i = 0; sent < total; i = (i + 1) % buffer_count)
+        {
+            while (in_flight[i] != 0)
+            {
+                if (sender.process_completions() == 0)
+                {
+                    epoll.wait(std::chrono::seconds {1});
+                }
+            }
+
+            std::size_t offset = 0;
+            while (offset < size)
+            {
+                ++in_flight[i];
+                const auto ret = sender.send(buffers[i].data() + offset,
+                                             size - offset,
+                                             [&in_flight, i] (bool) { --in_flight[i]; });
+                if (!ret)
+                {
+                    std::cerr << "send failed: " << ret.errno_value() << '\n';
+                    std::exit(1);
+                }
+
+                offset += static_cast<std::size_t>(ret.return_value());
+            }
+
+            sent += size;
+        }
+
+        receiver.join();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        while (sender.pending() != 0)
+        {
+            sender.process_completions();
+        }
+
+        return elapsed;
+    }
+
+    double gigabits(const std::size_t bytes, const std::chrono::nanoseconds elapsed)
+    {
+        return static_cast<double>(bytes) * 8 / static_cast<double>(elapsed.count());
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    const std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    if (megabytes == 0)
+    {
+        std::cerr << "invalid arguments\n";
+        return 1;
+    }
+
+    std::cout << "send size, copy Gbit/s, zero-copy Gbit/s\n";
+    for (std::size_t size = 1024; size <= (1 << 20); size *= 2)
+    {
+        const std::size_t total = (megabytes << 20) / size * size;
+        const auto copy = run_copy(size, total);
+        const auto zerocopy = run_zerocopy(size, total);
+        std::cout << size << ", "
+                  << gigabits(total, copy) << ", "
+                  << gigabits(total, zerocopy) << std::endl;
+    }
+
+    return 0;
+}
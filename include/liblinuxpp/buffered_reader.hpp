@@ -0,0 +1,152 @@
+#ifndef LIBLINUXPP_BUFFERED_READER_HPP
+#define LIBLINUXPP_BUFFERED_READER_HPP
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <memory>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/syscall_return.hpp>
+
+namespace linuxpp
+{
+    /** Reads delimiter separated records from a file descriptor
+     *
+     *  Each read fills as much of a reusable buffer as the
+     *  descriptor has available, and the records are found with
+     *  linuxpp::find_byte, which scans 16 or 32 bytes at a time.  The
+     *  records are handed out as pointers into the buffer, without
+     *  the delimiter, so they're only valid during the handler call.
+     *  A record that's split across reads is moved to the front of
+     *  the buffer, which grows up to the maximum record size to fit
+     *  it.  The remainder at the end of file is handed out as the
+     *  last record.
+     *
+     *  The file descriptor isn't owned and must outlive the
+     *  buffered_reader.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class buffered_reader final
+    {
+        public:
+
+        /** Called with each record
+         *
+         *  The reader must not be destroyed from the handler.
+         *
+         *  @param record The record's first byte
+         *  @param length The record's length, excluding the delimiter
+         */
+        using record_handler = std::function<void (char const * record, std::size_t length)>;
+
+        /** Called once when an attached reader is done and detached from its ioloop
+         *
+         *  The reader may be destroyed from the handler.
+         *
+         *  @param errno_value 0 at the end of file, otherwise the
+         *                     error that stopped the reader, e.g.
+         *                     EMSGSIZE for a record larger than the
+         *                     maximum record size
+         */
+        using done_handler = std::function<void (int errno_value)>;
+
+        static constexpr std::size_t default_buffer_size = 65536;
+
+        /** Constructs a buffered_reader object
+         *
+         *  @param fd The file descriptor to read from
+         *  @param delimiter The byte that ends each record
+         *  @param buffer_size The buffer's initial size, and the most
+         *                     read at once
+         *  @param max_record_size The largest record, 0 limits it to
+         *                         buffer_size
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if buffer_size
+         *          is 0 or greater than max_record_size
+         */
+        explicit
+        buffered_reader(const int fd,
+                        const char delimiter = '\n',
+                        const std::size_t buffer_size = default_buffer_size,
+                        const std::size_t max_record_size = 0);
+
+        ~buffered_reader();
+
+        buffered_reader(const buffered_reader &) = delete;
+        buffered_reader & operator= (const buffered_reader &) = delete;
+
+        buffered_reader(buffered_reader &&) = delete;
+        buffered_reader & operator= (buffered_reader &&) = delete;
+
+        /** Reads once and calls handler with the records completed by the read
+         *
+         *  Errors, including EAGAIN, are returned instead of thrown.
+         *  A record that doesn't fit in the maximum record size fails
+         *  the read with EMSGSIZE, and the data read so far is
+         *  dropped.  The following reads skip the rest of the record
+         *  through the next delimiter, so it's never handed out as a
+         *  record, and then resume with the next record.
+         *
+         *  @return The number of bytes read, 0 at the end of file
+         */
+        linuxpp::syscall_return<::ssize_t> read(const record_handler & handler);
+
+        /// Returns the number of bytes of the incomplete record
+        std::size_t buffered() const noexcept;
+
+        /// Returns true if the end of file was reached
+        bool eof() const noexcept;
+
+        /** Makes the descriptor non-blocking and reads from an ioloop
+         *
+         *  @param loop The ioloop to read from
+         *  @param records Called with each record
+         *  @param done Called at the end of file or when a read fails
+         *
+         *  @throws std::logic_error if the reader is already attached
+         *          to an ioloop
+         */
+        void attach(linuxpp::ioloop & loop,
+                    record_handler records,
+                    done_handler done);
+
+        /// Removes the descriptor from the ioloop it's attached to
+        void detach();
+
+        /// Returns the file descriptor
+        int descriptor() const noexcept;
+
+        private:
+
+        void handle_events();
+
+        int fd_;
+        char delimiter_;
+        std::size_t max_record_size_;
+
+        std::unique_ptr<char[]> buffer_;
+        std::size_t capacity_;
+
+        // The incomplete record is [begin_, end_), and [begin_, scanned_)
+        // is known not to contain the delimiter
+        std::size_t begin_ = 0;
+        std::size_t scanned_ = 0;
+        std::size_t end_ = 0;
+        bool eof_ = false;
+
+        // Set while skipping the rest of a record larger than
+        // max_record_size_
+        bool discarding_ = false;
+
+        linuxpp::ioloop * loop_ = nullptr;
+        record_handler record_handler_;
+        done_handler done_handler_;
+    };
+}
+
+#endif
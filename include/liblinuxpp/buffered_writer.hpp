@@ -0,0 +1,210 @@
+#ifndef LIBLINUXPP_BUFFERED_WRITER_HPP
+#define LIBLINUXPP_BUFFERED_WRITER_HPP
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/syscall_return.hpp>
+
+namespace linuxpp
+{
+    /** Buffers writes to a file descriptor and flushes them with one system call
+     *
+     *  Writes are copied into fixed size chunks, which are reused
+     *  once flushed, and a flush sends up to IOV_MAX chunks with a
+     *  single writev, or sendmsg with MSG_NOSIGNAL for a socket.
+     *  What a partial write left is tracked by the writer, so callers
+     *  never deal with offsets into their own buffers.
+     *
+     *  Attached to an ioloop, the writer flushes once per iteration,
+     *  after the handlers that wrote to it, and when the descriptor
+     *  can't take more it waits for the descriptor to become
+     *  writable, so the write event is only monitored while there's
+     *  a backlog.
+     *
+     *  The high and low watermarks bound the backlog: write returns
+     *  false once the backlog reaches the high watermark, and the
+     *  drain handler is called when it's flushed down to the low
+     *  watermark.
+     *
+     *  The file descriptor isn't owned and must outlive the
+     *  buffered_writer.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class buffered_writer final
+    {
+        public:
+
+        /// Called when the backlog drops to the low watermark after reaching the high watermark
+        using drain_handler = std::function<void ()>;
+
+        /** Called when a flush from the ioloop fails
+         *
+         *  The backlog is dropped, later writes are discarded, and
+         *  the writer may be destroyed from the handler.
+         *
+         *  @param errno_value The error that failed the flush, e.g. EPIPE
+         */
+        using error_handler = std::function<void (int errno_value)>;
+
+        /// Called with the events of an attached descriptor other than the write event
+        using event_handler = std::function<void (int fd, uint32_t events)>;
+
+        static constexpr std::size_t default_chunk_size = 16384;
+        static constexpr std::size_t default_high_watermark = 1024 * 1024;
+        static constexpr std::size_t default_low_watermark = 256 * 1024;
+
+        /** Constructs a buffered_writer object
+         *
+         *  @param fd The file descriptor to write to
+         *  @param high_watermark The backlog at which write returns false
+         *  @param low_watermark The backlog at which the drain handler is called
+         *  @param chunk_size The size of each buffer chunk
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if chunk_size
+         *          is 0 or low_watermark is greater than high_watermark
+         *
+         *  @throws ndgpp::error<std::system_error> if fd can't be fstat'ed
+         */
+        explicit
+        buffered_writer(const int fd,
+                        const std::size_t high_watermark = default_high_watermark,
+                        const std::size_t low_watermark = default_low_watermark,
+                        const std::size_t chunk_size = default_chunk_size);
+
+        ~buffered_writer();
+
+        buffered_writer(const buffered_writer &) = delete;
+        buffered_writer & operator= (const buffered_writer &) = delete;
+
+        buffered_writer(buffered_writer &&) = delete;
+        buffered_writer & operator= (buffered_writer &&) = delete;
+
+        /** Appends data to the backlog
+         *
+         *  The data is always accepted, so honoring the return value
+         *  is up to the caller.
+         *
+         *  @param buf The data to write
+         *  @param length The number of bytes to write
+         *
+         *  @return false if the backlog reached the high watermark,
+         *          or a flush from the ioloop failed
+         *
+         *  @throws std::bad_alloc if a chunk can't be allocated
+         */
+        bool write(void const * const buf, const std::size_t length);
+
+        /** Writes up to IOV_MAX chunks of the backlog with one system call
+         *
+         *  Errors, including EAGAIN, are returned instead of thrown.
+         *  The drain handler is called once the backlog is consumed.
+         *
+         *  @return The number of bytes written
+         *
+         *  @throws Whatever the drain handler throws
+         */
+        linuxpp::syscall_return<::ssize_t> flush();
+
+        /// Returns the number of bytes waiting to be written
+        std::size_t buffered() const noexcept;
+
+        /// Returns true if the backlog reached the high watermark and hasn't drained to the low watermark
+        bool above_high_watermark() const noexcept;
+
+        /// Returns true if the writer is waiting for its attached descriptor to become writable
+        bool blocked() const noexcept;
+
+        /// Returns the error that failed a flush from the ioloop, or 0
+        int error() const noexcept;
+
+        void set_drain_handler(drain_handler handler);
+
+        /** Makes the descriptor non-blocking and flushes it from an ioloop
+         *
+         *  An ioloop has one handler per file descriptor, so a
+         *  descriptor that's also read from passes its read handler,
+         *  which the writer registers along with its own.
+         *
+         *  @param loop The ioloop to flush from
+         *  @param handler Called when a flush fails
+         *  @param events_handler Called with the descriptor's read and
+         *                        error events, or nullptr if the
+         *                        descriptor is only written to
+         *
+         *  @throws std::logic_error if the writer is already attached
+         *          to an ioloop
+         */
+        void attach(linuxpp::ioloop & loop,
+                    error_handler handler,
+                    event_handler events_handler = nullptr);
+
+        /// Removes the writer and the descriptor from the ioloop they're attached to
+        void detach();
+
+        /// Returns the file descriptor
+        int descriptor() const noexcept;
+
+        private:
+
+        struct chunk
+        {
+            std::unique_ptr<unsigned char[]> data;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        std::unique_ptr<unsigned char[]> allocate_chunk();
+
+        /// Removes the written bytes from the front of the backlog
+        void consume(std::size_t length) noexcept;
+
+        /** Flushes from the ioloop and waits for the descriptor to become writable if it's full
+         *
+         *  @return false if the flush failed and the error handler was called
+         */
+        bool flush_attached();
+
+        /// Starts or stops monitoring the descriptor's write event
+        void set_blocked(const bool blocked);
+
+        /// The ioloop handler of the descriptor
+        void handle_events(const uint32_t events);
+
+        void fail(const int errno_value);
+
+        int fd_;
+        bool socket_;
+        std::size_t high_watermark_;
+        std::size_t low_watermark_;
+        std::size_t chunk_size_;
+
+        std::deque<chunk> chunks_;
+        std::vector<std::unique_ptr<unsigned char[]>> free_chunks_;
+        std::size_t max_free_chunks_;
+        std::vector<struct ::iovec> iovecs_;
+        std::size_t buffered_ = 0;
+
+        bool above_high_watermark_ = false;
+        drain_handler drain_handler_;
+
+        linuxpp::ioloop * loop_ = nullptr;
+        linuxpp::ioloop::iteration_handle iteration_;
+        error_handler error_handler_;
+        event_handler event_handler_;
+        bool blocked_ = false;
+        int error_ = 0;
+    };
+}
+
+#endif
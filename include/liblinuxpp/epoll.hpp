@@ -134,6 +134,15 @@ namespace linuxpp
          */
         linuxpp::syscall_return<int> wait(std::nothrow_t, std::vector<epoll_event> & events);
 
+        /** Waits for an event on the monitored file descriptors
+         *
+         *  @return A linuxpp::syscall_return<int> object representing
+         *  the return status of the system call
+         */
+        linuxpp::syscall_return<int> wait(std::nothrow_t,
+                                          std::vector<epoll_event> & events,
+                                          const std::chrono::milliseconds timeout);
+
         /** Waits for an event on the monitored file descriptors
          *
          *  @throws ndgpp::error<std::system_error> if an error is encountered
@@ -149,6 +158,7 @@ namespace linuxpp
         void add(const int fd, epoll_event event);
         void mod(const int fd, epoll_event event);
         void wait(std::vector<epoll_event>& events, const int timeout);
+        linuxpp::syscall_return<int> wait(std::nothrow_t, std::vector<epoll_event> & events, const int timeout);
 
         enum members
         {
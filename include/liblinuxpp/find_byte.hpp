@@ -0,0 +1,49 @@
+#ifndef LIBLINUXPP_FIND_BYTE_HPP
+#define LIBLINUXPP_FIND_BYTE_HPP
+
+namespace linuxpp
+{
+    /// The instruction sets find_byte is implemented with
+    enum class find_byte_isa
+    {
+        scalar,
+        sse2,
+        avx2,
+    };
+
+    /** Returns the widest instruction set find_byte can use on this CPU
+     *
+     *  AVX2 is detected at run time, SSE2 is available whenever the
+     *  library is built for x86.
+     */
+    linuxpp::find_byte_isa find_byte_supported() noexcept;
+
+    /** Returns the first occurrence of a byte in a range
+     *
+     *  Compares 32 bytes at a time with AVX2, or 16 with SSE2, when
+     *  the CPU supports it.
+     *
+     *  @param first The beginning of the range
+     *  @param last The end of the range
+     *  @param value The byte to find
+     *
+     *  @return The position of the byte, or last if it isn't found
+     */
+    char const * find_byte(char const * first,
+                           char const * last,
+                           const char value) noexcept;
+
+    /** Returns the first occurrence of a byte in a range using a given instruction set
+     *
+     *  @param isa The instruction set to use, which must not be
+     *             wider than find_byte_supported
+     *
+     *  @see find_byte(char const *, char const *, char)
+     */
+    char const * find_byte(const linuxpp::find_byte_isa isa,
+                           char const * first,
+                           char const * last,
+                           const char value) noexcept;
+}
+
+#endif
@@ -2,6 +2,10 @@
 #define LIBLINUXPP_IOLOOP_HPP
 
 #include <signal.h>
+#include <sys/signalfd.h>
+
+#include <cstddef>
+#include <cstdint>
 
 #include <algorithm>
 #include <chrono>
@@ -15,6 +19,10 @@
 #include <liblinuxpp/epoll.hpp>
 #include <liblinuxpp/eventfd.hpp>
 #include <liblinuxpp/monotonic_timerfd.hpp>
+#include <liblinuxpp/notifier.hpp>
+#include <liblinuxpp/precise.hpp>
+#include <liblinuxpp/signalfd.hpp>
+#include <liblinuxpp/thread_tuning.hpp>
 
 namespace linuxpp
 {
@@ -32,6 +40,8 @@ namespace linuxpp
 
         class timeout_handle;
         class periodic_timeout_handle;
+        class iteration_handle;
+        class batch_group_handle;
 
         struct event_enum
         {
@@ -40,9 +50,31 @@ namespace linuxpp
                 read = 1,
                 write = 2,
                 error = 4,
+
+                /** Wakes only one of the ioloops monitoring the same file descriptor
+                 *
+                 *  Uses EPOLLEXCLUSIVE, so it's only valid for
+                 *  add_handler and add_batch_handler, and the
+                 *  events of such a handler can't be modified.
+                 */
+                exclusive = 8,
             };
         };
 
+        /// A ready file descriptor passed to a batch group's callback
+        struct batch_event
+        {
+            int fd;
+
+            /// The events that occurred, a combination of ioloop::event_enum values
+            uint32_t events;
+
+            /// The user data provided to add_batch_handler
+            void * user_data;
+        };
+
+        using batch_callback = std::function<void (const batch_event * events, std::size_t count)>;
+
         ioloop();
 
         ioloop(const ioloop &) = delete;
@@ -62,7 +94,8 @@ namespace linuxpp
          *                events defined in ioloop::event_enum
          *
          *  @param callback The function to call when the specified
-         *         event has occured on the file descriptor
+         *         event has occured on the file descriptor.  It's
+         *         passed the events that occurred.
          */
         void
         add_handler(const int fd,
@@ -70,12 +103,71 @@ namespace linuxpp
                     std::function<void (int fd, uint32_t events)> callback);
 
         /** Removes a file descriptor handler
+         *
+         *  Also removes file descriptors added with add_batch_handler
          *
          *  @param fd The file descriptor who's handler to remove
          */
         void
         remove_handler(const int fd);
 
+        /** Changes the events a file descriptor handler monitors
+         *
+         *  Also applies to file descriptors added with
+         *  add_batch_handler
+         *
+         *  @param fd The file descriptor who's events to change
+         *
+         *  @param events The events to monitor, a combination of the
+         *                events defined in ioloop::event_enum
+         *
+         *  @throws ndgpp::error<std::runtime_error> if fd isn't handled
+         */
+        void
+        modify_handler(const int fd, const uint32_t events);
+
+        /** Adds a batch group
+         *
+         *  A batch group has one callback for all of its file
+         *  descriptors.  The callback is called at most once per
+         *  ioloop iteration, after the individual file descriptor
+         *  handlers, with every file descriptor of the group that
+         *  was ready in that iteration.  This allows the application
+         *  to batch work across the set, e.g. with recvmmsg.
+         *
+         *  @param callback The function to call with the ready file
+         *                  descriptors of the group
+         */
+        linuxpp::ioloop::batch_group_handle
+        add_batch_group(batch_callback callback);
+
+        /** Removes a batch group and all of its file descriptors
+         *
+         *  @param group The group to remove
+         */
+        void
+        remove_batch_group(const linuxpp::ioloop::batch_group_handle group);
+
+        /** Adds a file descriptor to a batch group
+         *
+         *  @param group The group to add the file descriptor to
+         *
+         *  @param fd The file descriptor to monitor
+         *
+         *  @param events The events to monitor, must be one of the
+         *                events defined in ioloop::event_enum
+         *
+         *  @param user_data Passed back in the fd's batch_event
+         *
+         *  @throws ndgpp::error<std::runtime_error> if the group does
+         *          not exist or fd is already handled
+         */
+        void
+        add_batch_handler(const linuxpp::ioloop::batch_group_handle group,
+                          const int fd,
+                          const uint32_t events,
+                          void * const user_data);
+
         linuxpp::ioloop::timeout_handle
         add_timeout(const ioloop::time_type timeout,
                     std::function<void ()> callback);
@@ -85,6 +177,33 @@ namespace linuxpp
         add_timeout(const std::chrono::duration<Rep, Period> delay,
                     std::function<void ()> callback);
 
+        /** Adds a high precision timeout
+         *
+         *  The ioloop wakes up early by a margin calibrated from the
+         *  measured lateness of its timer wakeups, and then spins on
+         *  the clock until the timeout, so the callback is called
+         *  within about a microsecond of the timeout.  The spin keeps
+         *  the ioloop's thread busy for up to the margin, so this
+         *  should only be used for timeouts that need the accuracy,
+         *  e.g. packet pacing.
+         *
+         *  Precise and regular timeouts are called in timeout order.
+         */
+        linuxpp::ioloop::timeout_handle
+        add_timeout(linuxpp::precise_t,
+                    const ioloop::time_type timeout,
+                    std::function<void ()> callback);
+
+        template <class Rep, class Period>
+        linuxpp::ioloop::timeout_handle
+        add_timeout(linuxpp::precise_t,
+                    const std::chrono::duration<Rep, Period> delay,
+                    std::function<void ()> callback);
+
+        /// Returns how early the ioloop currently wakes up for a precise timeout
+        std::chrono::nanoseconds
+        precise_timeout_margin() const noexcept;
+
         template <class Rep, class Period>
         linuxpp::ioloop::periodic_timeout_handle
         add_periodic_timeout(const std::chrono::duration<Rep, Period> delay,
@@ -99,9 +218,97 @@ namespace linuxpp
         void
         add_callback(std::function<void ()> callback);
 
+        /** Adds a signal handler
+         *
+         *  The signal is blocked in the calling thread and accepted
+         *  by the ioloop's signalfd, so the handler is called in the
+         *  ioloop's thread instead of in signal handler context.
+         *  Signal records are read in bulk, so a flood of signals is
+         *  handled in batches.
+         *
+         *  @note The signal must be blocked in every thread of the
+         *        process, so this should be called before other
+         *        threads are created, or those threads must block
+         *        the signal themselves.
+         *
+         *  @param signo The signal to handle
+         *
+         *  @param callback The function to call with each received
+         *                  signal's signalfd_siginfo record
+         *
+         *  @throws ndgpp::error<std::runtime_error> if signo is already handled
+         *  @throws ndgpp::error<std::system_error> if the signal could not be blocked
+         */
+        void
+        add_signal_handler(const int signo,
+                           std::function<void (const signalfd_siginfo &)> callback);
+
+        /** Removes a signal handler
+         *
+         *  The signal remains blocked in the calling thread
+         *
+         *  @param signo The signal who's handler to remove
+         */
+        void
+        remove_signal_handler(const int signo);
+
+        /** Adds a handler that's called once per ioloop iteration
+         *
+         *  Iteration handlers are called after the file descriptor
+         *  handlers, and are meant for polling work queues that are
+         *  filled by other threads without a system call, e.g. a
+         *  linuxpp::spsc_ring.
+         *
+         *  @param callback The function to call once per iteration
+         *
+         *  @param pending Returns true if callback has work to do.
+         *                 It's checked before the ioloop blocks, and
+         *                 the ioloop will not block while it returns
+         *                 true.  It must be safe to call after
+         *                 linuxpp::ioloop::sleeping returns true in
+         *                 another thread.
+         */
+        linuxpp::ioloop::iteration_handle
+        add_iteration_handler(std::function<void ()> callback,
+                              std::function<bool ()> pending);
+
+        void
+        remove_iteration_handler(const linuxpp::ioloop::iteration_handle handle);
+
+        /** Returns true if the ioloop is blocked, or is about to block, waiting for events
+         *
+         *  This function is safe to call from any thread
+         */
+        bool
+        sleeping() const noexcept;
+
+        /** Wakes up the ioloop if it's sleeping
+         *
+         *  This is meant to be called by a thread that made an
+         *  iteration handler's pending function return true.  No
+         *  system call is made unless the ioloop is sleeping.
+         *
+         *  @return true if the ioloop was sleeping and had to be woken up
+         *
+         *  This function is safe to call from any thread
+         */
+        bool
+        wakeup();
+
         void
         start();
 
+        /** Tunes the calling thread and then runs the ioloop
+         *
+         *  @param tuning The settings to apply to the calling thread
+         *
+         *  @param report Called with the outcome of the tuning
+         *                before the ioloop starts processing events
+         */
+        void
+        start(const linuxpp::thread_tuning & tuning,
+              std::function<void (const linuxpp::thread_tuning_result &)> report);
+
         void
         stop();
 
@@ -120,9 +327,40 @@ namespace linuxpp
         void
         process_stop();
 
+        void
+        process_wakeup();
+
+        void
+        process_signals();
+
+        void
+        process_iteration_handlers();
+
+        int
+        prepare_sleep();
+
+        void
+        process_batch_groups();
+
         linuxpp::ioloop::timeout_handle
         insert_timeout(const ioloop::time_type timeout,
-                       std::function<void ()> callback);
+                       std::function<void ()> callback,
+                       const bool precise);
+
+        linuxpp::ioloop::timeout_handle
+        add_timeout(const ioloop::time_type timeout,
+                    std::function<void ()> callback,
+                    const bool precise);
+
+        /// Returns when the timeout timer has to expire for the current timeouts
+        ioloop::time_type
+        timeout_wakeup_time() const;
+
+        void
+        arm_timeout_timer(const ioloop::time_type wakeup_time);
+
+        void
+        update_precise_timeout_margin(const std::chrono::nanoseconds lateness);
 
         template <class Rep, class Period>
         linuxpp::ioloop::periodic_timeout_handle
@@ -150,6 +388,15 @@ namespace linuxpp
         std::vector<linuxpp::ioloop::timeout_callback> pending_timeout_additions_;
         linuxpp::monotonic_timerfd timeout_timerfd_;
 
+        // The time the timeout timer is armed for, time_type::max() when disarmed
+        ioloop::time_type timeout_timer_armed_time_ = ioloop::time_type::max();
+
+        // Smoothed lateness of the timeout timer's wakeups and its
+        // mean deviation, used to compute precise_timeout_margin_
+        std::chrono::nanoseconds timer_lateness_ {50000};
+        std::chrono::nanoseconds timer_lateness_deviation_ {25000};
+        std::chrono::nanoseconds precise_timeout_margin_ {150000};
+
         // Periodic timeout related data members
 
         struct periodic_timeout_callback;
@@ -177,8 +424,32 @@ namespace linuxpp
         std::vector<std::function<void ()>> new_callbacks_;
         linuxpp::eventfd callbacks_eventfd_;
 
+        // Signal handler related members
+
+        using signal_handler_map_type = std::unordered_map<int, std::function<void (const signalfd_siginfo &)>>;
+        signal_handler_map_type signal_handlers_;
+        bool processing_signal_handlers_ = false;
+        std::vector<int> removed_signal_handlers_;
+        sigset_t signal_mask_;
+        linuxpp::signalfd signalfd_;
+        std::vector<signalfd_siginfo> signal_infos_;
+
+        // Iteration handler related members
+
+        struct iteration_callback;
+
+        std::vector<linuxpp::ioloop::iteration_callback> iteration_handlers_;
+        bool processing_iteration_handlers_ = false;
+        std::vector<linuxpp::ioloop::iteration_callback> pending_iteration_handler_additions_;
+
+        // Waited on while the ioloop is blocked, or about to block,
+        // in epoll_wait
+        linuxpp::notifier wakeup_notifier_;
+
         // File descriptor related members
 
+        struct batch_group;
+
         struct handler_callback
         {
             handler_callback(const uint32_t events,
@@ -187,15 +458,58 @@ namespace linuxpp
                 callback(std::move(callback))
             {}
 
+            handler_callback(const uint32_t events,
+                             batch_group * const group,
+                             void * const user_data):
+                events(events),
+                group(group),
+                user_data(user_data)
+            {}
+
+            int fd = -1;
             uint32_t events;
             std::function<void (int, uint32_t)> callback;
+
+            // Set for file descriptors that belong to a batch group
+            batch_group * group = nullptr;
+            void * user_data = nullptr;
+
+            // Set when the handler is removed while handlers are
+            // being processed
+            bool removed = false;
         };
 
-        using handler_map_type = std::unordered_map<int, handler_callback>;
+        // The handlers are allocated separately so that a pruned
+        // handler outlives the iteration, as its callback may be the
+        // one that's running
+        using handler_map_type = std::unordered_map<int, std::unique_ptr<handler_callback>>;
         handler_map_type handlers_;
         bool processing_handlers_ = false;
 
         std::vector<int> removed_handlers_;
+        std::vector<std::unique_ptr<handler_callback>> pruned_handlers_;
+
+        void
+        insert_handler(const int fd,
+                       const uint32_t events,
+                       handler_callback handler);
+
+        /// Removes a handler from epoll, tolerating a file descriptor that was already closed
+        void
+        epoll_del_handler(const int fd);
+
+        /** Finishes the postponed removal of a handler while the handlers are processed
+         *
+         *  Used when the handler's file descriptor is added again,
+         *  e.g. because it was closed and the number was reused.
+         */
+        void
+        prune_handler(handler_map_type::iterator handler);
+
+        // Batch group related members
+
+        std::vector<std::unique_ptr<batch_group>> batch_groups_;
+        std::vector<batch_group *> ready_batch_groups_;
 
         std::vector<epoll_event> epoll_events_;
         linuxpp::epoll epoll_;
@@ -246,15 +560,18 @@ namespace linuxpp
 
         timeout_callback(linuxpp::ioloop::timeout_handle h,
                          const ioloop::time_type to,
-                         std::function<void ()> cb):
+                         std::function<void ()> cb,
+                         const bool p = false):
             handle(h),
             timeout(to),
-            callback(cb)
+            callback(cb),
+            precise(p)
         {}
 
         linuxpp::ioloop::timeout_handle handle;
         ioloop::time_type timeout;
         std::function<void ()> callback;
+        bool precise;
         bool remove = false;
     };
 
@@ -324,6 +641,80 @@ namespace linuxpp
         bool processed = false;
     };
 
+    class ioloop::iteration_handle
+    {
+        public:
+
+        iteration_handle();
+
+        friend
+        bool
+        operator == (const iteration_handle lhs,
+                     const iteration_handle rhs);
+
+        friend
+        bool
+        operator != (const iteration_handle lhs,
+                     const iteration_handle rhs);
+
+        private:
+
+        static unsigned long long next_id_;
+        unsigned long long id_;
+    };
+
+    class ioloop::batch_group_handle
+    {
+        public:
+
+        batch_group_handle();
+
+        friend
+        bool
+        operator == (const batch_group_handle lhs,
+                     const batch_group_handle rhs);
+
+        friend
+        bool
+        operator != (const batch_group_handle lhs,
+                     const batch_group_handle rhs);
+
+        private:
+
+        static unsigned long long next_id_;
+        unsigned long long id_;
+    };
+
+    struct ioloop::batch_group
+    {
+        batch_group(const linuxpp::ioloop::batch_group_handle h,
+                    linuxpp::ioloop::batch_callback cb):
+            handle(h),
+            callback(std::move(cb))
+        {}
+
+        linuxpp::ioloop::batch_group_handle handle;
+        linuxpp::ioloop::batch_callback callback;
+        std::vector<linuxpp::ioloop::batch_event> ready;
+        bool remove = false;
+    };
+
+    struct ioloop::iteration_callback
+    {
+        iteration_callback(const linuxpp::ioloop::iteration_handle h,
+                           std::function<void ()> cb,
+                           std::function<bool ()> p):
+            handle(h),
+            callback(std::move(cb)),
+            pending(std::move(p))
+        {}
+
+        linuxpp::ioloop::iteration_handle handle;
+        std::function<void ()> callback;
+        std::function<bool ()> pending;
+        bool remove = false;
+    };
+
     template <class Rep, class Period>
     inline
     linuxpp::ioloop::timeout_handle
@@ -334,6 +725,18 @@ namespace linuxpp
                                  callback);
     }
 
+    template <class Rep, class Period>
+    inline
+    linuxpp::ioloop::timeout_handle
+    ioloop::add_timeout(linuxpp::precise_t,
+                        const std::chrono::duration<Rep, Period> delay,
+                        std::function<void ()> callback)
+    {
+        return this->add_timeout(linuxpp::precise,
+                                 std::chrono::steady_clock::now() + delay,
+                                 callback);
+    }
+
     template <class Rep, class Period>
     linuxpp::ioloop::periodic_timeout_handle
     ioloop::insert_periodic_timeout(const std::chrono::duration<Rep, Period> period,
@@ -427,6 +830,38 @@ namespace linuxpp
         return !(lhs == rhs);
     }
 
+    inline
+    bool
+    operator == (const linuxpp::ioloop::iteration_handle lhs,
+                 const linuxpp::ioloop::iteration_handle rhs)
+    {
+        return lhs.id_ == rhs.id_;
+    }
+
+    inline
+    bool
+    operator != (const linuxpp::ioloop::iteration_handle lhs,
+                 const linuxpp::ioloop::iteration_handle rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    inline
+    bool
+    operator == (const linuxpp::ioloop::batch_group_handle lhs,
+                 const linuxpp::ioloop::batch_group_handle rhs)
+    {
+        return lhs.id_ == rhs.id_;
+    }
+
+    inline
+    bool
+    operator != (const linuxpp::ioloop::batch_group_handle lhs,
+                 const linuxpp::ioloop::batch_group_handle rhs)
+    {
+        return !(lhs == rhs);
+    }
+
     inline
     bool
     operator < (const linuxpp::ioloop::timeout_callback & lhs,
@@ -0,0 +1,265 @@
+#ifndef LIBLINUXPP_IOLOOP_MESH_HPP
+#define LIBLINUXPP_IOLOOP_MESH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libndgpp/error.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/spsc_ring.hpp>
+
+namespace linuxpp
+{
+    /** A full mesh of single-producer/single-consumer channels between ioloops
+     *
+     *  Each ordered pair of ioloops is connected by its own
+     *  linuxpp::spsc_ring, so sending a message from one ioloop's
+     *  thread to another ioloop never takes a lock.  Every ioloop
+     *  drains its incoming rings once per iteration, and a sender
+     *  only writes to the destination's wakeup eventfd when the
+     *  destination ioloop is sleeping.
+     *
+     *  The mesh must be constructed before, and destroyed after, the
+     *  ioloops are running.
+     *
+     *  @tparam T The type of message passed between the ioloops
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    template <class T>
+    class ioloop_mesh final
+    {
+        public:
+
+        using value_type = T;
+
+        /** The message handler type
+         *
+         *  Called on the destination ioloop's thread with the
+         *  destination index, the source index, and the message.
+         */
+        using handler_type = std::function<void (std::size_t destination,
+                                                 std::size_t source,
+                                                 T & message)>;
+
+        /** Constructs an ioloop_mesh object
+         *
+         *  @param loops The ioloops to connect.  An ioloop's index in
+         *               the mesh is its position in loops.
+         *
+         *  @param capacity The minimum number of messages each
+         *                  channel can hold
+         *
+         *  @param handler The function called for each message
+         *                 received by an ioloop
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if loops is
+         *          empty or contains a null pointer, or capacity is 0
+         */
+        ioloop_mesh(std::vector<linuxpp::ioloop *> loops,
+                    const std::size_t capacity,
+                    handler_type handler);
+
+        ~ioloop_mesh();
+
+        ioloop_mesh(const ioloop_mesh &) = delete;
+        ioloop_mesh & operator= (const ioloop_mesh &) = delete;
+
+        ioloop_mesh(ioloop_mesh &&) = delete;
+        ioloop_mesh & operator= (ioloop_mesh &&) = delete;
+
+        /** Sends a message from one ioloop to another
+         *
+         *  @note Only the source ioloop's thread may send on behalf
+         *        of source
+         *
+         *  @return false if the channel is full.  The message is not
+         *          moved from in that case, and it's up to the
+         *          caller to retry, drop, or shed load.
+         */
+        bool try_send(const std::size_t source,
+                      const std::size_t destination,
+                      T && message);
+
+        /// Copies message from one ioloop to another, returns false if the channel is full
+        bool try_send(const std::size_t source,
+                      const std::size_t destination,
+                      const T & message);
+
+        /// Constructs a message in a channel, returns false if the channel is full
+        template <class ... Args>
+        bool try_emplace(const std::size_t source,
+                         const std::size_t destination,
+                         Args && ... args);
+
+        /// Returns the number of messages waiting in the source to destination channel
+        std::size_t pending(const std::size_t source,
+                            const std::size_t destination) const noexcept;
+
+        /// Returns the number of ioloops in the mesh
+        std::size_t size() const noexcept;
+
+        private:
+
+        linuxpp::spsc_ring<T> & channel(const std::size_t source,
+                                        const std::size_t destination) const noexcept;
+
+        bool has_pending(const std::size_t destination) const noexcept;
+
+        void drain(const std::size_t destination);
+
+        std::vector<linuxpp::ioloop *> loops_;
+        handler_type handler_;
+
+        // channels_[source * loops_.size() + destination]
+        std::vector<std::unique_ptr<linuxpp::spsc_ring<T>>> channels_;
+        std::vector<linuxpp::ioloop::iteration_handle> iteration_handles_;
+    };
+
+    template <class T>
+    ioloop_mesh<T>::ioloop_mesh(std::vector<linuxpp::ioloop *> loops,
+                                const std::size_t capacity,
+                                handler_type handler):
+        loops_(std::move(loops)),
+        handler_(std::move(handler))
+    {
+        if (this->loops_.empty())
+        {
+            throw ndgpp_error(std::invalid_argument, "ioloop_mesh requires at least one ioloop");
+        }
+
+        for (const auto loop : this->loops_)
+        {
+            if (loop == nullptr)
+            {
+                throw ndgpp_error(std::invalid_argument, "ioloop_mesh ioloop cannot be null");
+            }
+        }
+
+        const std::size_t loop_count = this->loops_.size();
+        this->channels_.reserve(loop_count * loop_count);
+        for (std::size_t i = 0; i < loop_count * loop_count; ++i)
+        {
+            this->channels_.emplace_back(new linuxpp::spsc_ring<T> {capacity});
+        }
+
+        this->iteration_handles_.reserve(loop_count);
+        try
+        {
+            for (std::size_t destination = 0; destination < loop_count; ++destination)
+            {
+                this->iteration_handles_.push_back(
+                    this->loops_[destination]->add_iteration_handler(
+                        [this, destination] () { this->drain(destination); },
+                        [this, destination] () { return this->has_pending(destination); }));
+            }
+        }
+        catch (...)
+        {
+            for (std::size_t i = 0; i < this->iteration_handles_.size(); ++i)
+            {
+                this->loops_[i]->remove_iteration_handler(this->iteration_handles_[i]);
+            }
+
+            throw;
+        }
+    }
+
+    template <class T>
+    ioloop_mesh<T>::~ioloop_mesh()
+    {
+        for (std::size_t i = 0; i < this->iteration_handles_.size(); ++i)
+        {
+            this->loops_[i]->remove_iteration_handler(this->iteration_handles_[i]);
+        }
+    }
+
+    template <class T>
+    inline linuxpp::spsc_ring<T> &
+    ioloop_mesh<T>::channel(const std::size_t source,
+                            const std::size_t destination) const noexcept
+    {
+        return *this->channels_[source * this->loops_.size() + destination];
+    }
+
+    template <class T>
+    template <class ... Args>
+    inline bool ioloop_mesh<T>::try_emplace(const std::size_t source,
+                                            const std::size_t destination,
+                                            Args && ... args)
+    {
+        if (!this->channel(source, destination).try_emplace(std::forward<Args>(args)...))
+        {
+            return false;
+        }
+
+        // Only costs a system call if the destination is sleeping
+        this->loops_[destination]->wakeup();
+        return true;
+    }
+
+    template <class T>
+    inline bool ioloop_mesh<T>::try_send(const std::size_t source,
+                                         const std::size_t destination,
+                                         T && message)
+    {
+        return this->try_emplace(source, destination, std::move(message));
+    }
+
+    template <class T>
+    inline bool ioloop_mesh<T>::try_send(const std::size_t source,
+                                         const std::size_t destination,
+                                         const T & message)
+    {
+        return this->try_emplace(source, destination, message);
+    }
+
+    template <class T>
+    inline std::size_t ioloop_mesh<T>::pending(const std::size_t source,
+                                               const std::size_t destination) const noexcept
+    {
+        return this->channel(source, destination).size();
+    }
+
+    template <class T>
+    inline std::size_t ioloop_mesh<T>::size() const noexcept
+    {
+        return this->loops_.size();
+    }
+
+    template <class T>
+    bool ioloop_mesh<T>::has_pending(const std::size_t destination) const noexcept
+    {
+        for (std::size_t source = 0; source < this->loops_.size(); ++source)
+        {
+            if (!this->channel(source, destination).empty())
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <class T>
+    void ioloop_mesh<T>::drain(const std::size_t destination)
+    {
+        for (std::size_t source = 0; source < this->loops_.size(); ++source)
+        {
+            auto & ring = this->channel(source, destination);
+
+            // Bound the work per iteration to one ring's worth of
+            // messages so a busy sender can't starve the ioloop
+            ring.consume([this, destination, source] (T & message) {
+                    this->handler_(destination, source, message);
+                },
+                ring.capacity());
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef LIBLINUXPP_MIRROR_BUFFER_HPP
+#define LIBLINUXPP_MIRROR_BUFFER_HPP
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+
+#include <new>
+
+#include <liblinuxpp/syscall_return.hpp>
+
+namespace linuxpp
+{
+    /** A ring buffer whose readable and writable regions are always contiguous
+     *
+     *  The buffer's memory, a memfd_create region, is mapped twice
+     *  back to back, so bytes past the end of the first mapping are
+     *  the bytes at the start of the buffer.  A message that wraps
+     *  around the end of the ring can be parsed in place, and
+     *  recv and send take the whole region with a single buffer,
+     *  without a copy or a compaction.
+     *
+     *  Data is added by writing to write_data and calling commit,
+     *  and removed by reading from read_data and calling consume.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class mirror_buffer final
+    {
+        public:
+
+        /** Constructs a mirror_buffer object
+         *
+         *  @param capacity The buffer's minimum capacity, which is
+         *                  rounded up to a multiple of the page size
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if capacity is 0
+         *  @throws ndgpp::error<std::system_error> if the memory can't
+         *          be created or mapped
+         */
+        explicit
+        mirror_buffer(const std::size_t capacity);
+
+        ~mirror_buffer();
+
+        mirror_buffer(const mirror_buffer &) = delete;
+        mirror_buffer & operator= (const mirror_buffer &) = delete;
+
+        mirror_buffer(mirror_buffer &&) = delete;
+        mirror_buffer & operator= (mirror_buffer &&) = delete;
+
+        /// Returns the number of bytes the buffer holds when it's full
+        std::size_t capacity() const noexcept;
+
+        /// Returns the number of readable bytes
+        std::size_t size() const noexcept;
+
+        /// Returns the number of writable bytes
+        std::size_t available() const noexcept;
+
+        bool empty() const noexcept;
+
+        bool full() const noexcept;
+
+        /// Returns the readable bytes, size() of them are contiguous
+        char * read_data() noexcept;
+
+        /// Returns the readable bytes, size() of them are contiguous
+        char const * read_data() const noexcept;
+
+        /// Returns where new data is written, available() bytes are contiguous
+        char * write_data() noexcept;
+
+        /// Returns the readable bytes as an iovec
+        struct ::iovec read_iovec() noexcept;
+
+        /// Returns the writable bytes as an iovec
+        struct ::iovec write_iovec() noexcept;
+
+        /** Makes bytes written to write_data readable
+         *
+         *  @param length The number of bytes written, which must not
+         *                exceed available()
+         */
+        void commit(const std::size_t length) noexcept;
+
+        /** Removes bytes from the front of the readable bytes
+         *
+         *  @param length The number of bytes to remove, which must
+         *                not exceed size()
+         */
+        void consume(const std::size_t length) noexcept;
+
+        /// Removes all the readable bytes
+        void clear() noexcept;
+
+        /** Receives into the writable bytes and commits them
+         *
+         *  @param sd The socket to receive from
+         *  @param flags The flags to pass to recv
+         *
+         *  @return The number of bytes received, 0 at the end of
+         *          file, or ENOBUFS when the buffer is full
+         */
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                const int sd,
+                                                const int flags = 0) noexcept;
+
+        /** Sends the readable bytes and consumes the ones sent
+         *
+         *  @param sd The socket to send to
+         *  @param flags The flags to pass to send
+         *
+         *  @return The number of bytes sent
+         */
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                const int sd,
+                                                const int flags = 0) noexcept;
+
+        private:
+
+        char * base_;
+        std::size_t capacity_;
+
+        // The readable bytes start at base_ + read_, read_ is less
+        // than capacity_
+        std::size_t read_ = 0;
+        std::size_t size_ = 0;
+    };
+}
+
+#endif
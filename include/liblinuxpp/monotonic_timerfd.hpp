@@ -6,17 +6,31 @@
 #include <cstdint>
 
 #include <chrono>
+#include <new>
+#include <stdexcept>
 
 #include <libndgpp/error.hpp>
 
+#include <liblinuxpp/syscall_return.hpp>
 #include <liblinuxpp/unique_fd.hpp>
 
 namespace linuxpp
 {
+    /** A resource owning class for a CLOCK_MONOTONIC timerfd
+     *
+     *  std::chrono::steady_clock is CLOCK_MONOTONIC on Linux, so
+     *  steady_clock time points are used as absolute deadlines
+     */
     class monotonic_timerfd
     {
         public:
 
+        /** Constructs a monotonic_timerfd object
+         *
+         *  @param flags Zero or TFD_NONBLOCK, TFD_CLOEXEC is always set
+         *
+         *  @throws ndgpp::error<std::system_error> if timerfd_create fails
+         */
         monotonic_timerfd(const int flags);
 
         monotonic_timerfd();
@@ -27,50 +41,163 @@ namespace linuxpp
         monotonic_timerfd(monotonic_timerfd &&);
         monotonic_timerfd & operator=(monotonic_timerfd &&);
 
+        /** Arms the timer to expire once at an absolute time
+         *
+         *  The timer is armed with TFD_TIMER_ABSTIME, so there's no
+         *  skew from converting the time to a relative delay.  A
+         *  time that has already passed expires right away.
+         *
+         *  @return The previous timer setting
+         *
+         *  @throws ndgpp::error<std::system_error> if timerfd_settime fails
+         */
         struct ::itimerspec
         set_oneshot(const std::chrono::steady_clock::time_point time);
 
+        /// Arms the timer to expire once after a delay
         template <class Rep, class Period>
         struct ::itimerspec
         set_oneshot(const std::chrono::duration<Rep, Period> time);
 
+        /** Arms the timer to expire periodically
+         *
+         *  The kernel re-arms the timer, so a periodic ticker costs
+         *  one read per tick and no re-arm system call
+         *
+         *  @param first The absolute time of the first expiration
+         *  @param period The time between expirations, must be greater than 0
+         *
+         *  @return The previous timer setting
+         *
+         *  @throws ndgpp::error<std::system_error> if timerfd_settime fails
+         */
+        template <class Rep, class Period>
+        struct ::itimerspec
+        set_periodic(const std::chrono::steady_clock::time_point first,
+                     const std::chrono::duration<Rep, Period> period);
+
+        /// Arms the timer to expire every period, starting one period from now
+        template <class Rep, class Period>
+        struct ::itimerspec
+        set_periodic(const std::chrono::duration<Rep, Period> period);
+
+        /** Disarms the timer
+         *
+         *  @return The previous timer setting
+         *
+         *  @throws ndgpp::error<std::system_error> if timerfd_settime fails
+         */
+        struct ::itimerspec
+        disarm();
+
+        /** Returns the timer's current setting
+         *
+         *  it_value is the time until the next expiration, and is
+         *  zero when the timer is disarmed
+         *
+         *  @throws ndgpp::error<std::system_error> if timerfd_gettime fails
+         */
+        struct ::itimerspec
+        gettime() const;
+
+        /** Reads the number of expirations since the last read
+         *
+         *  A value greater than 1 means that expirations were
+         *  overrun.  Blocks until the timer expires unless the timer
+         *  was created with TFD_NONBLOCK.
+         *
+         *  @throws ndgpp::error<std::system_error> if read fails
+         */
         uint64_t
         read();
 
+        /** Reads the number of expirations since the last read
+         *
+         *  @return A linuxpp::syscall_return object whose value is
+         *          the number of expirations.  The errno value is
+         *          EAGAIN if the timer was created with TFD_NONBLOCK
+         *          and has not expired.
+         */
+        linuxpp::syscall_return<uint64_t>
+        read(std::nothrow_t);
+
         int
         fd() const;
 
         private:
 
+        template <class Rep, class Period>
+        static struct ::timespec
+        to_timespec(const std::chrono::duration<Rep, Period> time);
+
+        struct ::itimerspec
+        settime(const int flags,
+                const struct ::itimerspec & new_spec);
+
         linuxpp::unique_fd<> fd_;
     };
 
+    template <class Rep, class Period>
+    inline struct ::timespec
+    monotonic_timerfd::to_timespec(const std::chrono::duration<Rep, Period> time)
+    {
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(time);
+        const auto nanoseconds =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time) -
+            std::chrono::duration_cast<std::chrono::nanoseconds>(seconds);
+
+        struct ::timespec spec = {};
+        spec.tv_sec = seconds.count();
+        spec.tv_nsec = nanoseconds.count();
+        return spec;
+    }
+
     template <class Rep, class Period>
     struct ::itimerspec
     monotonic_timerfd::set_oneshot(const std::chrono::duration<Rep, Period> time)
     {
         struct ::itimerspec new_spec = {};
-        struct ::itimerspec old_spec = {};
+        new_spec.it_value = monotonic_timerfd::to_timespec(time);
 
-        const long nanosecond_offset = time.count() == 0 ? 1 : 0;
+        // A zero it_value disarms the timer, so expire as soon as
+        // possible instead
+        if (new_spec.it_value.tv_sec <= 0 && new_spec.it_value.tv_nsec <= 0)
+        {
+            new_spec.it_value.tv_sec = 0;
+            new_spec.it_value.tv_nsec = 1;
+        }
 
-        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(time);
-        const auto nanoseconds =
-            std::chrono::duration_cast<std::chrono::nanoseconds>(time) -
-            std::chrono::duration_cast<std::chrono::nanoseconds>(seconds);
+        return this->settime(0, new_spec);
+    }
+
+    template <class Rep, class Period>
+    struct ::itimerspec
+    monotonic_timerfd::set_periodic(const std::chrono::steady_clock::time_point first,
+                                    const std::chrono::duration<Rep, Period> period)
+    {
+        struct ::itimerspec new_spec = {};
+        new_spec.it_value = monotonic_timerfd::to_timespec(first.time_since_epoch());
+        new_spec.it_interval = monotonic_timerfd::to_timespec(period);
 
-        new_spec.it_value.tv_sec = seconds.count();
-        new_spec.it_value.tv_nsec = nanosecond_offset + nanoseconds.count();
+        if (new_spec.it_interval.tv_sec <= 0 && new_spec.it_interval.tv_nsec <= 0)
+        {
+            throw ndgpp_error(std::invalid_argument, "timerfd period must be greater than 0");
+        }
 
-        const int ret = ::timerfd_settime(this->fd_.get(), 0, &new_spec, &old_spec);
-        if (ret == -1)
+        if (new_spec.it_value.tv_sec <= 0 && new_spec.it_value.tv_nsec <= 0)
         {
-            throw ndgpp_error(std::system_error,
-                              std::error_code{errno, std::system_category()},
-                              "timerfd_settime system call failed for given duration");
+            new_spec.it_value.tv_sec = 0;
+            new_spec.it_value.tv_nsec = 1;
         }
 
-        return old_spec;
+        return this->settime(TFD_TIMER_ABSTIME, new_spec);
+    }
+
+    template <class Rep, class Period>
+    struct ::itimerspec
+    monotonic_timerfd::set_periodic(const std::chrono::duration<Rep, Period> period)
+    {
+        return this->set_periodic(std::chrono::steady_clock::now() + period, period);
     }
 }
 
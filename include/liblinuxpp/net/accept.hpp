@@ -4,9 +4,13 @@
 #include <netinet/in.h>
 #include <netinet/ip.h>
 
+#include <new>
+
 #include <libndgpp/net/ipv4_address.hpp>
 #include <libndgpp/net/port.hpp>
 
+#include <liblinuxpp/syscall_return.hpp>
+
 namespace linuxpp {
 namespace net {
 
@@ -38,6 +42,30 @@ namespace net {
     int accept(const int sd,
                struct ::sockaddr_in & sockaddr,
                const int flags = 0);
+
+    /** Accepts a connection without throwing
+     *
+     *  EAGAIN is returned when a non-blocking socket has no pending
+     *  connections.
+     *
+     *  @return The connection's socket descriptor or the errno value
+     */
+    linuxpp::syscall_return<int> accept(std::nothrow_t,
+                                        const int sd,
+                                        const int flags = 0) noexcept;
+
+    /// Accepts a connection without throwing
+    linuxpp::syscall_return<int> accept(std::nothrow_t,
+                                        const int sd,
+                                        ndgpp::net::ipv4_address & addr,
+                                        ndgpp::net::port & port,
+                                        const int flags = 0) noexcept;
+
+    /// Accepts a connection without throwing
+    linuxpp::syscall_return<int> accept(std::nothrow_t,
+                                        const int sd,
+                                        struct ::sockaddr_in & sockaddr,
+                                        const int flags = 0) noexcept;
 }}
 
 #endif
@@ -0,0 +1,137 @@
+#ifndef LIBLINUXPP_NET_ACCEPTOR_HPP
+#define LIBLINUXPP_NET_ACCEPTOR_HPP
+
+#include <cstddef>
+
+#include <functional>
+#include <vector>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** Accepts every pending connection of a listening socket per wakeup
+     *
+     *  Each readable event of the listener is drained with
+     *  non-blocking accept4 calls until EAGAIN, and the connections
+     *  are handed to the connection handler in batches.  Accepted
+     *  sockets are non-blocking and close-on-exec, and have the
+     *  acceptor's socket_tuning applied.
+     *
+     *  A listener that hits the process's file descriptor limit keeps
+     *  reporting readable, because the connection stays queued.  The
+     *  acceptor holds a reserve file descriptor, which it closes to
+     *  accept and immediately close such connections, so the peer
+     *  sees the connection refused instead of the ioloop spinning.
+     *
+     *  The listening socket isn't owned and must outlive the
+     *  acceptor.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class acceptor final
+    {
+        public:
+
+        /** Called with a batch of accepted connections
+         *
+         *  The handler takes ownership by moving the sockets out,
+         *  the sockets left behind are closed when it returns.  The
+         *  acceptor must not be destroyed from the handler.
+         *
+         *  @param connections The accepted connections
+         *  @param count The number of connections
+         */
+        using connection_handler = std::function<void (linuxpp::net::tcp_socket * connections,
+                                                       std::size_t count)>;
+
+        /// The default maximum number of connections per batch
+        static constexpr std::size_t default_batch_size = 64;
+
+        /** Constructs an acceptor object and makes the listener non-blocking
+         *
+         *  @param sd A listening TCP socket descriptor
+         *  @param batch_size The maximum number of connections per batch
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if batch_size is 0
+         *  @throws ndgpp::error<std::system_error> if the reserve file
+         *          descriptor can't be opened
+         */
+        explicit
+        acceptor(const int sd,
+                 const std::size_t batch_size = default_batch_size);
+
+        ~acceptor();
+
+        acceptor(const acceptor &) = delete;
+        acceptor & operator= (const acceptor &) = delete;
+
+        acceptor(acceptor &&) = delete;
+        acceptor & operator= (acceptor &&) = delete;
+
+        /// Sets the socket options applied to each accepted connection
+        void set_tuning(const linuxpp::net::socket_tuning & tuning);
+
+        /** Accepts the pending connections and passes them to the handler
+         *
+         *  @param handler Called with each batch
+         *
+         *  @return The number of connections passed to the handler
+         *
+         *  @throws ndgpp::error<std::system_error> if accept fails
+         *          with an error that isn't caused by a connection or
+         *          by a resource shortage
+         */
+        std::size_t accept_pending(const connection_handler & handler);
+
+        /** Registers the listener with an ioloop, which calls accept_pending
+         *
+         *  @param loop The ioloop to accept from
+         *  @param handler Called with each batch
+         *  @param exclusive Registers with EPOLLEXCLUSIVE, so that
+         *                   when several ioloops share the listener
+         *                   only one of them wakes up per connection
+         *
+         *  @throws std::logic_error if the acceptor is already
+         *          attached to an ioloop
+         */
+        void attach(linuxpp::ioloop & loop,
+                    connection_handler handler,
+                    const bool exclusive = false);
+
+        /// Removes the listener from the ioloop it's attached to
+        void detach();
+
+        /// Returns the number of connections closed because of the file descriptor limit
+        std::size_t rejected() const noexcept;
+
+        /// Returns the listening socket descriptor
+        int descriptor() const noexcept;
+
+        private:
+
+        /// Accepts and closes a connection with the reserve descriptor, returns false if there's no reserve
+        bool reject();
+
+        int sd_;
+        std::size_t batch_size_;
+        std::vector<linuxpp::net::tcp_socket> batch_;
+
+        bool tuned_ = false;
+        linuxpp::net::socket_tuning tuning_;
+
+        linuxpp::unique_fd<> reserve_;
+        std::size_t rejected_ = 0;
+
+        linuxpp::ioloop * loop_ = nullptr;
+        connection_handler handler_;
+    };
+}
+}
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef LIBLINUXPP_NET_BPF_HPP
+#define LIBLINUXPP_NET_BPF_HPP
+
+#include <linux/filter.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace linuxpp {
+namespace net {
+namespace bpf {
+
+    /// Returns a classic BPF statement, see the BPF_STMT macro
+    constexpr struct ::sock_filter stmt(const std::uint16_t code,
+                                       const std::uint32_t k) noexcept
+    {
+        return {code, 0, 0, k};
+    }
+
+    /// Returns a classic BPF jump, see the BPF_JUMP macro
+    constexpr struct ::sock_filter jump(const std::uint16_t code,
+                                       const std::uint32_t k,
+                                       const std::uint8_t jt,
+                                       const std::uint8_t jf) noexcept
+    {
+        return {code, jt, jf, k};
+    }
+
+    /** A classic BPF program
+     *
+     *  The program is validated by the kernel when it's attached to
+     *  a socket.
+     */
+    class program final
+    {
+        public:
+
+        program() = default;
+
+        program(std::initializer_list<struct ::sock_filter> instructions):
+            instructions_(instructions)
+        {}
+
+        explicit
+        program(std::vector<struct ::sock_filter> instructions):
+            instructions_(std::move(instructions))
+        {}
+
+        /// Appends an instruction to the program
+        void push_back(const struct ::sock_filter instruction)
+        {
+            this->instructions_.push_back(instruction);
+        }
+
+        /// Returns the number of instructions in the program
+        std::size_t size() const noexcept
+        {
+            return this->instructions_.size();
+        }
+
+        struct ::sock_filter const * data() const noexcept
+        {
+            return this->instructions_.data();
+        }
+
+        const struct ::sock_filter & operator[] (const std::size_t i) const noexcept
+        {
+            return this->instructions_[i];
+        }
+
+        /// Returns the sock_fprog to pass to setsockopt, which refers to this program
+        struct ::sock_fprog fprog() const noexcept
+        {
+            struct ::sock_fprog prog = {};
+            prog.len = static_cast<unsigned short>(this->instructions_.size());
+            prog.filter = const_cast<struct ::sock_filter *>(this->instructions_.data());
+            return prog;
+        }
+
+        private:
+
+        std::vector<struct ::sock_filter> instructions_;
+    };
+
+    /// The offset of a UDP socket filter's first payload byte, the filter sees the UDP header
+    constexpr std::uint32_t udp_payload_offset = 8;
+
+    /** Builds socket filters that accept packets matching every one of a set of conditions
+     *
+     *  Offsets are relative to the start of the data the filter
+     *  sees, which is the UDP header for a UDP socket, the IP header
+     *  for an IPv4 raw socket, and the link layer header for a packet
+     *  socket.  Multi-byte fields are compared in host byte order
+     *  after being loaded from the packet's network byte order.
+     *
+     *  A packet that is too short to contain a field is dropped.
+     *
+     *  @code
+     *  // Accept datagrams whose first payload byte is a message type of 1 or 3
+     *  const auto program = linuxpp::net::bpf::filter {}
+     *      .match_byte(linuxpp::net::bpf::udp_payload_offset, {1, 3})
+     *      .build();
+     *  @endcode
+     */
+    class filter final
+    {
+        public:
+
+        /** Requires the byte at offset, masked by mask, to equal value
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if value has
+         *          bits outside of mask
+         */
+        filter & match_byte(const std::uint32_t offset,
+                            const std::uint8_t value,
+                            const std::uint8_t mask = 0xff);
+
+        /// Requires the byte at offset to equal one of values
+        filter & match_byte(const std::uint32_t offset,
+                            std::initializer_list<std::uint8_t> values);
+
+        /// Requires the 16 bit field at offset to equal value
+        filter & match_u16(const std::uint32_t offset,
+                           const std::uint16_t value);
+
+        /// Requires the 32 bit field at offset to equal value
+        filter & match_u32(const std::uint32_t offset,
+                           const std::uint32_t value);
+
+        /** Returns the filter's program
+         *
+         *  A filter without conditions accepts every packet.
+         *
+         *  @throws ndgpp::error<std::length_error> if a condition has
+         *          too many values for a classic BPF jump
+         */
+        linuxpp::net::bpf::program build() const;
+
+        private:
+
+        struct condition
+        {
+            std::uint16_t size;
+            std::uint32_t offset;
+            std::uint32_t mask;
+            std::vector<std::uint32_t> values;
+        };
+
+        filter & add(const std::uint16_t size,
+                     const std::uint32_t offset,
+                     const std::uint32_t mask,
+                     std::vector<std::uint32_t> values);
+
+        std::vector<condition> conditions_;
+    };
+
+    /** Attaches a filter program to a socket (SO_ATTACH_FILTER)
+     *
+     *  The program replaces the socket's current filter.
+     *
+     *  @throws ndgpp::error<std::system_error> if the program is
+     *          rejected, or the socket's filter is locked
+     */
+    void attach_filter(const int sd, const linuxpp::net::bpf::program & program);
+
+    /// Removes a socket's filter (SO_DETACH_FILTER)
+    void detach_filter(const int sd);
+
+    /** Prevents a socket's filter from being replaced or detached (SO_LOCK_FILTER)
+     *
+     *  Useful before handing a socket to less privileged code.
+     */
+    void lock_filter(const int sd);
+}}}
+
+#endif
@@ -0,0 +1,523 @@
+#ifndef LIBLINUXPP_NET_CMSG_HPP
+#define LIBLINUXPP_NET_CMSG_HPP
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <time.h>
+
+// Needs struct timespec from time.h
+#include <linux/errqueue.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <iterator>
+#include <stdexcept>
+
+#include <libndgpp/error.hpp>
+
+namespace linuxpp {
+namespace net {
+namespace cmsg {
+
+    /** Base template class for control message traits
+     *
+     *  A valid specialization of this class provides the following members
+     *
+     *  - level: A static function that returns the control message's
+     *    level as an int i.e. SOL_SOCKET
+     *
+     *  - type: A static constexpr int member variable that represents
+     *    the control message's type i.e. SCM_RIGHTS
+     *
+     *  - value_type: A type alias to the control message's data type
+     *
+     *  @tparam T The control message type
+     */
+    template <class T>
+    struct traits;
+
+    template <int Level, int Type, class T>
+    struct cmsg_trait
+    {
+        static constexpr int level() noexcept { return Level; };
+        static constexpr int type = Type;
+        using value_type = T;
+    };
+
+    /// The data of an SCM_TIMESTAMPING control message
+    struct scm_timestamping
+    {
+        struct ::timespec software;
+
+        /// Deprecated, always zero
+        struct ::timespec legacy;
+
+        struct ::timespec hardware;
+    };
+
+    /// SCM_RIGHTS control message, one value per file descriptor
+    struct rights {};
+    template <>
+    struct traits<rights> : public cmsg_trait<SOL_SOCKET, SCM_RIGHTS, int> {};
+
+    /// SCM_TIMESTAMPNS control message
+    struct timestamp_ns {};
+    template <>
+    struct traits<timestamp_ns> : public cmsg_trait<SOL_SOCKET, SCM_TIMESTAMPNS, struct ::timespec> {};
+
+    /// SCM_TIMESTAMPING control message
+    struct timestamping {};
+    template <>
+    struct traits<timestamping> : public cmsg_trait<SOL_SOCKET, SCM_TIMESTAMPING, scm_timestamping> {};
+
+    /// SO_RXQ_OVFL control message, the socket's cumulative drop count
+    struct rxq_ovfl {};
+    template <>
+    struct traits<rxq_ovfl> : public cmsg_trait<SOL_SOCKET, SO_RXQ_OVFL, std::uint32_t> {};
+
+    /// IP_PKTINFO control message
+    struct pktinfo {};
+    template <>
+    struct traits<pktinfo> : public cmsg_trait<IPPROTO_IP, IP_PKTINFO, struct ::in_pktinfo> {};
+
+    /** IP_RECVERR control message, read from the error queue
+     *
+     *  Only the sock_extended_err is read, not the offender's
+     *  address that follows it
+     */
+    struct ip_recverr {};
+    template <>
+    struct traits<ip_recverr> : public cmsg_trait<SOL_IP, IP_RECVERR, struct ::sock_extended_err> {};
+
+    /// IPV6_RECVERR control message, read from the error queue
+    struct ipv6_recverr {};
+    template <>
+    struct traits<ipv6_recverr> : public cmsg_trait<SOL_IPV6, IPV6_RECVERR, struct ::sock_extended_err> {};
+
+    /// UDP_SEGMENT control message, the GSO segment size of a send
+    struct udp_segment {};
+    template <>
+    struct traits<udp_segment> : public cmsg_trait<SOL_UDP, UDP_SEGMENT, std::uint16_t> {};
+
+    /// UDP_GRO control message, the segment size of a coalesced receive
+    struct udp_gro {};
+    template <>
+    struct traits<udp_gro> : public cmsg_trait<SOL_UDP, UDP_GRO, int> {};
+
+    /** The control buffer space needed for one of each control message type
+     *
+     *  @tparam Ts The control message types
+     */
+    template <class ... Ts>
+    struct space
+    {
+        static constexpr std::size_t value = 0;
+    };
+
+    template <class T, class ... Ts>
+    struct space<T, Ts...>
+    {
+        static constexpr std::size_t value =
+            CMSG_SPACE(sizeof(typename traits<T>::value_type)) + space<Ts...>::value;
+    };
+
+    template <class ... Ts>
+    constexpr std::size_t space<Ts...>::value;
+
+    template <class T, class ... Ts>
+    constexpr std::size_t space<T, Ts...>::value;
+
+    /** Suitably aligned storage for control messages
+     *
+     *  @tparam Size The size of the buffer in bytes
+     */
+    template <std::size_t Size>
+    class control_buffer final
+    {
+        static_assert(Size > 0, "control_buffer size must be greater than 0");
+
+        public:
+
+        void * data() noexcept
+        {
+            return this->buffer_;
+        }
+
+        static constexpr std::size_t size() noexcept
+        {
+            return Size;
+        }
+
+        private:
+
+        alignas(struct ::cmsghdr) char buffer_[Size];
+    };
+
+    /// A control_buffer with room for one of each of the control message types
+    template <class ... Ts>
+    using buffer_for = control_buffer<space<Ts...>::value>;
+
+    /** Builds control messages into a caller provided buffer for sendmsg
+     *
+     *  @code
+     *  linuxpp::net::cmsg::buffer_for<linuxpp::net::cmsg::udp_segment> buffer;
+     *  linuxpp::net::cmsg::builder control {buffer};
+     *  control.add<linuxpp::net::cmsg::udp_segment>(1400);
+     *  linuxpp::net::send(sd, buf, len, sockaddr, control);
+     *  @endcode
+     */
+    class builder final
+    {
+        public:
+
+        /** Constructs a builder object
+         *
+         *  @param buffer The buffer to build control messages into,
+         *                which must be aligned for struct cmsghdr
+         *  @param size The size of buffer
+         */
+        builder(void * const buffer, const std::size_t size) noexcept:
+            buffer_(static_cast<unsigned char *>(buffer)),
+            size_(size)
+        {}
+
+        template <std::size_t Size>
+        explicit
+        builder(control_buffer<Size> & buffer) noexcept:
+            builder(buffer.data(), buffer.size())
+        {}
+
+        /** Appends a control message
+         *
+         *  @tparam T The control message type
+         *
+         *  @throws ndgpp::error<std::length_error> if the buffer does
+         *          not have enough room for the message
+         */
+        template <class T>
+        builder & add(const typename traits<T>::value_type & value);
+
+        /// Returns the control messages
+        void * data() const noexcept
+        {
+            return this->buffer_;
+        }
+
+        /// Returns the number of bytes of control messages built
+        std::size_t length() const noexcept
+        {
+            return this->length_;
+        }
+
+        /// Sets the msghdr's control fields to the built control messages
+        void apply(struct ::msghdr & msg) const noexcept
+        {
+            msg.msg_control = this->length_ == 0 ? nullptr : this->buffer_;
+            msg.msg_controllen = this->length_;
+        }
+
+        private:
+
+        unsigned char * buffer_;
+        std::size_t size_;
+        std::size_t length_ = 0;
+    };
+
+    template <class T>
+    builder & builder::add(const typename traits<T>::value_type & value)
+    {
+        using value_type = typename traits<T>::value_type;
+        constexpr std::size_t message_space = CMSG_SPACE(sizeof(value_type));
+        if (this->size_ - this->length_ < message_space)
+        {
+            throw ndgpp_error(std::length_error, "control message buffer is full");
+        }
+
+        // Zero the padding so the kernel doesn't see garbage
+        unsigned char * const position = this->buffer_ + this->length_;
+        std::memset(position, 0, message_space);
+
+        struct ::cmsghdr header = {};
+        header.cmsg_len = CMSG_LEN(sizeof(value_type));
+        header.cmsg_level = traits<T>::level();
+        header.cmsg_type = traits<T>::type;
+        std::memcpy(position, &header, sizeof(header));
+        std::memcpy(CMSG_DATA(reinterpret_cast<struct ::cmsghdr *>(position)), &value, sizeof(value));
+
+        this->length_ += message_space;
+        return *this;
+    }
+
+    /// A received control message
+    class message final
+    {
+        public:
+
+        explicit
+        message(struct ::cmsghdr const * const header) noexcept:
+            header_(header)
+        {}
+
+        int level() const noexcept
+        {
+            return this->header_->cmsg_level;
+        }
+
+        int type() const noexcept
+        {
+            return this->header_->cmsg_type;
+        }
+
+        /// Returns the control message's data
+        void const * data() const noexcept
+        {
+            return CMSG_DATA(const_cast<struct ::cmsghdr *>(this->header_));
+        }
+
+        /// Returns the number of bytes of data in the control message
+        std::size_t data_length() const noexcept
+        {
+            return this->header_->cmsg_len - CMSG_LEN(0);
+        }
+
+        /// Returns true if the control message is of type T
+        template <class T>
+        bool is() const noexcept
+        {
+            return this->level() == traits<T>::level() && this->type() == traits<T>::type;
+        }
+
+        /// Returns the number of T values in the control message, e.g. file descriptors
+        template <class T>
+        std::size_t count() const noexcept
+        {
+            return this->is<T>() ? this->data_length() / sizeof(typename traits<T>::value_type) : 0;
+        }
+
+        /** Returns a value of the control message's data
+         *
+         *  @pre is<T>() is true and index is less than count<T>()
+         */
+        template <class T>
+        typename traits<T>::value_type value(const std::size_t index = 0) const noexcept
+        {
+            typename traits<T>::value_type value;
+            std::memcpy(&value,
+                        static_cast<unsigned char const *>(this->data()) + index * sizeof(value),
+                        sizeof(value));
+            return value;
+        }
+
+        private:
+
+        struct ::cmsghdr const * header_;
+    };
+
+    /** Iterates the control messages received by recvmsg
+     *
+     *  @code
+     *  linuxpp::net::cmsg::buffer_for<linuxpp::net::cmsg::timestamp_ns> buffer;
+     *  linuxpp::net::cmsg::parser control {buffer};
+     *  linuxpp::net::recv(sd, buf, len, control);
+     *
+     *  struct ::timespec timestamp;
+     *  if (control.get<linuxpp::net::cmsg::timestamp_ns>(timestamp))
+     *  {
+     *      ...
+     *  }
+     *  @endcode
+     */
+    class parser final
+    {
+        public:
+
+        class const_iterator
+        {
+            public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = linuxpp::net::cmsg::message;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type const *;
+            using reference = value_type;
+
+            const_iterator() = default;
+
+            value_type operator* () const noexcept
+            {
+                return value_type {reinterpret_cast<struct ::cmsghdr const *>(this->position_)};
+            }
+
+            const_iterator & operator++ () noexcept
+            {
+                // The last message may not be padded to CMSG_SPACE, e.g.
+                // in a truncated buffer, so don't step past the end
+                auto const header = reinterpret_cast<struct ::cmsghdr const *>(this->position_);
+                const std::size_t remaining = static_cast<std::size_t>(this->end_ - this->position_);
+                const std::size_t length = CMSG_ALIGN(header->cmsg_len);
+                if (length >= remaining)
+                {
+                    this->position_ = this->end_;
+                    return *this;
+                }
+
+                this->position_ += length;
+                this->validate();
+                return *this;
+            }
+
+            const_iterator operator++ (int) noexcept
+            {
+                const_iterator ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            bool operator== (const const_iterator & rhs) const noexcept
+            {
+                return this->position_ == rhs.position_;
+            }
+
+            bool operator!= (const const_iterator & rhs) const noexcept
+            {
+                return !(*this == rhs);
+            }
+
+            private:
+
+            friend class parser;
+
+            const_iterator(unsigned char const * const position,
+                           unsigned char const * const end) noexcept:
+                position_(position),
+                end_(end)
+            {
+                this->validate();
+            }
+
+            /// Moves to the end if the current header doesn't fit in the buffer
+            void validate() noexcept
+            {
+                if (this->position_ == this->end_)
+                {
+                    return;
+                }
+
+                auto const header = reinterpret_cast<struct ::cmsghdr const *>(this->position_);
+                const std::size_t remaining = static_cast<std::size_t>(this->end_ - this->position_);
+                if (remaining < sizeof(struct ::cmsghdr) ||
+                    header->cmsg_len < sizeof(struct ::cmsghdr) ||
+                    header->cmsg_len > remaining)
+                {
+                    this->position_ = this->end_;
+                }
+            }
+
+            unsigned char const * position_ = nullptr;
+            unsigned char const * end_ = nullptr;
+        };
+
+        /** Constructs a parser object to receive into buffer
+         *
+         *  @param buffer The buffer to receive control messages into,
+         *                which must be aligned for struct cmsghdr
+         *  @param size The size of buffer
+         */
+        parser(void * const buffer, const std::size_t size) noexcept:
+            buffer_(static_cast<unsigned char *>(buffer)),
+            size_(size)
+        {}
+
+        template <std::size_t Size>
+        explicit
+        parser(control_buffer<Size> & buffer) noexcept:
+            parser(buffer.data(), buffer.size())
+        {}
+
+        /// Constructs a parser object for the control messages of a received msghdr
+        explicit
+        parser(const struct ::msghdr & msg) noexcept:
+            buffer_(static_cast<unsigned char *>(msg.msg_control)),
+            size_(msg.msg_control == nullptr ? 0 : msg.msg_controllen),
+            length_(this->size_),
+            truncated_((msg.msg_flags & MSG_CTRUNC) != 0)
+        {}
+
+        /// Sets the msghdr's control fields to receive into the parser's buffer
+        void prepare(struct ::msghdr & msg) const noexcept
+        {
+            msg.msg_control = this->size_ == 0 ? nullptr : this->buffer_;
+            msg.msg_controllen = this->size_;
+        }
+
+        /// Records the control messages that recvmsg stored in the parser's buffer
+        void received(const struct ::msghdr & msg) noexcept
+        {
+            this->length_ = msg.msg_controllen < this->size_ ? msg.msg_controllen : this->size_;
+            this->truncated_ = (msg.msg_flags & MSG_CTRUNC) != 0;
+        }
+
+        /// Returns true if some control messages didn't fit in the buffer
+        bool truncated() const noexcept
+        {
+            return this->truncated_;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator {this->buffer_, this->buffer_ + this->length_};
+        }
+
+        const_iterator end() const noexcept
+        {
+            const auto end = this->buffer_ + this->length_;
+            return const_iterator {end, end};
+        }
+
+        /** Retrieves the first control message of type T
+         *
+         *  @return true if a control message of type T was received
+         */
+        template <class T>
+        bool get(typename traits<T>::value_type & value) const noexcept
+        {
+            for (const auto msg : *this)
+            {
+                if (msg.is<T>() && msg.data_length() >= sizeof(value))
+                {
+                    value = msg.value<T>();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Returns true if a control message of type T was received
+        template <class T>
+        bool contains() const noexcept
+        {
+            for (const auto msg : *this)
+            {
+                if (msg.is<T>())
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        private:
+
+        unsigned char * buffer_;
+        std::size_t size_;
+        std::size_t length_ = 0;
+        bool truncated_ = false;
+    };
+}}}
+
+#endif
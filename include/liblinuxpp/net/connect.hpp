@@ -4,9 +4,13 @@
 #include <netinet/in.h>
 #include <netinet/ip.h>
 
+#include <new>
+
 #include <libndgpp/net/ipv4_address.hpp>
 #include <libndgpp/net/port.hpp>
 
+#include <liblinuxpp/syscall_return.hpp>
+
 namespace linuxpp {
 namespace net {
 
@@ -30,6 +34,21 @@ namespace net {
 
     /// Connects a socket to the provided sockaddr_in struct
     void connect(const int sd, const struct ::sockaddr_in sockaddr);
+
+    /** Connects a socket without throwing
+     *
+     *  EINPROGRESS is returned when a non-blocking socket's
+     *  connection can't be completed immediately.
+     */
+    linuxpp::syscall_return<int> connect(std::nothrow_t,
+                                         const int sd,
+                                         const ndgpp::net::ipv4_address addr,
+                                         const ndgpp::net::port port) noexcept;
+
+    /// Connects a socket without throwing
+    linuxpp::syscall_return<int> connect(std::nothrow_t,
+                                         const int sd,
+                                         const struct ::sockaddr_in sockaddr) noexcept;
 }}
 
 #endif
@@ -0,0 +1,123 @@
+#ifndef LIBLINUXPP_NET_CONNECTION_POOL_HPP
+#define LIBLINUXPP_NET_CONNECTION_POOL_HPP
+
+#include <cstddef>
+
+#include <chrono>
+#include <vector>
+
+#include <libndgpp/net/ipv4_address.hpp>
+#include <libndgpp/net/port.hpp>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/connector.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** Keeps a number of idle connections to an upstream open ahead of time
+     *
+     *  Taking a connection from the pool is a pop from a stack, so
+     *  a request never waits for a TCP handshake while the pool has
+     *  an idle connection.  The pool opens a replacement for every
+     *  connection taken, retries failed connects after a delay, and
+     *  watches its idle connections so that one closed by the
+     *  upstream is replaced instead of handed out.  Each upstream
+     *  has its own pool.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class connection_pool final
+    {
+        public:
+
+        /** Constructs a connection_pool object and starts filling it
+         *
+         *  @param loop The ioloop that drives the pool, which must
+         *              outlive it
+         *  @param address The upstream's address
+         *  @param port The upstream's port
+         *  @param size The number of idle connections to keep
+         *  @param tuning The socket options applied to each connection
+         *  @param connect_timeout How long a connect may take
+         *  @param retry_delay How long to wait after a failed connect
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if size is 0
+         */
+        connection_pool(linuxpp::ioloop & loop,
+                        const ndgpp::net::ipv4_address address,
+                        const ndgpp::net::port port,
+                        const std::size_t size,
+                        const linuxpp::net::socket_tuning & tuning = linuxpp::net::socket_tuning {},
+                        const std::chrono::milliseconds connect_timeout = std::chrono::seconds {5},
+                        const std::chrono::milliseconds retry_delay = std::chrono::seconds {1});
+
+        /// Closes the idle connections and abandons the connects in progress
+        ~connection_pool();
+
+        connection_pool(const connection_pool &) = delete;
+        connection_pool & operator= (const connection_pool &) = delete;
+
+        connection_pool(connection_pool &&) = delete;
+        connection_pool & operator= (connection_pool &&) = delete;
+
+        /** Takes an idle connection out of the pool
+         *
+         *  @return A connected non-blocking socket, or an empty
+         *          socket if the pool has no idle connection
+         */
+        linuxpp::net::tcp_socket acquire();
+
+        /** Returns a connection to the pool
+         *
+         *  The connection must have no unread data or outstanding
+         *  request.  It's closed if the pool is full.
+         */
+        void release(linuxpp::net::tcp_socket && socket);
+
+        /// Returns the number of idle connections
+        std::size_t idle() const noexcept;
+
+        /// Returns the number of connects in progress
+        std::size_t connecting() const noexcept;
+
+        /// Returns the number of connects that failed
+        std::size_t failures() const noexcept;
+
+        private:
+
+        /// Starts connects until idle and connecting connections reach the pool size
+        void fill();
+
+        /// Calls fill after the retry delay
+        void schedule_retry();
+
+        void connected(const int errno_value, linuxpp::net::tcp_socket socket);
+
+        /// Adds a connection to the idle stack and watches it for a close by the upstream
+        void add_idle(linuxpp::net::tcp_socket && socket);
+
+        /// Drops an idle connection that became readable, which is the upstream closing it
+        void drop_idle(const int sd);
+
+        linuxpp::ioloop & loop_;
+        linuxpp::net::connector connector_;
+        ndgpp::net::ipv4_address address_;
+        ndgpp::net::port port_;
+        std::size_t size_;
+        std::chrono::milliseconds connect_timeout_;
+        std::chrono::milliseconds retry_delay_;
+
+        std::vector<linuxpp::net::tcp_socket> idle_;
+        std::size_t connecting_ = 0;
+        bool retry_pending_ = false;
+        linuxpp::ioloop::timeout_handle retry_;
+        std::size_t failures_ = 0;
+    };
+}
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef LIBLINUXPP_NET_CONNECTOR_HPP
+#define LIBLINUXPP_NET_CONNECTOR_HPP
+
+#include <cstddef>
+
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+
+#include <libndgpp/net/ipv4_address.hpp>
+#include <libndgpp/net/port.hpp>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** Establishes TCP connections from an ioloop without blocking it
+     *
+     *  Each attempt creates a non-blocking socket, starts the
+     *  connect, which reports EINPROGRESS, and waits for the socket
+     *  to become writable, at which point SO_ERROR holds the outcome
+     *  of the handshake.  An attempt that doesn't finish before its
+     *  deadline fails with ETIMEDOUT.  Any number of attempts can be
+     *  in progress at once.
+     *
+     *  The connected sockets are left non-blocking.  A
+     *  linuxpp::net::tcp_datagram_socket can be constructed from one.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class connector final
+    {
+        public:
+
+        /** Called once with the outcome of a connection attempt
+         *
+         *  @param errno_value 0 if the socket is connected, otherwise
+         *                     the reason the attempt failed
+         *  @param socket The connected socket, or an empty socket
+         *                when the attempt failed
+         */
+        using connect_handler = std::function<void (int errno_value, linuxpp::net::tcp_socket socket)>;
+
+        /** Constructs a connector object
+         *
+         *  @param loop The ioloop that drives the attempts, which
+         *              must outlive the connector
+         */
+        explicit
+        connector(linuxpp::ioloop & loop);
+
+        /// Abandons the attempts in progress without calling their handlers
+        ~connector();
+
+        connector(const connector &) = delete;
+        connector & operator= (const connector &) = delete;
+
+        connector(connector &&) = delete;
+        connector & operator= (connector &&) = delete;
+
+        /// Sets the socket options applied to each socket before it connects
+        void set_tuning(const linuxpp::net::socket_tuning & tuning);
+
+        /** Starts a connection attempt
+         *
+         *  The handler is always called from the ioloop, never from
+         *  connect itself, and may start new attempts.
+         *
+         *  @param address The address to connect to
+         *  @param port The port to connect to
+         *  @param timeout How long the attempt may take
+         *  @param handler Called with the outcome
+         *
+         *  @throws ndgpp::error<std::system_error> if the socket can't
+         *          be created or connect fails immediately, e.g. with
+         *          EADDRNOTAVAIL when the local ports are exhausted
+         */
+        void connect(const ndgpp::net::ipv4_address address,
+                     const ndgpp::net::port port,
+                     const std::chrono::milliseconds timeout,
+                     connect_handler handler);
+
+        /// Returns the number of attempts in progress
+        std::size_t pending() const noexcept;
+
+        private:
+
+        struct attempt
+        {
+            linuxpp::net::tcp_socket socket;
+            linuxpp::ioloop::timeout_handle timeout;
+            connect_handler handler;
+        };
+
+        /// Ends the attempt of a socket descriptor and calls its handler
+        void finish(const int sd, const int errno_value);
+
+        linuxpp::ioloop & loop_;
+
+        bool tuned_ = false;
+        linuxpp::net::socket_tuning tuning_;
+
+        // The attempts in progress keyed by socket descriptor
+        std::unordered_map<int, attempt> attempts_;
+    };
+}
+}
+
+#endif
@@ -27,6 +27,81 @@ namespace so {
     struct add_membership {};
     template <>
     struct traits<add_membership> : public add_membership_t {};
+
+    template <int Name>
+    struct ip_int_trait: public ip_trait<Name>
+    {
+        using value_type = int;
+    };
+
+    /** IP_MULTICAST_ALL socket option
+     *
+     *  When set, the default, a socket bound to INADDR_ANY receives
+     *  the datagrams of every group joined on the host, not just the
+     *  groups the socket joined
+     */
+    struct multicast_all {};
+    template <>
+    struct traits<multicast_all> : public ip_int_trait<IP_MULTICAST_ALL> {};
+
+    /// IP_MULTICAST_LOOP socket option
+    struct multicast_loop {};
+    template <>
+    struct traits<multicast_loop> : public ip_int_trait<IP_MULTICAST_LOOP> {};
+
+    /** IP_TOS socket option
+     *
+     *  The kernel keeps the ECN bits of a TCP socket's TOS byte for
+     *  itself
+     */
+    struct tos {};
+    template <>
+    struct traits<tos> : public ip_int_trait<IP_TOS> {};
+
+    /// IP_PKTINFO socket option
+    struct pktinfo {};
+    template <>
+    struct traits<pktinfo> : public ip_int_trait<IP_PKTINFO> {};
+
+    /// MCAST_JOIN_GROUP socket option
+    struct mcast_join_group_t: public ip_trait<MCAST_JOIN_GROUP>
+    {
+        using value_type = struct group_req;
+    };
+
+    struct mcast_join_group {};
+    template <>
+    struct traits<mcast_join_group> : public mcast_join_group_t {};
+
+    /// MCAST_LEAVE_GROUP socket option
+    struct mcast_leave_group_t: public ip_trait<MCAST_LEAVE_GROUP>
+    {
+        using value_type = struct group_req;
+    };
+
+    struct mcast_leave_group {};
+    template <>
+    struct traits<mcast_leave_group> : public mcast_leave_group_t {};
+
+    /// MCAST_JOIN_SOURCE_GROUP socket option
+    struct mcast_join_source_group_t: public ip_trait<MCAST_JOIN_SOURCE_GROUP>
+    {
+        using value_type = struct group_source_req;
+    };
+
+    struct mcast_join_source_group {};
+    template <>
+    struct traits<mcast_join_source_group> : public mcast_join_source_group_t {};
+
+    /// MCAST_LEAVE_SOURCE_GROUP socket option
+    struct mcast_leave_source_group_t: public ip_trait<MCAST_LEAVE_SOURCE_GROUP>
+    {
+        using value_type = struct group_source_req;
+    };
+
+    struct mcast_leave_source_group {};
+    template <>
+    struct traits<mcast_leave_source_group> : public mcast_leave_source_group_t {};
 }}}
 
 #endif
@@ -1,5 +1,5 @@
-#ifndef LIBLINUXPP_NET_BIND_HPP
-#define LIBLINUXPP_NET_BIND_HPP
+#ifndef LIBLINUXPP_NET_IPV4_ADDRESS_HPP
+#define LIBLINUXPP_NET_IPV4_ADDRESS_HPP
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
@@ -0,0 +1,214 @@
+#ifndef LIBLINUXPP_NET_MESSAGE_BATCH_HPP
+#define LIBLINUXPP_NET_MESSAGE_BATCH_HPP
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#include <cstddef>
+
+#include <tuple>
+#include <vector>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** A set of datagram buffers for recvmmsg and sendmmsg
+     *
+     *  Owns one fixed size buffer, one source or destination
+     *  address, and optionally one control buffer per message, and
+     *  the mmsghdr array that refers to them.  The buffers are
+     *  allocated contiguously so a batch can be reused for every
+     *  receive without allocating.
+     *
+     *  @par Copy Semantics Move only
+     */
+    class message_batch final
+    {
+        public:
+
+        /** Constructs a message_batch object
+         *
+         *  @param size The number of messages in the batch
+         *  @param buffer_size The size of each message's buffer
+         *  @param control_size The size of each message's control
+         *                      (ancillary data) buffer, which is
+         *                      rounded up with CMSG_ALIGN
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if size or
+         *          buffer_size is 0
+         */
+        message_batch(const std::size_t size,
+                      const std::size_t buffer_size,
+                      const std::size_t control_size = 0);
+
+        message_batch(const message_batch &) = delete;
+        message_batch & operator= (const message_batch &) = delete;
+
+        message_batch(message_batch &&) = default;
+        message_batch & operator= (message_batch &&) = default;
+
+        /// Returns the mmsghdr array to pass to recvmmsg or sendmmsg
+        struct ::mmsghdr * data() noexcept;
+
+        /// Returns the number of messages in the batch
+        std::size_t size() const noexcept;
+
+        /// Returns the size of each message's buffer
+        std::size_t buffer_size() const noexcept;
+
+        /// Returns the size of each message's control buffer
+        std::size_t control_size() const noexcept;
+
+        /// Returns message i's buffer
+        void * buffer(const std::size_t i) noexcept;
+
+        /// @copydoc buffer
+        void const * buffer(const std::size_t i) const noexcept;
+
+        /** Returns the number of bytes received or sent for message i
+         *
+         *  @note Only valid for the messages the last recvmmsg or
+         *        sendmmsg reported as transferred
+         */
+        std::size_t length(const std::size_t i) const noexcept;
+
+        /** Sets the number of bytes of message i's buffer to send
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if length is
+         *          greater than buffer_size
+         */
+        void set_length(const std::size_t i, const std::size_t length);
+
+        /// Returns message i's source address after a receive
+        const struct ::sockaddr_in & address(const std::size_t i) const noexcept;
+
+        /// Sets message i's destination address
+        void set_address(const std::size_t i, const struct ::sockaddr_in & address) noexcept;
+
+        /// Sends message i to the socket's connected peer
+        void clear_address(const std::size_t i) noexcept;
+
+        /// Returns the msg_flags recvmmsg reported for message i e.g. MSG_TRUNC
+        int flags(const std::size_t i) const noexcept;
+
+        /// Returns message i's control buffer, or nullptr if control_size is 0
+        void * control(const std::size_t i) noexcept;
+
+        /// Returns the number of bytes of control data stored in message i
+        std::size_t control_length(const std::size_t i) const noexcept;
+
+        /** Returns message i's kernel receive timestamp
+         *
+         *  Requires SO_TIMESTAMPNS or SO_TIMESTAMPING to be enabled
+         *  on the socket and a control_size of at least
+         *  linuxpp::net::timestamp_control_size.
+         *
+         *  @note Only valid for the messages the last recvmmsg
+         *        reported as received
+         *
+         *  @return The receive time, or a zero timespec if message i
+         *          has no timestamp
+         */
+        struct ::timespec timestamp(const std::size_t i) const noexcept;
+
+        /** Sets the number of bytes of message i's control data to send
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if length is
+         *          greater than control_size
+         */
+        void set_control_length(const std::size_t i, const std::size_t length);
+
+        /** Resets every message so the batch can be received into
+         *
+         *  Restores each message's buffer, address, and control
+         *  lengths to their full sizes and clears its flags.
+         *  linuxpp::net::udp_socket::recv calls this before each
+         *  receive.
+         */
+        void prepare_recv() noexcept;
+
+        private:
+
+        enum members
+        {
+            buffer_size_member,
+            control_size_member,
+            buffers,
+            controls,
+            iovecs,
+            addresses,
+            headers,
+        };
+
+        using tuple_type = std::tuple<std::size_t,
+                                      std::size_t,
+                                      std::vector<char>,
+                                      std::vector<struct ::cmsghdr>,
+                                      std::vector<struct ::iovec>,
+                                      std::vector<struct ::sockaddr_in>,
+                                      std::vector<struct ::mmsghdr>>;
+
+        tuple_type members_;
+    };
+
+    inline struct ::mmsghdr * message_batch::data() noexcept
+    {
+        return std::get<headers>(this->members_).data();
+    }
+
+    inline std::size_t message_batch::size() const noexcept
+    {
+        return std::get<headers>(this->members_).size();
+    }
+
+    inline std::size_t message_batch::buffer_size() const noexcept
+    {
+        return std::get<buffer_size_member>(this->members_);
+    }
+
+    inline std::size_t message_batch::control_size() const noexcept
+    {
+        return std::get<control_size_member>(this->members_);
+    }
+
+    inline void * message_batch::buffer(const std::size_t i) noexcept
+    {
+        return std::get<iovecs>(this->members_)[i].iov_base;
+    }
+
+    inline void const * message_batch::buffer(const std::size_t i) const noexcept
+    {
+        return std::get<iovecs>(this->members_)[i].iov_base;
+    }
+
+    inline std::size_t message_batch::length(const std::size_t i) const noexcept
+    {
+        return std::get<headers>(this->members_)[i].msg_len;
+    }
+
+    inline const struct ::sockaddr_in & message_batch::address(const std::size_t i) const noexcept
+    {
+        return std::get<addresses>(this->members_)[i];
+    }
+
+    inline int message_batch::flags(const std::size_t i) const noexcept
+    {
+        return std::get<headers>(this->members_)[i].msg_hdr.msg_flags;
+    }
+
+    inline void * message_batch::control(const std::size_t i) noexcept
+    {
+        return std::get<headers>(this->members_)[i].msg_hdr.msg_control;
+    }
+
+    inline std::size_t message_batch::control_length(const std::size_t i) const noexcept
+    {
+        return std::get<headers>(this->members_)[i].msg_hdr.msg_controllen;
+    }
+}
+}
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef LIBLINUXPP_NET_MULTICAST_SUBSCRIBER_HPP
+#define LIBLINUXPP_NET_MULTICAST_SUBSCRIBER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <libndgpp/net/ipv4_address.hpp>
+#include <libndgpp/net/multicast_ipv4_address.hpp>
+#include <libndgpp/net/port.hpp>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/message_batch.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** Receives many multicast groups on a single socket
+     *
+     *  The subscriber's socket is bound to INADDR_ANY on one port
+     *  with IP_MULTICAST_ALL disabled, so it only receives the groups
+     *  it joined, and IP_PKTINFO enabled, so every datagram is
+     *  dispatched to its group's handler by its destination address.
+     *  Datagrams are drained with recvmmsg, so one wakeup delivers
+     *  the datagrams of every group that has data.
+     *
+     *  Interface indexes are looked up once per interface name and
+     *  cached.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class multicast_subscriber final
+    {
+        public:
+
+        /// A received multicast datagram
+        struct datagram
+        {
+            /// The group the datagram was sent to
+            ndgpp::net::ipv4_address group;
+
+            ndgpp::net::ipv4_address source;
+            ndgpp::net::port source_port;
+
+            /// The index of the interface the datagram arrived on
+            int ifindex;
+
+            void const * data;
+            std::size_t size;
+
+            /// True if the datagram was larger than the subscriber's buffer size
+            bool truncated;
+        };
+
+        using handler_type = std::function<void (const datagram &)>;
+
+        /** Constructs a multicast_subscriber object
+         *
+         *  @param port The port the groups are sent to
+         *  @param batch_size The number of datagrams received per system call
+         *  @param buffer_size The maximum datagram size
+         *
+         *  @throws ndgpp::error<std::system_error> if the socket
+         *          cannot be created, configured, or bound
+         */
+        multicast_subscriber(const ndgpp::net::port port,
+                             const std::size_t batch_size = 32,
+                             const std::size_t buffer_size = 2048);
+
+        ~multicast_subscriber();
+
+        multicast_subscriber(const multicast_subscriber &) = delete;
+        multicast_subscriber & operator= (const multicast_subscriber &) = delete;
+
+        multicast_subscriber(multicast_subscriber &&) = delete;
+        multicast_subscriber & operator= (multicast_subscriber &&) = delete;
+
+        /** Joins a group on an interface (MCAST_JOIN_GROUP)
+         *
+         *  A group can be joined on several interfaces, and every
+         *  join shares the group's handler.  The last handler
+         *  passed for a group replaces the earlier ones.
+         *
+         *  @param group The group to join
+         *  @param interface The name of the interface to join the group on
+         *  @param handler The function called for each of the group's datagrams
+         *
+         *  @throws ndgpp::error<std::system_error> if the interface
+         *          doesn't exist or the join fails
+         */
+        void subscribe(const ndgpp::net::multicast_ipv4_address group,
+                       char const * const interface,
+                       handler_type handler);
+
+        /** Joins a group for a single source on an interface (MCAST_JOIN_SOURCE_GROUP)
+         *
+         *  @param group The group to join
+         *  @param source The address of the source to receive from
+         *  @param interface The name of the interface to join the group on
+         *  @param handler The function called for each of the group's datagrams
+         */
+        void subscribe(const ndgpp::net::multicast_ipv4_address group,
+                       const ndgpp::net::ipv4_address source,
+                       char const * const interface,
+                       handler_type handler);
+
+        /** Leaves a group on an interface
+         *
+         *  The group's handler is removed when the group is no longer
+         *  joined on any interface.  A handler may unsubscribe its own
+         *  group, it's destroyed once the batch is dispatched.
+         */
+        void unsubscribe(const ndgpp::net::multicast_ipv4_address group,
+                         char const * const interface);
+
+        /// Leaves a source specific group on an interface
+        void unsubscribe(const ndgpp::net::multicast_ipv4_address group,
+                         const ndgpp::net::ipv4_address source,
+                         char const * const interface);
+
+        /** Receives and dispatches the datagrams that are queued on the socket
+         *
+         *  Datagrams for a group without a handler are dropped.
+         *
+         *  @param max_batches The maximum number of recvmmsg calls to
+         *                     make, which bounds the time spent when
+         *                     the groups' data rate is high
+         *
+         *  @return The number of datagrams received
+         *
+         *  @throws ndgpp::error<std::system_error> if recvmmsg fails
+         *          for a reason other than EAGAIN
+         */
+        std::size_t receive(const std::size_t max_batches = 16);
+
+        /** Registers the socket with an ioloop, which calls receive when it's readable
+         *
+         *  @note The subscriber must be detached, or the ioloop
+         *        stopped, before the subscriber is destroyed
+         */
+        void attach(linuxpp::ioloop & loop);
+
+        /// Removes the socket from the ioloop it's attached to
+        void detach();
+
+        /// Returns the number of groups with a handler
+        std::size_t group_count() const noexcept;
+
+        /// Returns the underlying socket descriptor
+        int descriptor() const noexcept;
+
+        private:
+
+        struct group_entry
+        {
+            // Allocated separately so a running handler survives its
+            // entry being erased or its handler being replaced
+            std::unique_ptr<handler_type> handler;
+            std::size_t memberships;
+        };
+
+        /// Marks a batch as dispatching, and destroys its retired handlers when it's done
+        struct dispatch_sentry
+        {
+            explicit
+            dispatch_sentry(multicast_subscriber & subscriber) noexcept;
+
+            ~dispatch_sentry();
+
+            multicast_subscriber & subscriber;
+        };
+
+        unsigned int ifindex(char const * const interface);
+
+        void add_membership(const ndgpp::net::multicast_ipv4_address group,
+                            handler_type handler);
+
+        void remove_membership(const ndgpp::net::multicast_ipv4_address group);
+
+        linuxpp::net::udp_socket socket_;
+        linuxpp::net::message_batch batch_;
+        linuxpp::ioloop * loop_ = nullptr;
+
+        // keyed by group address in host byte order
+        std::unordered_map<std::uint32_t, group_entry> groups_;
+
+        // Handlers removed or replaced while dispatching, which may
+        // still be running
+        bool dispatching_ = false;
+        std::vector<std::unique_ptr<handler_type>> retired_handlers_;
+        std::unordered_map<std::string, unsigned int> ifindex_cache_;
+    };
+}
+}
+
+#endif
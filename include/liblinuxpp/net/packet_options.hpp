@@ -0,0 +1,68 @@
+#ifndef LIBLINUXPP_NET_PACKET_OPTIONS_HPP
+#define LIBLINUXPP_NET_PACKET_OPTIONS_HPP
+
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+
+#include <liblinuxpp/net/sockopt_traits.hpp>
+
+namespace linuxpp {
+namespace net {
+namespace so {
+
+    template <int Name>
+    struct packet_trait
+    {
+        static constexpr int level() noexcept { return SOL_PACKET; };
+        static constexpr int name = Name;
+    };
+
+    /// PACKET_VERSION socket option, one of the tpacket_versions values
+    struct packet_version {};
+    template <>
+    struct traits<packet_version> : public packet_trait<PACKET_VERSION>
+    {
+        using value_type = int;
+    };
+
+    /// PACKET_RX_RING socket option for TPACKET_V3 rings
+    struct packet_rx_ring {};
+    template <>
+    struct traits<packet_rx_ring> : public packet_trait<PACKET_RX_RING>
+    {
+        using value_type = struct ::tpacket_req3;
+    };
+
+    /// PACKET_TX_RING socket option for TPACKET_V3 rings
+    struct packet_tx_ring {};
+    template <>
+    struct traits<packet_tx_ring> : public packet_trait<PACKET_TX_RING>
+    {
+        using value_type = struct ::tpacket_req3;
+    };
+
+    /** PACKET_FANOUT socket option
+     *
+     *  The value is the group id in the low 16 bits, and a
+     *  PACKET_FANOUT mode and flags in the high 16 bits
+     */
+    struct packet_fanout {};
+    template <>
+    struct traits<packet_fanout> : public packet_trait<PACKET_FANOUT>
+    {
+        using value_type = int;
+    };
+
+    /** PACKET_STATISTICS socket option for TPACKET_V3 sockets
+     *
+     *  Reading the statistics resets them
+     */
+    struct packet_statistics {};
+    template <>
+    struct traits<packet_statistics> : public packet_trait<PACKET_STATISTICS>
+    {
+        using value_type = struct ::tpacket_stats_v3;
+    };
+}}}
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef LIBLINUXPP_NET_PACKET_SOCKET_HPP
+#define LIBLINUXPP_NET_PACKET_SOCKET_HPP
+
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <time.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <chrono>
+#include <functional>
+#include <iterator>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /// The geometry of a TPACKET_V3 ring
+    struct packet_ring_config
+    {
+        /// The size of a block, a multiple of the page size
+        std::size_t block_size = 1 << 20;
+
+        /// The number of blocks in the ring, 0 disables the ring
+        std::size_t block_count = 0;
+
+        /** The size of a frame, a multiple of TPACKET_ALIGNMENT
+         *
+         *  Received frames are packed into a block by their actual
+         *  size, so for the RX ring this only bounds the size of a
+         *  captured frame.  TX frames are always frame_size apart.
+         */
+        std::size_t frame_size = 2048;
+
+        /** How long the kernel fills an RX block before handing it
+         *  to user space, even when it isn't full
+         */
+        std::chrono::milliseconds block_timeout {10};
+    };
+
+    /// A frame received in a packet_socket RX block
+    struct packet_frame
+    {
+        /// The frame starting at its link layer header
+        void const * data;
+
+        /// The number of captured bytes
+        std::size_t length;
+
+        /// The frame's length on the wire
+        std::size_t wire_length;
+
+        /// The time the kernel received the frame
+        struct ::timespec timestamp;
+
+        /// The direction of the frame, PACKET_HOST, PACKET_OUTGOING, etc.
+        unsigned char packet_type;
+    };
+
+    /** A zero-copy view of the frames in a TPACKET_V3 RX block
+     *
+     *  The view is valid until the block is released back to the
+     *  kernel.
+     */
+    class packet_block final
+    {
+        public:
+
+        class const_iterator
+        {
+            public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = linuxpp::net::packet_frame;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type const *;
+            using reference = value_type;
+
+            const_iterator() = default;
+
+            const_iterator(struct ::tpacket3_hdr const * const frame,
+                           const std::size_t remaining) noexcept:
+                frame_(frame),
+                remaining_(remaining)
+            {}
+
+            linuxpp::net::packet_frame operator* () const noexcept
+            {
+                char const * const base = reinterpret_cast<char const *>(this->frame_);
+                struct ::sockaddr_ll const * const ll =
+                    reinterpret_cast<struct ::sockaddr_ll const *>(base + TPACKET_ALIGN(sizeof(struct ::tpacket3_hdr)));
+
+                linuxpp::net::packet_frame frame;
+                frame.data = base + this->frame_->tp_mac;
+                frame.length = this->frame_->tp_snaplen;
+                frame.wire_length = this->frame_->tp_len;
+                frame.timestamp.tv_sec = this->frame_->tp_sec;
+                frame.timestamp.tv_nsec = this->frame_->tp_nsec;
+                frame.packet_type = ll->sll_pkttype;
+                return frame;
+            }
+
+            const_iterator & operator++ () noexcept
+            {
+                if (--this->remaining_ == 0)
+                {
+                    this->frame_ = nullptr;
+                }
+                else
+                {
+                    this->frame_ = reinterpret_cast<struct ::tpacket3_hdr const *>(
+                        reinterpret_cast<char const *>(this->frame_) + this->frame_->tp_next_offset);
+                }
+
+                return *this;
+            }
+
+            const_iterator operator++ (int) noexcept
+            {
+                const_iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator== (const const_iterator & other) const noexcept
+            {
+                return this->frame_ == other.frame_;
+            }
+
+            bool operator!= (const const_iterator & other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+            private:
+
+            struct ::tpacket3_hdr const * frame_ = nullptr;
+            std::size_t remaining_ = 0;
+        };
+
+        explicit
+        packet_block(struct ::tpacket_block_desc const * const desc) noexcept:
+            desc_(desc)
+        {}
+
+        /// Returns the number of frames in the block
+        std::size_t size() const noexcept
+        {
+            return this->desc_->hdr.bh1.num_pkts;
+        }
+
+        /// Returns true if the block was retired by its timeout before it was full
+        bool timed_out() const noexcept
+        {
+            return (this->desc_->hdr.bh1.block_status & TP_STATUS_BLK_TMO) != 0;
+        }
+
+        /// Returns the block's sequence number, which increases by one per block
+        std::uint64_t sequence() const noexcept
+        {
+            return this->desc_->hdr.bh1.seq_num;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            if (this->size() == 0)
+            {
+                return this->end();
+            }
+
+            return const_iterator {
+                reinterpret_cast<struct ::tpacket3_hdr const *>(
+                    reinterpret_cast<char const *>(this->desc_) + this->desc_->hdr.bh1.offset_to_first_pkt),
+                this->size()};
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator {};
+        }
+
+        private:
+
+        struct ::tpacket_block_desc const * desc_;
+    };
+
+    /** An AF_PACKET socket with TPACKET_V3 memory mapped RX and TX rings
+     *
+     *  The kernel writes received frames straight into the RX ring's
+     *  blocks and reads transmitted frames straight out of the TX
+     *  ring's frames, so neither direction copies frames across the
+     *  system call boundary.  RX blocks are handed to user space when
+     *  they fill up or their timeout expires, and the socket becomes
+     *  readable when a block is ready.
+     *
+     *  Creating the socket requires CAP_NET_RAW.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class packet_socket final
+    {
+        public:
+
+        using frame_handler = std::function<void (const linuxpp::net::packet_frame &)>;
+
+        /** Constructs a packet_socket object bound to an interface
+         *
+         *  @param interface The name of the interface to bind to
+         *  @param rx The RX ring's geometry
+         *  @param tx The TX ring's geometry
+         *  @param protocol The link layer protocol to receive in host
+         *                  byte order, ETH_P_ALL receives every frame
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if neither
+         *          ring has any blocks
+         *  @throws ndgpp::error<std::system_error> if the socket
+         *          cannot be created, a ring's geometry is rejected,
+         *          the rings cannot be mapped, or the interface
+         *          doesn't exist
+         */
+        packet_socket(char const * const interface,
+                      const linuxpp::net::packet_ring_config & rx,
+                      const linuxpp::net::packet_ring_config & tx = linuxpp::net::packet_ring_config {},
+                      const std::uint16_t protocol = ETH_P_ALL);
+
+        ~packet_socket();
+
+        packet_socket(const packet_socket &) = delete;
+        packet_socket & operator= (const packet_socket &) = delete;
+
+        packet_socket(packet_socket &&) = delete;
+        packet_socket & operator= (packet_socket &&) = delete;
+
+        /** Joins a fanout group, which spreads frames among the group's sockets
+         *
+         *  Every socket in the group must be bound to the same
+         *  interface and protocol.
+         *
+         *  @param group The group's id
+         *  @param mode A PACKET_FANOUT mode, such as PACKET_FANOUT_HASH or PACKET_FANOUT_CPU
+         *  @param flags PACKET_FANOUT_FLAG values
+         */
+        void join_fanout(const std::uint16_t group,
+                         const int mode = PACKET_FANOUT_HASH,
+                         const int flags = 0);
+
+        // RX ring functions
+
+        /// Returns true if the next RX block has been handed to user space
+        bool rx_ready() const noexcept;
+
+        /** Returns the next RX block
+         *
+         *  @pre rx_ready() returns true
+         */
+        linuxpp::net::packet_block rx_block() const noexcept;
+
+        /// Returns the next RX block to the kernel, which invalidates its frames
+        void release_rx_block() noexcept;
+
+        /** Calls handler for every frame in the ready RX blocks and releases the blocks
+         *
+         *  @param handler The function called for each frame
+         *  @param max_blocks The maximum number of blocks to process
+         *
+         *  @return The number of frames processed
+         */
+        std::size_t receive(const frame_handler & handler,
+                            const std::size_t max_blocks = static_cast<std::size_t>(-1));
+
+        // TX ring functions
+
+        /// Returns the maximum size of a transmitted frame
+        std::size_t tx_frame_capacity() const noexcept;
+
+        /** Returns the next free TX frame's buffer, or nullptr if the ring is full
+         *
+         *  The frame is written in place and queued with commit_tx_frame.
+         */
+        void * tx_frame() noexcept;
+
+        /** Queues the frame returned by tx_frame
+         *
+         *  @param length The length of the frame, including its link
+         *                layer header
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if length
+         *          exceeds tx_frame_capacity
+         */
+        void commit_tx_frame(const std::size_t length);
+
+        /** Copies a frame into the TX ring and queues it
+         *
+         *  @return false if the ring is full
+         */
+        bool queue(void const * const data, const std::size_t length);
+
+        /** Asks the kernel to transmit the queued frames
+         *
+         *  @param flags MSG_DONTWAIT returns without waiting for the
+         *               frames to be sent
+         *
+         *  @throws ndgpp::error<std::system_error> when an error other
+         *          than EAGAIN is encountered
+         */
+        void flush(const int flags = 0);
+
+        /// Registers the socket with an ioloop, which calls receive(handler) when a block is ready
+        void attach(linuxpp::ioloop & loop, frame_handler handler);
+
+        /// Removes the socket from the ioloop it's attached to
+        void detach();
+
+        /** Returns and resets the socket's frame and drop counts
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        struct ::tpacket_stats_v3 statistics();
+
+        /// Returns the index of the interface the socket is bound to
+        int ifindex() const noexcept;
+
+        /// Returns the underlying socket descriptor
+        int descriptor() const noexcept;
+
+        private:
+
+        struct ring
+        {
+            char * base = nullptr;
+            std::size_t block_size = 0;
+            std::size_t block_count = 0;
+            std::size_t frame_size = 0;
+            std::size_t frames_per_block = 0;
+            std::size_t index = 0;
+        };
+
+        struct ::tpacket3_hdr * tx_header(const std::size_t index) const noexcept;
+
+        linuxpp::unique_fd<> socket_;
+        void * map_ = nullptr;
+        std::size_t map_size_ = 0;
+        ring rx_;
+        ring tx_;
+        int ifindex_ = 0;
+        linuxpp::ioloop * loop_ = nullptr;
+    };
+}
+}
+
+#endif
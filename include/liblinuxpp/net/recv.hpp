@@ -4,17 +4,47 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <time.h>
 
 #include <cstddef>
 
+#include <chrono>
+#include <new>
+
 #include <libndgpp/net/ipv4_address.hpp>
 #include <libndgpp/net/port.hpp>
 
+#include <liblinuxpp/net/cmsg.hpp>
 #include <liblinuxpp/net/sockaddr.hpp>
+#include <liblinuxpp/syscall_return.hpp>
 
 namespace linuxpp {
 namespace net {
 
+    /** The control buffer size needed to receive a kernel timestamp
+     *
+     *  Large enough for either an SCM_TIMESTAMPNS or an
+     *  SCM_TIMESTAMPING control message.
+     */
+    constexpr std::size_t timestamp_control_size =
+        linuxpp::net::cmsg::space<linuxpp::net::cmsg::timestamping>::value;
+
+    /** Returns the kernel receive timestamp of a received message
+     *
+     *  Looks for an SCM_TIMESTAMPNS control message, enabled by the
+     *  SO_TIMESTAMPNS socket option, or an SCM_TIMESTAMPING control
+     *  message, enabled by SO_TIMESTAMPING, in which case the
+     *  software timestamp is returned, or the raw hardware timestamp
+     *  if there is no software timestamp.
+     *
+     *  @return The CLOCK_REALTIME receive time, or a zero timespec if
+     *          the message has no timestamp
+     */
+    struct ::timespec receive_timestamp(const struct ::msghdr & msg) noexcept;
+
+    /// Returns the kernel receive timestamp from a message's parsed control messages
+    struct ::timespec receive_timestamp(const linuxpp::net::cmsg::parser & control) noexcept;
+
     /** @defgroup net::recv net::recv
      *
      *  The net::recv overload set contains functions for receiving
@@ -34,6 +64,22 @@ namespace net {
      *
      *  @param addr A ndgpp::net IP address struct
      *  @param port A ndgpp::net::port type to store the port information
+     *  @param timestamp The message's kernel receive timestamp, zero
+     *                   if the socket doesn't have SO_TIMESTAMPNS or
+     *                   SO_TIMESTAMPING enabled
+     *
+     *  @param control The parser to receive the message's control
+     *                 messages into
+     *
+     *  @param msgs An array of mmsghdr structures, one per message
+     *  @param size_msgs The number of mmsghdr structures in msgs
+     *
+     *  @param timeout The time limit for receiving the messages.
+     *                 recvmmsg only checks the timeout after each
+     *                 received message, so this does not bound the
+     *                 time spent waiting for the first one; use
+     *                 MSG_WAITFORONE or a non-blocking socket for
+     *                 that.
      *
      *  @{
      */
@@ -87,6 +133,243 @@ namespace net {
                      ndgpp::net::ipv4_address & addr,
                      ndgpp::net::port & port,
                      const int flags = 0);
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    std::size_t recv(const int sd,
+                     void * buf,
+                     const std::size_t buflen,
+                     struct ::timespec & timestamp,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    std::size_t recv(const int sd,
+                     void * buf,
+                     const std::size_t buflen,
+                     struct ::sockaddr_in & sockaddr,
+                     struct ::timespec & timestamp,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    std::size_t recv(const int sd,
+                     struct iovec * const buffs,
+                     const std::size_t size_bufs,
+                     struct ::timespec & timestamp,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    std::size_t recv(const int sd,
+                     struct iovec * const buffs,
+                     const std::size_t size_bufs,
+                     struct ::sockaddr_in & sockaddr,
+                     struct ::timespec & timestamp,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and receives control messages
+    std::size_t recv(const int sd,
+                     void * buf,
+                     const std::size_t buflen,
+                     linuxpp::net::cmsg::parser & control,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and receives control messages
+    std::size_t recv(const int sd,
+                     void * buf,
+                     const std::size_t buflen,
+                     struct ::sockaddr_in & sockaddr,
+                     linuxpp::net::cmsg::parser & control,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and receives control messages
+    std::size_t recv(const int sd,
+                     struct iovec * const buffs,
+                     const std::size_t size_bufs,
+                     linuxpp::net::cmsg::parser & control,
+                     const int flags = 0);
+
+    /// Calls the recvmsg system call and receives control messages
+    std::size_t recv(const int sd,
+                     struct iovec * const buffs,
+                     const std::size_t size_bufs,
+                     struct ::sockaddr_in & sockaddr,
+                     linuxpp::net::cmsg::parser & control,
+                     const int flags = 0);
+
+    /** Calls the recvmmsg system call
+     *
+     *  Each message's length is stored in its mmsghdr::msg_len
+     *  field, and its source address and flags in its msg_hdr
+     *
+     *  @return The number of messages received
+     */
+    std::size_t recv(const int sd,
+                     struct ::mmsghdr * const msgs,
+                     const std::size_t size_msgs,
+                     const int flags = 0);
+
+    /// Calls the recvmmsg system call with a timeout
+    std::size_t recv(const int sd,
+                     struct ::mmsghdr * const msgs,
+                     const std::size_t size_msgs,
+                     const int flags,
+                     const std::chrono::nanoseconds timeout);
+    /// @}
+
+    /** @defgroup net::recv_nothrow net::recv (std::nothrow_t)
+     *
+     *  Versions of the net::recv overloads that report errors in
+     *  their return value instead of throwing
+     *
+     *  EAGAIN and EWOULDBLOCK are how a drain loop on a non-blocking
+     *  socket finds out the socket is empty, so they shouldn't cost
+     *  an exception.  A source address that isn't an IPv4 address is
+     *  reported as EINVAL.  The parameters are the same as the
+     *  throwing overloads'.
+     *
+     *  @return The number of bytes received, or messages received
+     *          for the mmsghdr overloads, or the errno value
+     *
+     *  @{
+     */
+
+    /// Calls the recv system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvfrom system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            struct ::sockaddr * sockaddr,
+                                            ::socklen_t * addrlen,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvfrom system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            struct ::sockaddr_in & sockaddr,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvfrom system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            ndgpp::net::ipv4_address & addr,
+                                            ndgpp::net::port & port,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            struct ::sockaddr_in & sockaddr,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            ndgpp::net::ipv4_address & addr,
+                                            ndgpp::net::port & port,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            struct ::timespec & timestamp,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            struct ::sockaddr_in & sockaddr,
+                                            struct ::timespec & timestamp,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            struct ::timespec & timestamp,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and returns the receive timestamp
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            struct ::sockaddr_in & sockaddr,
+                                            struct ::timespec & timestamp,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and receives control messages
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            linuxpp::net::cmsg::parser & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and receives control messages
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            void * buf,
+                                            const std::size_t buflen,
+                                            struct ::sockaddr_in & sockaddr,
+                                            linuxpp::net::cmsg::parser & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and receives control messages
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            linuxpp::net::cmsg::parser & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmsg system call and receives control messages
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_bufs,
+                                            struct ::sockaddr_in & sockaddr,
+                                            linuxpp::net::cmsg::parser & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmmsg system call
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct ::mmsghdr * const msgs,
+                                            const std::size_t size_msgs,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the recvmmsg system call with a timeout
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct ::mmsghdr * const msgs,
+                                            const std::size_t size_msgs,
+                                            const int flags,
+                                            const std::chrono::nanoseconds timeout) noexcept;
     /// @}
 }}
 
@@ -0,0 +1,275 @@
+#ifndef LIBLINUXPP_NET_REUSEPORT_GROUP_HPP
+#define LIBLINUXPP_NET_REUSEPORT_GROUP_HPP
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libndgpp/error.hpp>
+#include <libndgpp/net/ipv4_address.hpp>
+#include <libndgpp/net/port.hpp>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/bind.hpp>
+#include <liblinuxpp/net/bpf.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /// How a reuseport_group distributes packets or connections among its sockets
+    enum class reuseport_steering
+    {
+        /// The kernel's default, a hash of the 4-tuple
+        kernel,
+
+        /** The socket at index CPU % group size, where CPU is the CPU
+         *  that processes the packet
+         *
+         *  Pinning the thread that serves socket i to CPU i keeps a
+         *  flow on one core from the NIC queue to the application.
+         */
+        cpu,
+
+        /** The socket at index receive hash % group size
+         *
+         *  The receive hash is the NIC's RSS hash or the stack's flow
+         *  hash.  Packets without one fall back to the kernel's
+         *  4-tuple hash.
+         */
+        hash,
+    };
+
+    /** Returns a SO_ATTACH_REUSEPORT_CBPF program implementing a steering policy
+     *
+     *  @param steering The steering policy, must not be reuseport_steering::kernel
+     *  @param group_size The number of sockets in the group
+     *
+     *  @throws ndgpp::error<std::invalid_argument> if steering is
+     *          kernel or group_size is 0
+     */
+    linuxpp::net::bpf::program reuseport_program(const linuxpp::net::reuseport_steering steering,
+                                                 const std::uint32_t group_size);
+
+    /** Attaches a SO_ATTACH_REUSEPORT_CBPF program to a socket's reuseport group
+     *
+     *  @throws ndgpp::error<std::system_error> if the program is
+     *          rejected or the socket isn't in a reuseport group
+     */
+    void attach_reuseport_program(const int sd,
+                                  const linuxpp::net::bpf::program & program);
+
+    /** A set of sockets bound to the same address and port with SO_REUSEPORT
+     *
+     *  Each socket is meant to be served by its own ioloop thread,
+     *  and a classic BPF program steers each packet or connection to
+     *  the socket of the thread that should handle it, instead of
+     *  every thread contending for a single socket.
+     *
+     *  @tparam Socket linuxpp::net::udp_socket or linuxpp::net::tcp_socket
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    template <class Socket>
+    class reuseport_group final
+    {
+        public:
+
+        /** Constructs a reuseport_group object
+         *
+         *  @param addr The address to bind the sockets to
+         *  @param port The port to bind the sockets to, 0 binds the
+         *              group to an ephemeral port
+         *  @param size The number of sockets in the group
+         *  @param steering How packets or connections are distributed
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if size is 0
+         *  @throws ndgpp::error<std::system_error> if a socket cannot
+         *          be created or bound, or the program cannot be attached
+         */
+        reuseport_group(const ndgpp::net::ipv4_address addr,
+                        const ndgpp::net::port port,
+                        const std::size_t size,
+                        const linuxpp::net::reuseport_steering steering);
+
+        ~reuseport_group();
+
+        reuseport_group(const reuseport_group &) = delete;
+        reuseport_group & operator= (const reuseport_group &) = delete;
+
+        reuseport_group(reuseport_group &&) = delete;
+        reuseport_group & operator= (reuseport_group &&) = delete;
+
+        /** Calls listen on every socket, tcp_socket groups only
+         *
+         *  A TCP group's steering program is attached once every
+         *  socket is listening, since the kernel only forms a TCP
+         *  reuseport group when its sockets listen.
+         */
+        void listen(const int backlog);
+
+        /** Registers socket index with an ioloop
+         *
+         *  @param index The socket to register
+         *  @param loop The ioloop that serves the socket
+         *  @param callback Called when the socket is ready
+         *  @param events The events to monitor, see linuxpp::ioloop::event_enum
+         *
+         *  @note The socket must be detached, or the ioloop stopped,
+         *        before the group is destroyed
+         */
+        void attach(const std::size_t index,
+                    linuxpp::ioloop & loop,
+                    std::function<void (int fd, uint32_t events)> callback,
+                    const uint32_t events = linuxpp::ioloop::event_enum::read);
+
+        /// Removes socket index from the ioloop it's registered with
+        void detach(const std::size_t index);
+
+        /// Returns the socket at index
+        Socket & socket(const std::size_t index) noexcept;
+
+        /// Returns the number of sockets in the group
+        std::size_t size() const noexcept;
+
+        /// Returns the port the group is bound to
+        ndgpp::net::port port() const noexcept;
+
+        private:
+
+        void attach_program();
+
+        std::vector<Socket> sockets_;
+        std::vector<linuxpp::ioloop *> loops_;
+        ndgpp::net::port port_;
+        linuxpp::net::reuseport_steering steering_;
+    };
+
+    using udp_reuseport_group = reuseport_group<linuxpp::net::udp_socket>;
+    using tcp_reuseport_group = reuseport_group<linuxpp::net::tcp_socket>;
+
+    template <class Socket>
+    reuseport_group<Socket>::reuseport_group(const ndgpp::net::ipv4_address addr,
+                                             const ndgpp::net::port port,
+                                             const std::size_t size,
+                                             const linuxpp::net::reuseport_steering steering):
+        loops_(size, nullptr),
+        port_(port),
+        steering_(steering)
+    {
+        if (size == 0)
+        {
+            throw ndgpp_error(std::invalid_argument, "reuseport_group size cannot be 0");
+        }
+
+        this->sockets_.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            this->sockets_.emplace_back(AF_INET);
+            const int sd = this->sockets_.back().descriptor();
+            linuxpp::net::bind(sd, addr, this->port_, false, true);
+
+            if (i == 0)
+            {
+                // The rest of the sockets join the first socket's port
+                std::tie(std::ignore, this->port_) = linuxpp::net::getsockname_ipv4(sd);
+            }
+        }
+
+        if (!std::is_same<Socket, linuxpp::net::tcp_socket>::value)
+        {
+            this->attach_program();
+        }
+    }
+
+    template <class Socket>
+    reuseport_group<Socket>::~reuseport_group()
+    {
+        for (std::size_t i = 0; i < this->loops_.size(); ++i)
+        {
+            this->detach(i);
+        }
+    }
+
+    template <class Socket>
+    void reuseport_group<Socket>::listen(const int backlog)
+    {
+        for (auto & socket : this->sockets_)
+        {
+            socket.listen(backlog);
+        }
+
+        this->attach_program();
+    }
+
+    template <class Socket>
+    void reuseport_group<Socket>::attach_program()
+    {
+        if (this->steering_ != linuxpp::net::reuseport_steering::kernel)
+        {
+            // The program is shared by the whole group
+            linuxpp::net::attach_reuseport_program(this->sockets_.front().descriptor(),
+                                                   linuxpp::net::reuseport_program(this->steering_,
+                                                                                   static_cast<std::uint32_t>(this->sockets_.size())));
+        }
+    }
+
+    template <class Socket>
+    void reuseport_group<Socket>::attach(const std::size_t index,
+                                         linuxpp::ioloop & loop,
+                                         std::function<void (int fd, uint32_t events)> callback,
+                                         const uint32_t events)
+    {
+        if (this->loops_.at(index) != nullptr)
+        {
+            throw ndgpp_error(std::logic_error, "reuseport_group socket is already attached to an ioloop");
+        }
+
+        loop.add_handler(this->sockets_[index].descriptor(), events, std::move(callback));
+        this->loops_[index] = &loop;
+    }
+
+    template <class Socket>
+    void reuseport_group<Socket>::detach(const std::size_t index)
+    {
+        if (this->loops_.at(index) == nullptr)
+        {
+            return;
+        }
+
+        this->loops_[index]->remove_handler(this->sockets_[index].descriptor());
+        this->loops_[index] = nullptr;
+    }
+
+    template <class Socket>
+    inline Socket & reuseport_group<Socket>::socket(const std::size_t index) noexcept
+    {
+        return this->sockets_[index];
+    }
+
+    template <class Socket>
+    inline std::size_t reuseport_group<Socket>::size() const noexcept
+    {
+        return this->sockets_.size();
+    }
+
+    template <class Socket>
+    inline ndgpp::net::port reuseport_group<Socket>::port() const noexcept
+    {
+        return this->port_;
+    }
+}
+}
+
+#endif
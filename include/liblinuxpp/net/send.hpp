@@ -8,11 +8,15 @@
 #include <sys/uio.h>
 
 #include <array>
+#include <new>
 #include <vector>
 
 #include <libndgpp/net/ipv4_address.hpp>
 #include <libndgpp/net/port.hpp>
 
+#include <liblinuxpp/net/cmsg.hpp>
+#include <liblinuxpp/syscall_return.hpp>
+
 namespace linuxpp {
 namespace net {
 
@@ -29,6 +33,7 @@ namespace net {
      *  @param sockaddr The sockaddr type
      *  @param buffers The struct iovec array to send
      *  @param size_buffers the size of the struct iovec array
+     *  @param control The control messages to send with the message
      *
      *  @return The number of bytes sent
      *  @throws ndgpp::error<std::system_error> if an error is encountered
@@ -68,6 +73,153 @@ namespace net {
                      iovec const * buffers,
                      const std::size_t size_buffers,
                      const int flags = 0);
+
+    /// Calls the sendmsg system call with control messages
+    std::size_t send(const int sd,
+                     void const * const msg,
+                     const std::size_t length,
+                     const linuxpp::net::cmsg::builder & control,
+                     const int flags = 0);
+
+    /// Calls the sendmsg system call with control messages
+    std::size_t send(const int sd,
+                     void const * const msg,
+                     const std::size_t length,
+                     const struct ::sockaddr_in sockaddr,
+                     const linuxpp::net::cmsg::builder & control,
+                     const int flags = 0);
+
+    /// Calls the sendmsg system call with control messages
+    std::size_t send(const int sd,
+                     iovec const * buffers,
+                     const std::size_t size_buffers,
+                     const linuxpp::net::cmsg::builder & control,
+                     const int flags = 0);
+
+    /// Calls the sendmsg system call with control messages
+    std::size_t send(const int sd,
+                     iovec const * buffers,
+                     const std::size_t size_buffers,
+                     const struct ::sockaddr_in sockaddr,
+                     const linuxpp::net::cmsg::builder & control,
+                     const int flags = 0);
+
+    /** Calls the sendmmsg system call
+     *
+     *  The number of bytes sent for each message is stored in its
+     *  mmsghdr::msg_len field
+     *
+     *  @param msgs An array of mmsghdr structures, one per message
+     *  @param size_msgs The number of mmsghdr structures in msgs
+     *
+     *  @return The number of messages sent, which may be less than size_msgs
+     */
+    std::size_t send(const int sd,
+                     struct ::mmsghdr * const msgs,
+                     const std::size_t size_msgs,
+                     const int flags = 0);
+    /// @}
+
+    /** @defgroup net::send_nothrow net::send (std::nothrow_t)
+     *
+     *  Versions of the net::send overloads that report errors in
+     *  their return value instead of throwing, so a full socket
+     *  buffer (EAGAIN) doesn't cost an exception.  The parameters
+     *  are the same as the throwing overloads'.
+     *
+     *  @return The number of bytes sent, or messages sent for the
+     *          mmsghdr overload, or the errno value
+     *
+     *  @{
+     */
+
+    /// Calls the sendmsg system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            const struct msghdr msghdr,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendto system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            void const * const msg,
+                                            std::size_t length,
+                                            const ndgpp::net::ipv4_address address,
+                                            const ndgpp::net::port port,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the send system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            void const * const msg,
+                                            std::size_t length,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendto system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            void const * const msg,
+                                            const std::size_t length,
+                                            const struct ::sockaddr_in sockaddr,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmsg system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            iovec const * buffers,
+                                            const std::size_t size_buffers,
+                                            const ndgpp::net::ipv4_address address,
+                                            const ndgpp::net::port port,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmsg system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            iovec const * buffers,
+                                            const std::size_t size_buffers,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmsg system call with control messages
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            void const * const msg,
+                                            const std::size_t length,
+                                            const linuxpp::net::cmsg::builder & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmsg system call with control messages
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            void const * const msg,
+                                            const std::size_t length,
+                                            const struct ::sockaddr_in sockaddr,
+                                            const linuxpp::net::cmsg::builder & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmsg system call with control messages
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            iovec const * buffers,
+                                            const std::size_t size_buffers,
+                                            const linuxpp::net::cmsg::builder & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmsg system call with control messages
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            iovec const * buffers,
+                                            const std::size_t size_buffers,
+                                            const struct ::sockaddr_in sockaddr,
+                                            const linuxpp::net::cmsg::builder & control,
+                                            const int flags = 0) noexcept;
+
+    /// Calls the sendmmsg system call
+    linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                            const int sd,
+                                            struct ::mmsghdr * const msgs,
+                                            const std::size_t size_msgs,
+                                            const int flags = 0) noexcept;
+    /// @}
 }}
 
 
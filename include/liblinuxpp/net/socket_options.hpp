@@ -1,6 +1,10 @@
 #ifndef LIBLINUXPP_NET_SOCKET_OPTIONS_HPP
 #define LIBLINUXPP_NET_SOCKET_OPTIONS_HPP
 
+#include <linux/filter.h>
+
+#include <cstdint>
+
 #include <liblinuxpp/net/sockopt_traits.hpp>
 
 namespace linuxpp {
@@ -39,6 +43,146 @@ namespace so {
     struct accept_conn {};
     template <>
     struct traits<accept_conn> : public socket_int_trait<SO_ACCEPTCONN> {};
+
+    /// SO_ERROR socket trait, read only, reading it clears the pending error
+    struct error {};
+    template <>
+    struct traits<error> : public socket_int_trait<SO_ERROR> {};
+
+    /// SO_TIMESTAMPNS socket trait
+    struct timestamp_ns {};
+    template <>
+    struct traits<timestamp_ns> : public socket_int_trait<SO_TIMESTAMPNS> {};
+
+    /** SO_TIMESTAMPING socket trait
+     *
+     *  The value is a combination of the SOF_TIMESTAMPING flags in
+     *  linux/net_tstamp.h
+     */
+    struct timestamping {};
+    template <>
+    struct traits<timestamping> : public socket_int_trait<SO_TIMESTAMPING> {};
+
+    /** SO_ATTACH_REUSEPORT_CBPF socket trait
+     *
+     *  The program selects the index of the socket in the
+     *  SO_REUSEPORT group that receives a packet or connection
+     */
+    struct attach_reuseport_cbpf {};
+    template <>
+    struct traits<attach_reuseport_cbpf> : public socket_trait<SO_ATTACH_REUSEPORT_CBPF>
+    {
+        using value_type = struct ::sock_fprog;
+    };
+
+    /** SO_ATTACH_FILTER socket trait
+     *
+     *  Packets the program returns 0 for are dropped before they're
+     *  queued on the socket
+     */
+    struct attach_filter {};
+    template <>
+    struct traits<attach_filter> : public socket_trait<SO_ATTACH_FILTER>
+    {
+        using value_type = struct ::sock_fprog;
+    };
+
+    /// SO_DETACH_FILTER socket trait, the value is ignored
+    struct detach_filter {};
+    template <>
+    struct traits<detach_filter> : public socket_int_trait<SO_DETACH_FILTER> {};
+
+    /// SO_LOCK_FILTER socket trait
+    struct lock_filter {};
+    template <>
+    struct traits<lock_filter> : public socket_int_trait<SO_LOCK_FILTER> {};
+
+    /** SO_RCVBUF socket trait
+     *
+     *  The kernel doubles the value to account for its bookkeeping
+     *  overhead and caps it at net.core.rmem_max
+     */
+    struct rcv_buf {};
+    template <>
+    struct traits<rcv_buf> : public socket_int_trait<SO_RCVBUF> {};
+
+    /// SO_RCVBUFFORCE socket trait, SO_RCVBUF without the rmem_max cap, requires CAP_NET_ADMIN
+    struct rcv_buf_force {};
+    template <>
+    struct traits<rcv_buf_force> : public socket_int_trait<SO_RCVBUFFORCE> {};
+
+    /** SO_SNDBUF socket trait
+     *
+     *  The kernel doubles the value to account for its bookkeeping
+     *  overhead and caps it at net.core.wmem_max
+     */
+    struct snd_buf {};
+    template <>
+    struct traits<snd_buf> : public socket_int_trait<SO_SNDBUF> {};
+
+    /// SO_SNDBUFFORCE socket trait, SO_SNDBUF without the wmem_max cap, requires CAP_NET_ADMIN
+    struct snd_buf_force {};
+    template <>
+    struct traits<snd_buf_force> : public socket_int_trait<SO_SNDBUFFORCE> {};
+
+    /// SO_RCVLOWAT socket trait, the number of bytes that must be queued before the socket is readable
+    struct rcv_lowat {};
+    template <>
+    struct traits<rcv_lowat> : public socket_int_trait<SO_RCVLOWAT> {};
+
+    /** SO_BUSY_POLL socket trait
+     *
+     *  The number of microseconds a blocking receive busy polls the
+     *  device queue before sleeping, raising it above
+     *  net.core.busy_read requires CAP_NET_ADMIN
+     */
+    struct busy_poll {};
+    template <>
+    struct traits<busy_poll> : public socket_int_trait<SO_BUSY_POLL> {};
+
+    /** SO_PREFER_BUSY_POLL socket trait
+     *
+     *  When set, busy polling defers the device's interrupts instead
+     *  of sharing the queue with softirq processing
+     */
+    struct prefer_busy_poll {};
+    template <>
+    struct traits<prefer_busy_poll> : public socket_int_trait<SO_PREFER_BUSY_POLL> {};
+
+    /// SO_INCOMING_CPU socket trait, the CPU that processes the socket's packets
+    struct incoming_cpu {};
+    template <>
+    struct traits<incoming_cpu> : public socket_int_trait<SO_INCOMING_CPU> {};
+
+    /// SO_INCOMING_NAPI_ID socket trait, read only
+    struct incoming_napi_id {};
+    template <>
+    struct traits<incoming_napi_id> : public socket_trait<SO_INCOMING_NAPI_ID>
+    {
+        using value_type = unsigned int;
+    };
+
+    /// SO_ZEROCOPY socket trait, allows MSG_ZEROCOPY sends
+    struct zerocopy {};
+    template <>
+    struct traits<zerocopy> : public socket_int_trait<SO_ZEROCOPY> {};
+
+    /// SO_MAX_PACING_RATE socket trait, in bytes per second
+    struct max_pacing_rate {};
+    template <>
+    struct traits<max_pacing_rate> : public socket_trait<SO_MAX_PACING_RATE>
+    {
+        using value_type = std::uint64_t;
+    };
+
+    /** SO_PRIORITY socket trait
+     *
+     *  The queueing priority of the socket's packets, values outside
+     *  of 0 to 6 require CAP_NET_ADMIN
+     */
+    struct priority {};
+    template <>
+    struct traits<priority> : public socket_int_trait<SO_PRIORITY> {};
 }}}
 
 #endif
@@ -0,0 +1,145 @@
+#ifndef LIBLINUXPP_NET_SOCKET_PROXY_HPP
+#define LIBLINUXPP_NET_SOCKET_PROXY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/pipe.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** Forwards data in both directions between two TCP sockets with splice
+     *
+     *  Each direction splices from its source socket into a pipe and
+     *  from the pipe to its destination socket, so the data never
+     *  passes through user space.  When a destination can't keep up,
+     *  its pipe fills and the proxy stops reading the source until
+     *  the destination is writable again, so the source's sender is
+     *  slowed down by TCP flow control.  The end of file of a source
+     *  is forwarded as a shutdown of the destination's sending side
+     *  once the pipe is drained.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class socket_proxy final
+    {
+        public:
+
+        /** Called once when the proxy is done and detached from its ioloop
+         *
+         *  The proxy may be destroyed from the handler.
+         *
+         *  @param errno_value 0 if both directions reached the end of
+         *                     file, otherwise the error that stopped
+         *                     the proxy
+         */
+        using done_handler = std::function<void (int errno_value)>;
+
+        /** Constructs a socket_proxy object and makes the sockets non-blocking
+         *
+         *  @param first A connected socket
+         *  @param second A connected socket
+         *  @param pipe_size The capacity of each direction's pipe, 0
+         *                   keeps the default of 64 KiB
+         *
+         *  @throws ndgpp::error<std::system_error> if a pipe can't be
+         *          created or sized
+         */
+        socket_proxy(linuxpp::net::tcp_socket && first,
+                     linuxpp::net::tcp_socket && second,
+                     const std::size_t pipe_size = 0);
+
+        ~socket_proxy();
+
+        socket_proxy(const socket_proxy &) = delete;
+        socket_proxy & operator= (const socket_proxy &) = delete;
+
+        socket_proxy(socket_proxy &&) = delete;
+        socket_proxy & operator= (socket_proxy &&) = delete;
+
+        /** Registers both sockets with an ioloop and starts forwarding
+         *
+         *  @param loop The ioloop to forward from
+         *  @param handler Called when the proxy is done
+         *
+         *  @throws std::logic_error if the proxy is already attached
+         *          to an ioloop
+         */
+        void attach(linuxpp::ioloop & loop, done_handler handler);
+
+        /// Removes the sockets from the ioloop they're attached to
+        void detach();
+
+        /// Returns true if both directions are finished or an error occurred
+        bool done() const noexcept;
+
+        /// Returns the error that stopped the proxy, or 0
+        int error() const noexcept;
+
+        /// Returns the number of bytes forwarded from the first socket to the second
+        std::uint64_t first_to_second() const noexcept;
+
+        /// Returns the number of bytes forwarded from the second socket to the first
+        std::uint64_t second_to_first() const noexcept;
+
+        const linuxpp::net::tcp_socket & first() const noexcept;
+        const linuxpp::net::tcp_socket & second() const noexcept;
+
+        private:
+
+        struct direction
+        {
+            int source;
+            int destination;
+            linuxpp::pipe pipe;
+            std::size_t capacity;
+
+            // Bytes in the pipe
+            std::size_t buffered = 0;
+
+            // Set when a splice into a non-empty pipe can't make
+            // progress, which is either an empty source or a full
+            // pipe, and cleared once the pipe drains a bit
+            bool blocked = false;
+
+            bool eof = false;
+            bool shut_down = false;
+            std::uint64_t forwarded = 0;
+
+            bool wants_read() const noexcept;
+            bool wants_write() const noexcept;
+            bool finished() const noexcept;
+        };
+
+        /// Moves as much data as possible in one direction, returns 0 or an errno value
+        int pump(direction & dir);
+
+        void handle_events(const int sd, const uint32_t events);
+        void update_events();
+
+        linuxpp::net::tcp_socket first_;
+        linuxpp::net::tcp_socket second_;
+        direction first_to_second_;
+        direction second_to_first_;
+
+        int error_ = 0;
+        uint32_t first_events_ = 0;
+        uint32_t second_events_ = 0;
+
+        // A hung up socket reports events until it's closed
+        bool first_hung_up_ = false;
+        bool second_hung_up_ = false;
+
+        linuxpp::ioloop * loop_ = nullptr;
+        done_handler handler_;
+    };
+}
+}
+
+#endif
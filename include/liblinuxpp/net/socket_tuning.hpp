@@ -0,0 +1,177 @@
+#ifndef LIBLINUXPP_NET_SOCKET_TUNING_HPP
+#define LIBLINUXPP_NET_SOCKET_TUNING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <chrono>
+
+#include <liblinuxpp/tuning_status.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /// The outcome of applying a socket_tuning object
+    struct socket_tuning_result
+    {
+        linuxpp::tuning_status receive_buffer;
+        linuxpp::tuning_status send_buffer;
+        linuxpp::tuning_status receive_low_watermark;
+        linuxpp::tuning_status busy_poll;
+        linuxpp::tuning_status prefer_busy_poll;
+        linuxpp::tuning_status incoming_cpu;
+        linuxpp::tuning_status zerocopy;
+        linuxpp::tuning_status max_pacing_rate;
+        linuxpp::tuning_status tos;
+        linuxpp::tuning_status priority;
+        linuxpp::tuning_status tcp_nodelay;
+        linuxpp::tuning_status tcp_quickack;
+        linuxpp::tuning_status tcp_cork;
+        linuxpp::tuning_status tcp_notsent_lowat;
+        linuxpp::tuning_status tcp_defer_accept;
+        linuxpp::tuning_status tcp_fastopen;
+
+        /// Returns true if every requested setting was applied
+        bool
+        all_applied() const noexcept;
+    };
+
+    /** A set of socket options to apply to a socket in one call
+     *
+     *  Only the settings that are set are applied, in the order they
+     *  are declared in socket_tuning_result.  A profile is typically
+     *  built once and applied to every socket of a kind.  Many of
+     *  these options are capped by sysctls or require CAP_NET_ADMIN,
+     *  and the kernel silently adjusts some of them, so
+     *  linuxpp::net::socket_tuning::apply reads each option back and
+     *  reports what actually took effect instead of throwing.
+     */
+    class socket_tuning
+    {
+        public:
+
+        /** Sets the receive buffer size via SO_RCVBUF
+         *
+         *  @param size The buffer size before the kernel doubles it
+         *  @param force Uses SO_RCVBUFFORCE, which ignores
+         *               net.core.rmem_max but requires CAP_NET_ADMIN
+         */
+        void
+        set_receive_buffer(const std::size_t size,
+                           const bool force = false);
+
+        /** Sets the send buffer size via SO_SNDBUF
+         *
+         *  @param size The buffer size before the kernel doubles it
+         *  @param force Uses SO_SNDBUFFORCE, which ignores
+         *               net.core.wmem_max but requires CAP_NET_ADMIN
+         */
+        void
+        set_send_buffer(const std::size_t size,
+                        const bool force = false);
+
+        /// Sets the number of bytes that must be queued before the socket is readable
+        void
+        set_receive_low_watermark(const std::size_t size);
+
+        /// Sets how long a blocking receive busy polls the device queue
+        void
+        set_busy_poll(const std::chrono::microseconds duration);
+
+        /// Sets whether busy polling defers the device's interrupts
+        void
+        set_prefer_busy_poll(const bool enable);
+
+        /// Sets the CPU expected to process the socket's packets
+        void
+        set_incoming_cpu(const int cpu);
+
+        /// Sets whether MSG_ZEROCOPY sends are allowed
+        void
+        set_zerocopy(const bool enable);
+
+        /// Sets the maximum pacing rate in bytes per second
+        void
+        set_max_pacing_rate(const std::uint64_t bytes_per_second);
+
+        /// Sets the IP TOS byte, which also sets the priority
+        void
+        set_tos(const int tos);
+
+        /// Sets the queueing priority of the socket's packets, overriding the TOS derived priority
+        void
+        set_priority(const int priority);
+
+        /// Sets whether Nagle's algorithm is disabled
+        void
+        set_tcp_nodelay(const bool enable);
+
+        /** Enters quick ACK mode
+         *
+         *  The kernel leaves quick ACK mode on its own, so the
+         *  setting isn't read back
+         */
+        void
+        set_tcp_quickack(const bool enable);
+
+        /// Sets whether partial frames are held back
+        void
+        set_tcp_cork(const bool enable);
+
+        /// Sets the number of unsent bytes above which the socket isn't writable
+        void
+        set_tcp_notsent_lowat(const std::size_t size);
+
+        /** Sets how long a listener waits for data before a connection is accepted
+         *
+         *  The kernel rounds the duration up to a retransmission count
+         */
+        void
+        set_tcp_defer_accept(const std::chrono::seconds duration);
+
+        /// Sets a listener's queue length of pending TCP fast open requests
+        void
+        set_tcp_fastopen(const int queue_length);
+
+        /** Applies the settings to a socket
+         *
+         *  @param sd The socket descriptor to tune
+         *
+         *  @return The outcome of each setting
+         */
+        linuxpp::net::socket_tuning_result
+        apply(const int sd) const;
+
+        private:
+
+        template <class T>
+        struct setting
+        {
+            bool requested = false;
+            T value {};
+        };
+
+        bool receive_buffer_force_ = false;
+        setting<int> receive_buffer_;
+        bool send_buffer_force_ = false;
+        setting<int> send_buffer_;
+        setting<int> receive_low_watermark_;
+        setting<int> busy_poll_;
+        setting<int> prefer_busy_poll_;
+        setting<int> incoming_cpu_;
+        setting<int> zerocopy_;
+        setting<std::uint64_t> max_pacing_rate_;
+        setting<int> tos_;
+        setting<int> priority_;
+        setting<int> tcp_nodelay_;
+        setting<int> tcp_quickack_;
+        setting<int> tcp_cork_;
+        setting<int> tcp_notsent_lowat_;
+        setting<int> tcp_defer_accept_;
+        setting<int> tcp_fastopen_;
+    };
+}
+}
+
+#endif
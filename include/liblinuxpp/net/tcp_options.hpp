@@ -27,6 +27,54 @@ namespace so {
     struct tcp_nodelay {};
     template <>
     struct traits<tcp_nodelay> : public tcp_nodelay_t {};
+
+    template <int Name>
+    struct tcp_int_trait: public tcp_trait<Name>
+    {
+        using value_type = int;
+    };
+
+    /** TCP_QUICKACK socket option
+     *
+     *  Not permanent, the kernel leaves quick ACK mode on its own
+     */
+    struct tcp_quickack {};
+    template <>
+    struct traits<tcp_quickack> : public tcp_int_trait<TCP_QUICKACK> {};
+
+    /// TCP_CORK socket option, holds back partial frames until the option is cleared
+    struct tcp_cork {};
+    template <>
+    struct traits<tcp_cork> : public tcp_int_trait<TCP_CORK> {};
+
+    /// TCP_NOTSENT_LOWAT socket option, the number of unsent bytes above which the socket isn't writable
+    struct tcp_notsent_lowat {};
+    template <>
+    struct traits<tcp_notsent_lowat> : public tcp_int_trait<TCP_NOTSENT_LOWAT> {};
+
+    /** TCP_DEFER_ACCEPT socket option
+     *
+     *  The number of seconds a listener waits for data before a
+     *  connection is accepted, the kernel rounds it up to a
+     *  retransmission count
+     */
+    struct tcp_defer_accept {};
+    template <>
+    struct traits<tcp_defer_accept> : public tcp_int_trait<TCP_DEFER_ACCEPT> {};
+
+    /// TCP_FASTOPEN socket option, a listener's queue length of pending fast open requests
+    struct tcp_fastopen {};
+    template <>
+    struct traits<tcp_fastopen> : public tcp_int_trait<TCP_FASTOPEN> {};
+
+    /** TCP_FASTOPEN_CONNECT socket option
+     *
+     *  connect returns right away and the first send carries its
+     *  data in the SYN when a fast open cookie is cached
+     */
+    struct tcp_fastopen_connect {};
+    template <>
+    struct traits<tcp_fastopen_connect> : public tcp_int_trait<TCP_FASTOPEN_CONNECT> {};
 }}}
 
 #endif
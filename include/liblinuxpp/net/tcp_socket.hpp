@@ -6,7 +6,9 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <time.h>
 
+#include <new>
 #include <tuple>
 #include <utility>
 
@@ -15,6 +17,7 @@
 #include <libndgpp/net/ipv4_address.hpp>
 #include <libndgpp/net/port.hpp>
 
+#include <liblinuxpp/syscall_return.hpp>
 #include <liblinuxpp/unique_fd.hpp>
 
 namespace linuxpp
@@ -154,6 +157,28 @@ namespace net
         std::size_t recv(void * buf, std::size_t buflen, const int flags = 0);
 
 
+        /** Enables or disables kernel receive timestamps (SO_TIMESTAMPNS)
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        void set_timestamps(const bool enable);
+
+        /** Receives data and its kernel receive timestamp
+         *
+         *  @param buf The buffer to place the data into
+         *  @param buflen The length of the buf parameter
+         *  @param timestamp The CLOCK_REALTIME time the kernel received
+         *                   the last segment of data, zero if timestamps aren't enabled
+         *  @param flags The flags to pass to recvmsg
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        std::size_t recv(void * buf,
+                         const std::size_t buflen,
+                         struct ::timespec & timestamp,
+                         const int flags = 0);
+
+
         // struct iovec based recv functions
 
         /** Calls recvmsg
@@ -188,6 +213,121 @@ namespace net
                          const std::size_t size_buffers,
                          const int flags = 0);
 
+        // TCP Fast Open functions
+        //
+        // Fast open carries the first data of a connection in the
+        // SYN, saving a round trip, once the client holds a cookie
+        // from an earlier connection to the server.  Without a
+        // cookie the SYN requests one and the data is sent after the
+        // handshake.  Requires the net.ipv4.tcp_fastopen sysctl to
+        // enable the client (1) and server (2) sides.
+
+        /** Enables fast open on a listening socket
+         *
+         *  @param queue_length The maximum number of connections
+         *                      whose handshake hasn't completed that
+         *                      may have data in their SYN
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        void set_fastopen(const int queue_length);
+
+        /** Enables or disables fast open for connect (TCP_FASTOPEN_CONNECT)
+         *
+         *  With fast open enabled, connect returns without waiting
+         *  for the handshake and the first send carries its data in
+         *  the SYN.
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        void set_fastopen_connect(const bool enable);
+
+        /** Connects the socket and sends data in the SYN (MSG_FASTOPEN)
+         *
+         *  @param buf The buffer of data to send
+         *  @param length The length of the buffer
+         *  @param addr The address to connect to
+         *  @param port The port to connect to
+         *  @param flags The flags to pass to sendto in addition to MSG_FASTOPEN
+         *
+         *  @return The number of bytes sent
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        std::size_t send_fastopen(void const * buf,
+                                  const std::size_t length,
+                                  const ndgpp::net::ipv4_address addr,
+                                  const ndgpp::net::port port,
+                                  const int flags = 0);
+
+        /** Returns true if the connection's SYN carried data the peer accepted
+         *
+         *  On a client, the server accepted the fast open cookie and
+         *  acknowledged the data sent with the SYN.  On a connection
+         *  accepted by a server, the client's SYN carried data.  Reads
+         *  TCPI_OPT_SYN_DATA from TCP_INFO.
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        bool fastopen_accepted() const;
+
+        // non-throwing functions
+        //
+        // These report errors, including EAGAIN and EINPROGRESS on a
+        // non-blocking socket, in the returned syscall_return instead
+        // of throwing.
+
+        /// Connects the socket to the provided address
+        linuxpp::syscall_return<int> connect(std::nothrow_t,
+                                             const ndgpp::net::ipv4_address addr,
+                                             const ndgpp::net::port port) noexcept;
+
+        /// Accepts a client connection
+        linuxpp::syscall_return<int> accept(std::nothrow_t,
+                                            const int flags = 0) noexcept;
+
+        /// Accepts a client connection and returns the client's address
+        linuxpp::syscall_return<int> accept(std::nothrow_t,
+                                            ndgpp::net::ipv4_address & addr,
+                                            ndgpp::net::port & port,
+                                            const int flags = 0) noexcept;
+
+        /// Receives data
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                void * buf,
+                                                const std::size_t buflen,
+                                                const int flags = 0) noexcept;
+
+        /// Calls recvmsg
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                struct ::iovec * const buffs,
+                                                const std::size_t size_buffs,
+                                                const int flags = 0) noexcept;
+
+        /// Sends data
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                void const * buf,
+                                                const std::size_t length,
+                                                const int flags = 0) noexcept;
+
+        /// Calls sendmsg
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                struct ::iovec const * const buffers,
+                                                const std::size_t size_buffers,
+                                                const int flags = 0) noexcept;
+
+        /** Connects the socket and sends data in the SYN (MSG_FASTOPEN)
+         *
+         *  A non-blocking socket reports EINPROGRESS when the data
+         *  couldn't be sent in the SYN, e.g. without a cookie.
+         */
+        linuxpp::syscall_return<::ssize_t> send_fastopen(std::nothrow_t,
+                                                         void const * buf,
+                                                         const std::size_t length,
+                                                         const ndgpp::net::ipv4_address addr,
+                                                         const ndgpp::net::port port,
+                                                         const int flags = 0) noexcept;
+
         private:
 
         enum members
@@ -0,0 +1,46 @@
+#ifndef LIBLINUXPP_NET_UDP_OPTIONS_HPP
+#define LIBLINUXPP_NET_UDP_OPTIONS_HPP
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#include <liblinuxpp/net/sockopt_traits.hpp>
+
+namespace linuxpp {
+namespace net {
+namespace so {
+
+    template <int Name>
+    struct udp_trait
+    {
+        static constexpr int level() noexcept { return IPPROTO_UDP; };
+        static constexpr int name = Name;
+    };
+
+    /** UDP_SEGMENT socket option
+     *
+     *  The segment size used to split every datagram sent on the
+     *  socket, 0 disables segmentation
+     */
+    struct udp_segment_t: public udp_trait<UDP_SEGMENT>
+    {
+        using value_type = int;
+    };
+
+    struct udp_segment {};
+    template <>
+    struct traits<udp_segment> : public udp_segment_t {};
+
+    /// UDP_GRO socket option
+    struct udp_gro_t: public udp_trait<UDP_GRO>
+    {
+        using value_type = int;
+    };
+
+    struct udp_gro {};
+    template <>
+    struct traits<udp_gro> : public udp_gro_t {};
+}}}
+
+#endif
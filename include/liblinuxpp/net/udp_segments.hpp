@@ -0,0 +1,185 @@
+#ifndef LIBLINUXPP_NET_UDP_SEGMENTS_HPP
+#define LIBLINUXPP_NET_UDP_SEGMENTS_HPP
+
+#include <cstddef>
+
+#include <iterator>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** A received datagram that may hold several coalesced UDP segments
+     *
+     *  With UDP_GRO enabled the kernel may deliver several datagrams
+     *  from the same flow as one buffer of equal sized segments,
+     *  where only the last segment may be shorter.  Iterating a
+     *  udp_segments object yields each of the original datagrams.
+     *
+     *  @par Copy Semantics Copyable, refers to a buffer it does not own
+     */
+    class udp_segments final
+    {
+        public:
+
+        /// A single datagram within the received buffer
+        struct segment
+        {
+            void const * data;
+            std::size_t size;
+        };
+
+        class const_iterator
+        {
+            public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = segment;
+            using difference_type = std::ptrdiff_t;
+            using pointer = segment const *;
+            using reference = segment;
+
+            const_iterator() = default;
+
+            segment operator* () const noexcept;
+
+            const_iterator & operator++ () noexcept;
+            const_iterator operator++ (int) noexcept;
+
+            bool operator== (const const_iterator & rhs) const noexcept;
+            bool operator!= (const const_iterator & rhs) const noexcept;
+
+            private:
+
+            friend class udp_segments;
+
+            const_iterator(unsigned char const * const position,
+                           unsigned char const * const end,
+                           const std::size_t segment_size) noexcept;
+
+            unsigned char const * position_ = nullptr;
+            unsigned char const * end_ = nullptr;
+            std::size_t segment_size_ = 0;
+        };
+
+        udp_segments() = default;
+
+        /** Constructs a udp_segments object
+         *
+         *  @param data The received buffer
+         *  @param length The number of bytes received
+         *  @param segment_size The segment size reported by the
+         *                      UDP_GRO control message, 0 if the
+         *                      buffer holds a single datagram
+         */
+        udp_segments(void const * const data,
+                     const std::size_t length,
+                     const std::size_t segment_size) noexcept;
+
+        /// Returns the received buffer
+        void const * data() const noexcept;
+
+        /// Returns the number of bytes received
+        std::size_t length() const noexcept;
+
+        /// Returns the size of every segment but the last
+        std::size_t segment_size() const noexcept;
+
+        /// Returns the number of segments
+        std::size_t count() const noexcept;
+
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+
+        private:
+
+        unsigned char const * data_ = nullptr;
+        std::size_t length_ = 0;
+        std::size_t segment_size_ = 0;
+    };
+
+    inline udp_segments::const_iterator::const_iterator(unsigned char const * const position,
+                                                        unsigned char const * const end,
+                                                        const std::size_t segment_size) noexcept:
+        position_(position),
+        end_(end),
+        segment_size_(segment_size)
+    {}
+
+    inline udp_segments::segment udp_segments::const_iterator::operator* () const noexcept
+    {
+        const std::size_t remaining = static_cast<std::size_t>(this->end_ - this->position_);
+        return segment {this->position_, remaining < this->segment_size_ ? remaining : this->segment_size_};
+    }
+
+    inline udp_segments::const_iterator & udp_segments::const_iterator::operator++ () noexcept
+    {
+        const std::size_t remaining = static_cast<std::size_t>(this->end_ - this->position_);
+        this->position_ += remaining < this->segment_size_ ? remaining : this->segment_size_;
+        return *this;
+    }
+
+    inline udp_segments::const_iterator udp_segments::const_iterator::operator++ (int) noexcept
+    {
+        const_iterator ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    inline bool udp_segments::const_iterator::operator== (const const_iterator & rhs) const noexcept
+    {
+        return this->position_ == rhs.position_;
+    }
+
+    inline bool udp_segments::const_iterator::operator!= (const const_iterator & rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    inline udp_segments::udp_segments(void const * const data,
+                                      const std::size_t length,
+                                      const std::size_t segment_size) noexcept:
+        data_(static_cast<unsigned char const *>(data)),
+        length_(length),
+        segment_size_(segment_size == 0 || segment_size > length ? length : segment_size)
+    {}
+
+    inline void const * udp_segments::data() const noexcept
+    {
+        return this->data_;
+    }
+
+    inline std::size_t udp_segments::length() const noexcept
+    {
+        return this->length_;
+    }
+
+    inline std::size_t udp_segments::segment_size() const noexcept
+    {
+        return this->segment_size_;
+    }
+
+    inline std::size_t udp_segments::count() const noexcept
+    {
+        if (this->length_ == 0)
+        {
+            return 0;
+        }
+
+        return (this->length_ + this->segment_size_ - 1) / this->segment_size_;
+    }
+
+    inline udp_segments::const_iterator udp_segments::begin() const noexcept
+    {
+        return const_iterator {this->data_, this->data_ + this->length_, this->segment_size_};
+    }
+
+    inline udp_segments::const_iterator udp_segments::end() const noexcept
+    {
+        const auto end = this->data_ + this->length_;
+        return const_iterator {end, end, this->segment_size_};
+    }
+}
+}
+
+#endif
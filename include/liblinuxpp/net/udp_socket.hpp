@@ -5,7 +5,12 @@
 #include <netinet/udp.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
+#include <time.h>
 
+#include <cstdint>
+
+#include <chrono>
+#include <new>
 #include <tuple>
 #include <utility>
 
@@ -13,7 +18,11 @@
 #include <libndgpp/net/multicast_ipv4_address.hpp>
 #include <libndgpp/net/port.hpp>
 
+#include <liblinuxpp/net/bpf.hpp>
+#include <liblinuxpp/net/message_batch.hpp>
 #include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/udp_segments.hpp>
+#include <liblinuxpp/syscall_return.hpp>
 #include <liblinuxpp/unique_fd.hpp>
 
 namespace linuxpp
@@ -154,6 +163,42 @@ namespace net
                          const int flags = 0);
 
 
+        /** Enables or disables kernel receive timestamps (SO_TIMESTAMPNS)
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        void set_timestamps(const bool enable);
+
+        /** Receives a datagram and its kernel receive timestamp
+         *
+         *  @param buf The buffer to place the datagram into
+         *  @param buflen The length of the buf parameter
+         *  @param timestamp The CLOCK_REALTIME time the kernel received
+         *                   the datagram, zero if timestamps aren't enabled
+         *  @param flags The flags to pass to recvmsg
+         *
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        std::size_t recv(void * buf,
+                         const std::size_t buflen,
+                         struct ::timespec & timestamp,
+                         const int flags = 0);
+
+        /** Receives a datagram, its source, and its kernel receive timestamp
+         *
+         *  @param buf The buffer to place the datagram into
+         *  @param buflen The length of the buf parameter
+         *  @param sockaddr The sockaddr_in struct to place the sender information
+         *  @param timestamp The time the kernel received the datagram
+         *  @param flags The flags to pass to recvmsg
+         */
+        std::size_t recv(void * buf,
+                         const std::size_t buflen,
+                         struct ::sockaddr_in & sockaddr,
+                         struct ::timespec & timestamp,
+                         const int flags = 0);
+
+
         // struct iovec based recv functions
 
         /** Calls recvmsg
@@ -247,6 +292,263 @@ namespace net
                          const struct ::sockaddr_in sockaddr,
                          const int flags = 0);
 
+
+
+        // batch send and receive functions
+
+        /** Calls recvmmsg
+         *
+         *  Each received message's length, source address, and flags
+         *  are available from the batch.
+         *
+         *  @param batch The batch to receive into, reset with
+         *               message_batch::prepare_recv before receiving
+         *
+         *  @param flags The flags to pass to recvmmsg.  With
+         *               MSG_WAITFORONE the call blocks until one
+         *               datagram is available and then returns as
+         *               many as are queued, up to the batch size.
+         *
+         *  @return The number of messages received
+         */
+        std::size_t recv(linuxpp::net::message_batch & batch,
+                         const int flags = 0);
+
+        /** Calls recvmmsg with a timeout
+         *
+         *  @param batch The batch to receive into
+         *  @param flags The flags to pass to recvmmsg
+         *
+         *  @param timeout The time limit for filling the batch.  The
+         *                 kernel only checks the timeout after each
+         *                 datagram, so combine it with MSG_WAITFORONE
+         *                 or a non-blocking socket to avoid blocking
+         *                 indefinitely.
+         */
+        std::size_t recv(linuxpp::net::message_batch & batch,
+                         const int flags,
+                         const std::chrono::nanoseconds timeout);
+
+        /** Calls recvmmsg
+         *
+         *  @param msgs The mmsghdr array to receive into
+         *  @param size_msgs The number of instances in the mmsghdr array
+         *  @param flags The flags to pass to recvmmsg
+         */
+        std::size_t recv(struct ::mmsghdr * const msgs,
+                         const std::size_t size_msgs,
+                         const int flags = 0);
+
+        /** Calls sendmmsg
+         *
+         *  @param batch The batch of messages to send.  Each
+         *               message's length and destination are set with
+         *               message_batch::set_length and
+         *               message_batch::set_address.
+         *
+         *  @param count The number of messages from the start of the
+         *               batch to send
+         *
+         *  @param flags The flags to pass to sendmmsg
+         *
+         *  @return The number of messages sent, which may be less than count
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if count is
+         *          greater than the batch size
+         */
+        std::size_t send(linuxpp::net::message_batch & batch,
+                         const std::size_t count,
+                         const int flags = 0);
+
+        /** Calls sendmmsg
+         *
+         *  @param msgs The mmsghdr array to send
+         *  @param size_msgs The number of instances in the mmsghdr array
+         *  @param flags The flags to pass to sendmmsg
+         */
+        std::size_t send(struct ::mmsghdr * const msgs,
+                         const std::size_t size_msgs,
+                         const int flags = 0);
+
+
+
+        // UDP segmentation offload functions
+
+        /** Sends a buffer as a series of equal sized datagrams
+         *
+         *  The kernel splits the buffer into segment_size datagrams
+         *  (UDP_SEGMENT), where only the last may be shorter, at the
+         *  cost of a single system call and a single pass through the
+         *  network stack.
+         *
+         *  @param buf The buffer of data to send
+         *  @param length The length of the buffer.  The kernel limits
+         *                a buffer to 64 segments and 64KiB.
+         *  @param segment_size The size of each datagram
+         *  @param sockaddr The sockaddr containing the destination info
+         *  @param flags The flags to pass to sendmsg
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if segment_size is 0
+         *  @throws ndgpp::error<std::system_error> when an error is encountered
+         */
+        std::size_t send_segments(void const * buf,
+                                  const std::size_t length,
+                                  const std::uint16_t segment_size,
+                                  const struct ::sockaddr_in sockaddr,
+                                  const int flags = 0);
+
+        /// @copydoc send_segments
+        std::size_t send_segments(void const * buf,
+                                  const std::size_t length,
+                                  const std::uint16_t segment_size,
+                                  const ndgpp::net::ipv4_address addr,
+                                  const ndgpp::net::port port,
+                                  const int flags = 0);
+
+        /** Enables or disables receiving coalesced datagrams (UDP_GRO)
+         *
+         *  @throws ndgpp::error<std::system_error> if the kernel does
+         *          not support UDP_GRO
+         */
+        void set_gro(const bool enable);
+
+        /** Receives a datagram that may hold several coalesced segments
+         *
+         *  @param buf The buffer to place the datagram into.  With
+         *             UDP_GRO enabled it should be 64KiB so a
+         *             coalesced datagram isn't truncated.
+         *  @param buflen The length of the buf parameter
+         *  @param flags The flags to pass to recvmsg
+         *
+         *  @return The received segments, which refer to buf
+         */
+        linuxpp::net::udp_segments recv_segments(void * buf,
+                                                 const std::size_t buflen,
+                                                 const int flags = 0);
+
+        /** Receives a datagram that may hold several coalesced segments
+         *
+         *  @param buf The buffer to place the datagram into
+         *  @param buflen The length of the buf parameter
+         *  @param sockaddr The sockaddr_in struct to place the sender information
+         *  @param flags The flags to pass to recvmsg
+         */
+        linuxpp::net::udp_segments recv_segments(void * buf,
+                                                 const std::size_t buflen,
+                                                 struct ::sockaddr_in & sockaddr,
+                                                 const int flags = 0);
+
+        // socket filter functions
+
+        /** Attaches a classic BPF filter to the socket (SO_ATTACH_FILTER)
+         *
+         *  Datagrams the filter drops are discarded by the kernel
+         *  before they're queued, so they never wake a reader or get
+         *  copied to user space.  The filter sees each datagram from
+         *  its UDP header, see linuxpp::net::bpf::udp_payload_offset.
+         *
+         *  @throws ndgpp::error<std::system_error> if the program is
+         *          rejected, or the socket's filter is locked
+         */
+        void attach_filter(const linuxpp::net::bpf::program & program);
+
+        /// Removes the socket's filter
+        void detach_filter();
+
+        // non-throwing send and receive functions
+        //
+        // These report errors, including EAGAIN on a non-blocking
+        // socket, in the returned syscall_return instead of throwing,
+        // which is cheaper in a loop that drains the socket until
+        // EAGAIN.
+
+        /// Receives a datagram
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                void * buf,
+                                                const std::size_t buflen,
+                                                const int flags = 0) noexcept;
+
+        /// Receives a datagram and its sender's address
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                void * buf,
+                                                const std::size_t buflen,
+                                                struct ::sockaddr_in & sockaddr,
+                                                const int flags = 0) noexcept;
+
+        /// Receives a datagram and its sender's address
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                void * buf,
+                                                const std::size_t buflen,
+                                                ndgpp::net::ipv4_address & addr,
+                                                ndgpp::net::port & port,
+                                                const int flags = 0) noexcept;
+
+        /// Receives a datagram into a set of buffers
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                struct ::iovec * const buffs,
+                                                const std::size_t size_buffs,
+                                                const int flags = 0) noexcept;
+
+        /// Receives a datagram into a set of buffers and its sender's address
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                struct ::iovec * const buffs,
+                                                const std::size_t size_buffs,
+                                                struct ::sockaddr_in & sockaddr,
+                                                const int flags = 0) noexcept;
+
+        /// Receives up to batch.size() datagrams
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                linuxpp::net::message_batch & batch,
+                                                const int flags = 0) noexcept;
+
+        /// Calls recvmmsg
+        linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                                struct ::mmsghdr * const msgs,
+                                                const std::size_t size_msgs,
+                                                const int flags = 0) noexcept;
+
+        /// Sends a datagram
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                void const * buf,
+                                                const std::size_t length,
+                                                const ndgpp::net::ipv4_address addr,
+                                                const ndgpp::net::port port,
+                                                const int flags = 0) noexcept;
+
+        /// Sends a datagram
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                void const * buf,
+                                                const std::size_t length,
+                                                const struct ::sockaddr_in sockaddr,
+                                                const int flags = 0) noexcept;
+
+        /// Sends a datagram from a set of buffers
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                struct ::iovec const * const buffers,
+                                                const std::size_t size_buffers,
+                                                const ndgpp::net::ipv4_address addr,
+                                                const ndgpp::net::port port,
+                                                const int flags = 0) noexcept;
+
+        /// Sends a datagram from a set of buffers
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                struct ::iovec const * const buffers,
+                                                const std::size_t size_buffers,
+                                                const struct ::sockaddr_in sockaddr,
+                                                const int flags = 0) noexcept;
+
+        /// Sends the first count messages of a batch, EINVAL if count exceeds batch.size()
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                linuxpp::net::message_batch & batch,
+                                                const std::size_t count,
+                                                const int flags = 0) noexcept;
+
+        /// Calls sendmmsg
+        linuxpp::syscall_return<::ssize_t> send(std::nothrow_t,
+                                                struct ::mmsghdr * const msgs,
+                                                const std::size_t size_msgs,
+                                                const int flags = 0) noexcept;
+
         /// Returns true if the underlying socket is valid
         explicit operator bool() const noexcept;
 
@@ -0,0 +1,167 @@
+#ifndef LIBLINUXPP_NET_ZEROCOPY_SENDER_HPP
+#define LIBLINUXPP_NET_ZEROCOPY_SENDER_HPP
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <deque>
+#include <functional>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/syscall_return.hpp>
+
+namespace linuxpp
+{
+namespace net
+{
+    /** Sends from user buffers with MSG_ZEROCOPY
+     *
+     *  A zero-copy send pins the buffer's pages instead of copying
+     *  them into the kernel, so the buffer must not be modified or
+     *  freed until its completion handler is called.  Completions
+     *  are read from the socket's error queue, which makes the socket
+     *  report an error event, by process_completions.  Sends smaller
+     *  than the threshold are copied, because pinning pages and
+     *  reading the completion costs more than copying a small
+     *  buffer, and their handler is called before send returns.
+     *
+     *  The kernel copies anyway when the data can't be sent straight
+     *  from the pages, e.g. over loopback or to a device without
+     *  scatter-gather, and reports it through the handler's copied
+     *  argument.
+     *
+     *  The socket descriptor isn't owned and must outlive the
+     *  zerocopy_sender.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class zerocopy_sender final
+    {
+        public:
+
+        /** Called when the kernel is done with a send's buffer
+         *
+         *  @param copied True if the data was copied instead of sent
+         *                from the buffer's pages
+         */
+        using completion_handler = std::function<void (bool copied)>;
+
+        /// The default threshold, below which zero-copy doesn't pay off
+        static constexpr std::size_t default_threshold = 16384;
+
+        /** Constructs a zerocopy_sender object and enables SO_ZEROCOPY on the socket
+         *
+         *  @param sd A TCP or UDP socket descriptor
+         *  @param threshold The size below which sends are copied
+         *
+         *  @throws ndgpp::error<std::system_error> if the socket
+         *          doesn't support SO_ZEROCOPY
+         */
+        explicit
+        zerocopy_sender(const int sd,
+                        const std::size_t threshold = default_threshold);
+
+        ~zerocopy_sender();
+
+        zerocopy_sender(const zerocopy_sender &) = delete;
+        zerocopy_sender & operator= (const zerocopy_sender &) = delete;
+
+        zerocopy_sender(zerocopy_sender &&) = delete;
+        zerocopy_sender & operator= (zerocopy_sender &&) = delete;
+
+        /** Sends a buffer
+         *
+         *  Errors, including EAGAIN, are returned instead of thrown,
+         *  and handler is only called for a successful send.  A TCP
+         *  send may be partial, in which case handler covers the
+         *  bytes that were sent, and the rest must be sent with
+         *  another call.
+         *
+         *  @param buf The data to send
+         *  @param length The number of bytes to send
+         *  @param handler Called when the kernel is done with buf
+         *  @param flags The send flags, MSG_ZEROCOPY is added when
+         *               length reaches the threshold
+         *
+         *  @throws std::bad_alloc if the handler can't be queued
+         */
+        linuxpp::syscall_return<::ssize_t> send(void const * const buf,
+                                                const std::size_t length,
+                                                completion_handler handler,
+                                                const int flags = 0);
+
+        /** Sends a message, e.g. to a UDP destination or from several buffers
+         *
+         *  @see send(void const *, std::size_t, completion_handler, int)
+         */
+        linuxpp::syscall_return<::ssize_t> send(const struct ::msghdr & msg,
+                                                completion_handler handler,
+                                                const int flags = 0);
+
+        /** Reads the socket's error queue and calls the completed sends' handlers
+         *
+         *  @return The number of sends that completed
+         *
+         *  @throws ndgpp::error<std::system_error> when an error other
+         *          than EAGAIN is encountered
+         */
+        std::size_t process_completions();
+
+        /// Returns the number of zero-copy sends whose completion hasn't been read
+        std::size_t pending() const noexcept;
+
+        /// Returns the size below which sends are copied
+        std::size_t threshold() const noexcept;
+
+        /** Registers the socket's error events with an ioloop, which calls process_completions
+         *
+         *  A socket that has its own ioloop handler should call
+         *  process_completions from it when an error event is
+         *  reported instead, because an ioloop has one handler per
+         *  file descriptor.  A pending socket error is also reported
+         *  as an error event and has to be handled by the socket's
+         *  owner.
+         */
+        void attach(linuxpp::ioloop & loop);
+
+        /// Removes the socket from the ioloop it's attached to
+        void detach();
+
+        /// Returns the socket descriptor
+        int descriptor() const noexcept;
+
+        private:
+
+        struct pending_send
+        {
+            completion_handler handler;
+            bool done = false;
+        };
+
+        linuxpp::syscall_return<::ssize_t> send_msg(const struct ::msghdr & msg,
+                                                    const std::size_t length,
+                                                    completion_handler & handler,
+                                                    const int flags);
+
+        std::size_t complete(const std::uint32_t first,
+                             const std::uint32_t last,
+                             const bool copied);
+
+        int sd_;
+        std::size_t threshold_;
+
+        // The handlers of the zero-copy sends in send order, the
+        // front's completion id is front_id_
+        std::deque<pending_send> pending_;
+        std::uint32_t front_id_ = 0;
+        std::size_t pending_count_ = 0;
+
+        linuxpp::ioloop * loop_ = nullptr;
+    };
+}
+}
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef LIBLINUXPP_NOTIFIER_HPP
+#define LIBLINUXPP_NOTIFIER_HPP
+
+#include <cstdint>
+
+#include <atomic>
+
+#include <liblinuxpp/eventfd.hpp>
+
+namespace linuxpp
+{
+    /** An eventfd that's only written to when a consumer is waiting
+     *
+     *  Consumers declare that they're about to block with
+     *  prepare_wait, re-check their wake up condition, and then
+     *  block, e.g. with wait or in epoll_wait on fd.  Producers
+     *  change the condition and call notify, which only makes a
+     *  system call when a consumer has declared that it's waiting,
+     *  and, outside of semaphore mode, no earlier notification is
+     *  still waiting to be consumed.
+     *
+     *  The consumer protocol is:
+     *
+     *  @code
+     *  notifier.prepare_wait();
+     *  if (!condition())
+     *  {
+     *      notifier.wait();
+     *  }
+     *  notifier.finish_wait();
+     *  @endcode
+     *
+     *  In semaphore mode (EFD_SEMAPHORE) every notification is a
+     *  token that wakes up one waiting consumer, which is suitable
+     *  for waking up one of several workers.
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    class notifier
+    {
+        public:
+
+        /** Constructs a notifier object
+         *
+         *  @param flags Zero or EFD_SEMAPHORE.  The eventfd is always
+         *               non-blocking.
+         *
+         *  @throws ndgpp::error<std::system_error> if eventfd fails
+         */
+        explicit
+        notifier(const int flags);
+
+        notifier();
+
+        notifier(const notifier &) = delete;
+        notifier & operator= (const notifier &) = delete;
+
+        notifier(notifier &&) = delete;
+        notifier & operator= (notifier &&) = delete;
+
+        /** Declares that the calling consumer is about to block
+         *
+         *  The consumer must check its wake up condition after
+         *  calling this, and call finish_wait when it's done waiting
+         *  or decides not to wait.
+         */
+        void
+        prepare_wait() noexcept;
+
+        /// Declares that the calling consumer is no longer waiting
+        void
+        finish_wait() noexcept;
+
+        /** Notifies a waiting consumer
+         *
+         *  Must be called after the producer has changed the
+         *  consumer's wake up condition.
+         *
+         *  @return true if the eventfd was written to, false if no
+         *          consumer was waiting or a notification was
+         *          already pending
+         *
+         *  @throws ndgpp::error<std::system_error> if the eventfd
+         *          write fails for a reason other than counter
+         *          overflow
+         */
+        bool
+        notify();
+
+        /** Blocks until notified and consumes the notification
+         *
+         *  @return The eventfd counter value that was read, 1 in
+         *          semaphore mode
+         *
+         *  @throws ndgpp::error<std::system_error> if poll or read fails
+         */
+        uint64_t
+        wait();
+
+        /** Consumes a pending notification without blocking
+         *
+         *  @return The eventfd counter value that was read, or 0 if
+         *          there was no pending notification
+         *
+         *  @throws ndgpp::error<std::system_error> if read fails
+         *          for a reason other than EAGAIN
+         */
+        uint64_t
+        consume();
+
+        /// Returns true if a consumer is waiting
+        bool
+        sleeping() const noexcept;
+
+        /// Returns the eventfd, which is readable when a notification is pending
+        int
+        fd() const;
+
+        private:
+
+        std::atomic<unsigned int> sleepers_ {0};
+
+        // true while a written notification has not been consumed,
+        // not used in semaphore mode since each write is a token
+        std::atomic<bool> pending_ {false};
+        const bool semaphore_;
+
+        linuxpp::eventfd eventfd_;
+    };
+}
+
+#endif
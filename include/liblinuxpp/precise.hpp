@@ -0,0 +1,11 @@
+#ifndef LIBLINUXPP_PRECISE_HPP
+#define LIBLINUXPP_PRECISE_HPP
+
+namespace linuxpp
+{
+    /// Tag type that selects the high precision version of an operation
+    struct precise_t {};
+    static const precise_t precise {};
+}
+
+#endif
@@ -5,10 +5,13 @@
 
 #include <cerrno>
 
+#include <new>
 #include <system_error>
 
 #include <libndgpp/error.hpp>
 
+#include <liblinuxpp/syscall_return.hpp>
+
 namespace linuxpp
 {
     /** Reads bytes from a file descriptor
@@ -29,6 +32,23 @@ namespace linuxpp
 
         return static_cast<std::size_t>(ret);
     }
+
+    /** Reads bytes from a file descriptor
+     *
+     *  @return The number of bytes read
+     */
+    inline
+    linuxpp::syscall_return<::ssize_t>
+    read(std::nothrow_t, const int fd, void * const buf, const std::size_t length)
+    {
+        const ssize_t ret = ::read(fd, buf, length);
+        if (ret == -1)
+        {
+            return linuxpp::syscall_return<::ssize_t> {errno, ret};
+        }
+
+        return linuxpp::syscall_return<::ssize_t> {ret};
+    }
 }
 
 #endif
@@ -0,0 +1,47 @@
+#ifndef LIBLINUXPP_SENDFILE_HPP
+#define LIBLINUXPP_SENDFILE_HPP
+
+#include <sys/types.h>
+
+#include <cstddef>
+
+#include <new>
+
+#include <liblinuxpp/syscall_return.hpp>
+
+namespace linuxpp
+{
+    /** Copies data from a file to another file descriptor, typically a socket, within the kernel
+     *
+     *  @param out_fd The file descriptor to write to
+     *  @param in_fd The file descriptor to read from, which must support mmap
+     *  @param offset The offset to read from, which is updated and
+     *                leaves the file offset alone, or nullptr to read
+     *                from and update the file offset
+     *  @param count The maximum number of bytes to copy
+     *
+     *  @return The number of bytes copied, which can be less than
+     *          count, e.g. when a non-blocking socket is full
+     *
+     *  @throws ndgpp::error<std::system_error> if an error is encountered
+     */
+    std::size_t sendfile(const int out_fd,
+                         const int in_fd,
+                         ::off_t * const offset,
+                         const std::size_t count);
+
+    /** Copies data from a file to another file descriptor within the kernel
+     *
+     *  Errors, such as EAGAIN, are returned instead of thrown
+     *
+     *  @see sendfile(int, int, off_t *, std::size_t)
+     */
+    linuxpp::syscall_return<::ssize_t>
+    sendfile(std::nothrow_t,
+             const int out_fd,
+             const int in_fd,
+             ::off_t * const offset,
+             const std::size_t count) noexcept;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef LIBLINUXPP_SIGNALFD_HPP
+#define LIBLINUXPP_SIGNALFD_HPP
+
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+#include <cstddef>
+
+#include <new>
+
+#include <liblinuxpp/syscall_return.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+namespace linuxpp
+{
+    /** A resource owning class for a signalfd file descriptor
+     *
+     *  The signals in the signalfd's mask must be blocked, via
+     *  pthread_sigmask, in every thread, or they will be delivered
+     *  to a thread instead of being queued for the signalfd.
+     */
+    class signalfd
+    {
+        public:
+
+        /** Constructs a signalfd object
+         *
+         *  @param mask The signals to accept
+         *  @param flags Zero or more of SFD_NONBLOCK, SFD_CLOEXEC is always set
+         *
+         *  @throws ndgpp::error<std::system_error> if signalfd fails
+         */
+        signalfd(const sigset_t & mask,
+                 const int flags);
+
+        /// Constructs a signalfd object with an empty signal mask
+        explicit
+        signalfd(const int flags);
+
+        signalfd();
+
+        signalfd(const signalfd &) = delete;
+        signalfd & operator= (const signalfd &) = delete;
+
+        signalfd(signalfd &&);
+        signalfd & operator= (signalfd &&);
+
+        /** Replaces the signals accepted by the signalfd
+         *
+         *  @throws ndgpp::error<std::system_error> if signalfd fails
+         */
+        void
+        set_mask(const sigset_t & mask);
+
+        /** Reads up to count signal records
+         *
+         *  @return The number of records read
+         *
+         *  @throws ndgpp::error<std::system_error> if read fails
+         */
+        std::size_t
+        read(signalfd_siginfo * const infos,
+             const std::size_t count);
+
+        /** Reads up to count signal records
+         *
+         *  @return A linuxpp::syscall_return object whose value is
+         *          the number of records read
+         */
+        linuxpp::syscall_return<std::size_t>
+        read(std::nothrow_t,
+             signalfd_siginfo * const infos,
+             const std::size_t count);
+
+        int
+        fd() const;
+
+        private:
+
+        linuxpp::unique_fd<> fd_;
+    };
+}
+
+#endif
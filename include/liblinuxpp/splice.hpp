@@ -0,0 +1,160 @@
+#ifndef LIBLINUXPP_SPLICE_HPP
+#define LIBLINUXPP_SPLICE_HPP
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+
+#include <new>
+
+#include <liblinuxpp/pipe.hpp>
+#include <liblinuxpp/syscall_return.hpp>
+
+namespace linuxpp
+{
+    /** @defgroup splice splice
+     *
+     *  The splice function overload set moves data between a pipe and
+     *  another file descriptor without copying it through user space
+     *
+     *  One of the two file descriptors has to be a pipe.  A return
+     *  value of 0 means the input reached the end of file, or for a
+     *  pipe, that the pipe is empty and has no writers.
+     *  SPLICE_F_NONBLOCK only makes the pipe side non-blocking, so a
+     *  socket has to be non-blocking itself for the splice not to
+     *  block on it.
+     *
+     *  @param fd_in The file descriptor to read from
+     *  @param off_in The offset to read from when fd_in is a file,
+     *                which is updated, or nullptr to use the file offset
+     *  @param fd_out The file descriptor to write to
+     *  @param off_out The offset to write to when fd_out is a file,
+     *                 which is updated, or nullptr to use the file offset
+     *  @param length The maximum number of bytes to move
+     *  @param flags A combination of the SPLICE_F_* flags
+     *
+     *  @return The number of bytes moved
+     *  @throws ndgpp::error<std::system_error> if an error is encountered
+     *  @{
+     */
+
+    std::size_t splice(const int fd_in,
+                       ::loff_t * const off_in,
+                       const int fd_out,
+                       ::loff_t * const off_out,
+                       const std::size_t length,
+                       const unsigned int flags = 0);
+
+    std::size_t splice(const int fd_in,
+                       const int fd_out,
+                       const std::size_t length,
+                       const unsigned int flags = 0);
+
+    /// Splices from a file descriptor into a pipe
+    std::size_t splice(const int fd_in,
+                       linuxpp::pipe & out,
+                       const std::size_t length,
+                       const unsigned int flags = 0);
+
+    /// Splices from a pipe to a file descriptor
+    std::size_t splice(linuxpp::pipe & in,
+                       const int fd_out,
+                       const std::size_t length,
+                       const unsigned int flags = 0);
+
+    /** @} */
+
+    /** @defgroup nothrow_splice nothrow splice
+     *
+     *  The nothrow splice overload set returns errors, such as
+     *  EAGAIN, instead of throwing them
+     *
+     *  @see splice
+     *  @{
+     */
+
+    linuxpp::syscall_return<::ssize_t>
+    splice(std::nothrow_t,
+           const int fd_in,
+           ::loff_t * const off_in,
+           const int fd_out,
+           ::loff_t * const off_out,
+           const std::size_t length,
+           const unsigned int flags = 0) noexcept;
+
+    linuxpp::syscall_return<::ssize_t>
+    splice(std::nothrow_t,
+           const int fd_in,
+           const int fd_out,
+           const std::size_t length,
+           const unsigned int flags = 0) noexcept;
+
+    linuxpp::syscall_return<::ssize_t>
+    splice(std::nothrow_t,
+           const int fd_in,
+           linuxpp::pipe & out,
+           const std::size_t length,
+           const unsigned int flags = 0) noexcept;
+
+    linuxpp::syscall_return<::ssize_t>
+    splice(std::nothrow_t,
+           linuxpp::pipe & in,
+           const int fd_out,
+           const std::size_t length,
+           const unsigned int flags = 0) noexcept;
+
+    /** @} */
+
+    /** Duplicates the data of one pipe into another without consuming it
+     *
+     *  @param in The pipe to read from
+     *  @param out The pipe to write to
+     *  @param length The maximum number of bytes to duplicate
+     *  @param flags A combination of the SPLICE_F_* flags
+     *
+     *  @return The number of bytes duplicated
+     *  @throws ndgpp::error<std::system_error> if an error is encountered
+     */
+    std::size_t tee(linuxpp::pipe & in,
+                    linuxpp::pipe & out,
+                    const std::size_t length,
+                    const unsigned int flags = 0);
+
+    linuxpp::syscall_return<::ssize_t>
+    tee(std::nothrow_t,
+        linuxpp::pipe & in,
+        linuxpp::pipe & out,
+        const std::size_t length,
+        const unsigned int flags = 0) noexcept;
+
+    /** Maps user memory into a pipe
+     *
+     *  Without SPLICE_F_GIFT the pages are copied into the pipe, so
+     *  the buffers can be reused as soon as vmsplice returns.  With
+     *  SPLICE_F_GIFT the pages are handed over and must not be
+     *  modified afterwards.
+     *
+     *  @param out The pipe to write to
+     *  @param buffers The memory to write
+     *  @param size_buffers The number of buffers
+     *  @param flags A combination of the SPLICE_F_* flags
+     *
+     *  @return The number of bytes written to the pipe
+     *  @throws ndgpp::error<std::system_error> if an error is encountered
+     */
+    std::size_t vmsplice(linuxpp::pipe & out,
+                         struct ::iovec const * const buffers,
+                         const std::size_t size_buffers,
+                         const unsigned int flags = 0);
+
+    linuxpp::syscall_return<::ssize_t>
+    vmsplice(std::nothrow_t,
+             linuxpp::pipe & out,
+             struct ::iovec const * const buffers,
+             const std::size_t size_buffers,
+             const unsigned int flags = 0) noexcept;
+}
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef LIBLINUXPP_SPSC_RING_HPP
+#define LIBLINUXPP_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+namespace linuxpp
+{
+    /** A bounded single-producer/single-consumer ring of T objects
+     *
+     *  One thread may push into the ring while another thread pops
+     *  from it without any locking.  The producer and consumer
+     *  indexes live on separate cache lines, and each side caches
+     *  the other side's index so the shared index is only re-read
+     *  when the ring appears full or empty.
+     *
+     *  @tparam T The type of object stored in the ring
+     *
+     *  @par Copy Semantics Non-copyable and non-movable
+     */
+    template <class T>
+    class spsc_ring final
+    {
+        public:
+
+        using value_type = T;
+
+        /** Constructs a ring that holds at least capacity objects
+         *
+         *  @param capacity The minimum number of objects the ring can
+         *                  hold.  It's rounded up to a power of two.
+         *
+         *  @throws ndgpp::error<std::invalid_argument> if capacity is 0
+         */
+        explicit
+        spsc_ring(const std::size_t capacity);
+
+        ~spsc_ring();
+
+        spsc_ring(const spsc_ring &) = delete;
+        spsc_ring & operator= (const spsc_ring &) = delete;
+
+        spsc_ring(spsc_ring &&) = delete;
+        spsc_ring & operator= (spsc_ring &&) = delete;
+
+        /** Constructs an object at the back of the ring
+         *
+         *  @note Only the producer thread may call this function
+         *
+         *  @return false if the ring is full
+         */
+        template <class ... Args>
+        bool try_emplace(Args && ... args);
+
+        /// Copies value to the back of the ring, returns false if the ring is full
+        bool try_push(const T & value);
+
+        /// Moves value to the back of the ring, returns false if the ring is full
+        bool try_push(T && value);
+
+        /** Moves the front object of the ring into value
+         *
+         *  @note Only the consumer thread may call this function
+         *
+         *  @return false if the ring is empty
+         */
+        bool try_pop(T & value);
+
+        /** Passes up to max_objects objects to func and pops them
+         *
+         *  The consumer index is published once after all of the
+         *  objects have been consumed
+         *
+         *  @note Only the consumer thread may call this function
+         *
+         *  @param func A callable object invocable with T &
+         *  @param max_objects The maximum number of objects to consume
+         *
+         *  @return The number of objects consumed
+         */
+        template <class F>
+        std::size_t consume(F && func, const std::size_t max_objects);
+
+        /// Returns true if the ring contains no objects
+        bool empty() const noexcept;
+
+        /// Returns the number of objects in the ring
+        std::size_t size() const noexcept;
+
+        /// Returns the number of objects the ring can hold
+        std::size_t capacity() const noexcept;
+
+        private:
+
+        static constexpr std::size_t cache_line_size = 64;
+
+        using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+        static std::size_t round_capacity(const std::size_t capacity);
+
+        T * slot(const std::size_t index) noexcept;
+
+        const std::size_t mask_;
+        std::unique_ptr<storage_type[]> storage_;
+
+        // The padding keeps the producer and consumer data on their
+        // own cache lines without requiring over-aligned allocation
+
+        char producer_padding_[cache_line_size];
+
+        // Producer owned data
+        std::atomic<std::size_t> tail_ {0};
+        std::size_t cached_head_ = 0;
+
+        char consumer_padding_[cache_line_size];
+
+        // Consumer owned data
+        std::atomic<std::size_t> head_ {0};
+        std::size_t cached_tail_ = 0;
+
+        char trailing_padding_[cache_line_size];
+    };
+
+    template <class T>
+    inline std::size_t spsc_ring<T>::round_capacity(const std::size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw ndgpp_error(std::invalid_argument,
+                              "spsc_ring capacity cannot be 0");
+        }
+
+        std::size_t rounded = 1;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+
+        return rounded;
+    }
+
+    template <class T>
+    spsc_ring<T>::spsc_ring(const std::size_t capacity):
+        mask_(round_capacity(capacity) - 1),
+        storage_(new storage_type[mask_ + 1])
+    {}
+
+    template <class T>
+    spsc_ring<T>::~spsc_ring()
+    {
+        const std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+        for (std::size_t i = this->head_.load(std::memory_order_relaxed); i != tail; ++i)
+        {
+            this->slot(i)->~T();
+        }
+    }
+
+    template <class T>
+    inline T * spsc_ring<T>::slot(const std::size_t index) noexcept
+    {
+        return reinterpret_cast<T *>(&this->storage_[index & this->mask_]);
+    }
+
+    template <class T>
+    template <class ... Args>
+    inline bool spsc_ring<T>::try_emplace(Args && ... args)
+    {
+        const std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+        if (tail - this->cached_head_ > this->mask_)
+        {
+            // The ring looks full, so refresh the consumer's index
+            this->cached_head_ = this->head_.load(std::memory_order_acquire);
+            if (tail - this->cached_head_ > this->mask_)
+            {
+                return false;
+            }
+        }
+
+        ::new (static_cast<void *>(this->slot(tail))) T(std::forward<Args>(args)...);
+        this->tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class T>
+    inline bool spsc_ring<T>::try_push(const T & value)
+    {
+        return this->try_emplace(value);
+    }
+
+    template <class T>
+    inline bool spsc_ring<T>::try_push(T && value)
+    {
+        return this->try_emplace(std::move(value));
+    }
+
+    template <class T>
+    inline bool spsc_ring<T>::try_pop(T & value)
+    {
+        const std::size_t head = this->head_.load(std::memory_order_relaxed);
+        if (head == this->cached_tail_)
+        {
+            this->cached_tail_ = this->tail_.load(std::memory_order_acquire);
+            if (head == this->cached_tail_)
+            {
+                return false;
+            }
+        }
+
+        T * const object = this->slot(head);
+        value = std::move(*object);
+        object->~T();
+        this->head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class T>
+    template <class F>
+    std::size_t spsc_ring<T>::consume(F && func, const std::size_t max_objects)
+    {
+        const std::size_t head = this->head_.load(std::memory_order_relaxed);
+        if (head == this->cached_tail_)
+        {
+            this->cached_tail_ = this->tail_.load(std::memory_order_acquire);
+        }
+
+        const std::size_t available = this->cached_tail_ - head;
+        const std::size_t count = available < max_objects ? available : max_objects;
+
+        std::size_t i = 0;
+        try
+        {
+            for (; i < count; ++i)
+            {
+                T * const object = this->slot(head + i);
+                func(*object);
+                object->~T();
+            }
+        }
+        catch (...)
+        {
+            // Destroy the object whose callback threw and publish
+            // the objects consumed so far
+            this->slot(head + i)->~T();
+            this->head_.store(head + i + 1, std::memory_order_release);
+            throw;
+        }
+
+        this->head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    template <class T>
+    inline bool spsc_ring<T>::empty() const noexcept
+    {
+        return this->size() == 0;
+    }
+
+    template <class T>
+    inline std::size_t spsc_ring<T>::size() const noexcept
+    {
+        // Load the head first so it can never be ahead of the tail
+        const std::size_t head = this->head_.load(std::memory_order_acquire);
+        const std::size_t tail = this->tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    template <class T>
+    inline std::size_t spsc_ring<T>::capacity() const noexcept
+    {
+        return this->mask_ + 1;
+    }
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <tuple>
 #include <stdexcept>
+#include <system_error>
 
 #include <libndgpp/error.hpp>
 
@@ -131,6 +132,27 @@ namespace linuxpp
     {
         return std::get<errno_member>(this->members_);
     }
+
+    /** Returns the return value of a successful system call
+     *
+     *  @param ret The system call's result
+     *  @param what The message of the exception thrown on failure
+     *
+     *  @throws ndgpp::error<std::system_error> with the stored errno
+     *          value if the system call failed
+     */
+    template <class T>
+    inline T value_or_throw(const syscall_return<T> & ret, char const * const what)
+    {
+        if (ret.fail())
+        {
+            throw ndgpp_error(std::system_error,
+                              std::error_code (ret.errno_value(), std::system_category()),
+                              what);
+        }
+
+        return ret.return_value();
+    }
 }
 
 #endif
@@ -0,0 +1,131 @@
+#ifndef LIBLINUXPP_THREAD_TUNING_HPP
+#define LIBLINUXPP_THREAD_TUNING_HPP
+
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <cstddef>
+
+#include <chrono>
+#include <vector>
+
+#include <liblinuxpp/tuning_status.hpp>
+
+namespace linuxpp
+{
+    /// The outcome of applying a thread_tuning object
+    struct thread_tuning_result
+    {
+        linuxpp::tuning_status affinity;
+        linuxpp::tuning_status scheduler;
+        linuxpp::tuning_status timer_slack;
+        linuxpp::tuning_status memory_lock;
+        linuxpp::tuning_status prefault;
+
+        /// Returns true if every requested setting was applied
+        bool
+        all_applied() const noexcept;
+    };
+
+    /** A set of tuning settings for a latency critical thread
+     *
+     *  Only the settings that are set are applied.  Settings that
+     *  require privileges, e.g. real time scheduling policies and
+     *  memory locking, are often refused for unprivileged processes,
+     *  so linuxpp::thread_tuning::apply reports what actually took
+     *  effect instead of throwing.
+     */
+    class thread_tuning
+    {
+        public:
+
+        /** Sets the CPUs the thread is allowed to run on
+         *
+         *  @param cpus The CPU numbers to run on
+         */
+        void
+        set_affinity(const std::vector<int> & cpus);
+
+        /// Sets the CPUs the thread is allowed to run on
+        void
+        set_affinity(const cpu_set_t & cpus);
+
+        /** Sets the scheduling policy and priority
+         *
+         *  @param policy One of SCHED_OTHER, SCHED_BATCH, SCHED_IDLE,
+         *                SCHED_FIFO, or SCHED_RR
+         *
+         *  @param priority The static priority, must be 0 for the
+         *                  non real time policies
+         */
+        void
+        set_scheduler(const int policy,
+                      const int priority);
+
+        /// Sets the thread's timer slack via PR_SET_TIMERSLACK
+        void
+        set_timer_slack(const std::chrono::nanoseconds slack);
+
+        /** Locks the process' memory via mlockall
+         *
+         *  @param flags A combination of MCL_CURRENT, MCL_FUTURE, and MCL_ONFAULT
+         */
+        void
+        set_memory_lock(const int flags = MCL_CURRENT | MCL_FUTURE);
+
+        /** Sets the number of bytes of the thread's stack to prefault
+         *
+         *  @param size The number of bytes of stack to touch, must
+         *              be comfortably smaller than the thread's stack
+         */
+        void
+        set_stack_prefault(const std::size_t size);
+
+        /** Adds a buffer to prefault
+         *
+         *  Every page of the buffer is faulted in with
+         *  MADV_POPULATE_WRITE, or read on kernels without it, so its
+         *  contents aren't written and other threads may already use
+         *  it.  The buffer must remain valid until apply is called.
+         */
+        void
+        add_prefault_buffer(void * const buffer,
+                            const std::size_t size);
+
+        /** Applies the settings to the calling thread
+         *
+         *  The memory lock is applied before prefaulting, so the
+         *  prefaulted pages stay resident.
+         *
+         *  @return The outcome of each setting
+         */
+        linuxpp::thread_tuning_result
+        apply() const;
+
+        private:
+
+        struct prefault_buffer
+        {
+            void * buffer;
+            std::size_t size;
+        };
+
+        bool affinity_requested_ = false;
+        cpu_set_t affinity_;
+
+        bool scheduler_requested_ = false;
+        int policy_ = SCHED_OTHER;
+        int priority_ = 0;
+
+        bool timer_slack_requested_ = false;
+        std::chrono::nanoseconds timer_slack_ {0};
+
+        bool memory_lock_requested_ = false;
+        int memory_lock_flags_ = 0;
+
+        std::size_t stack_prefault_size_ = 0;
+        std::vector<prefault_buffer> prefault_buffers_;
+    };
+}
+
+#endif
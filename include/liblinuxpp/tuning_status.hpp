@@ -0,0 +1,20 @@
+#ifndef LIBLINUXPP_TUNING_STATUS_HPP
+#define LIBLINUXPP_TUNING_STATUS_HPP
+
+namespace linuxpp
+{
+    /// The outcome of applying a single thread_tuning or socket_tuning setting
+    struct tuning_status
+    {
+        /// True if the setting was requested
+        bool requested = false;
+
+        /// True if the setting was applied and read back successfully
+        bool applied = false;
+
+        /// The errno value of the failed system call, 0 otherwise
+        int errno_value = 0;
+    };
+}
+
+#endif
@@ -120,7 +120,17 @@ namespace linuxpp
     unique_fd<Closer>::unique_fd(unique_fd&& src) noexcept = default;
 
     template <class Closer>
-    unique_fd<Closer> & unique_fd<Closer>::operator=(unique_fd&& src) noexcept = default;
+    unique_fd<Closer> & unique_fd<Closer>::operator=(unique_fd&& src) noexcept
+    {
+        if (this != &src)
+        {
+            // The current descriptor is closed with the current closer
+            this->reset(src.release());
+            this->get_closer() = std::move(src.get_closer());
+        }
+
+        return *this;
+    }
 
     template <class Closer>
     inline unique_fd<Closer>::~unique_fd()
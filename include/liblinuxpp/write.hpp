@@ -1,6 +1,7 @@
 #ifndef LIBLINUXPP_WRITE_HPP
 #define LIBLINUXPP_WRITE_HPP
 
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <cerrno>
@@ -50,6 +51,42 @@ namespace linuxpp
 
         return linuxpp::syscall_return<::ssize_t> {ret};
     }
+
+    /** Writes buffers to a file descriptor with writev
+     *
+     *  @return The number of bytes written
+     *
+     *  @throws ndgpp::error<std::system_error> when an error is encountered
+     */
+    inline std::size_t write(const int fd, struct ::iovec const * const buffers, const std::size_t size_buffers)
+    {
+        const ssize_t ret = ::writev(fd, buffers, static_cast<int>(size_buffers));
+        if (ret == -1)
+        {
+            throw ndgpp_error(std::system_error,
+                              std::error_code(errno, std::system_category()),
+                              "writev failed");
+        }
+
+        return static_cast<std::size_t>(ret);
+    }
+
+    /** Writes buffers to a file descriptor with writev
+     *
+     *  @return The number of bytes written
+     */
+    inline
+    linuxpp::syscall_return<::ssize_t>
+    write(std::nothrow_t, const int fd, struct ::iovec const * const buffers, const std::size_t size_buffers)
+    {
+        const ssize_t ret = ::writev(fd, buffers, static_cast<int>(size_buffers));
+        if (ret == -1)
+        {
+            return linuxpp::syscall_return<::ssize_t> {errno, ret};
+        }
+
+        return linuxpp::syscall_return<::ssize_t> {ret};
+    }
 }
 
 #endif
@@ -0,0 +1,219 @@
+#include <fcntl.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/buffered_reader.hpp>
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/find_byte.hpp>
+#include <liblinuxpp/read.hpp>
+
+constexpr std::size_t linuxpp::buffered_reader::default_buffer_size;
+
+linuxpp::buffered_reader::buffered_reader(const int fd,
+                                          const char delimiter,
+                                          const std::size_t buffer_size,
+                                          const std::size_t max_record_size):
+    fd_(fd),
+    delimiter_(delimiter),
+    max_record_size_(max_record_size == 0 ? buffer_size : max_record_size),
+    capacity_(buffer_size)
+{
+    if (buffer_size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "buffered_reader buffer size must be greater than 0");
+    }
+
+    if (buffer_size > this->max_record_size_)
+    {
+        throw ndgpp_error(std::invalid_argument, "buffered_reader buffer size is greater than its maximum record size");
+    }
+
+    this->buffer_.reset(new char[buffer_size]);
+}
+
+linuxpp::buffered_reader::~buffered_reader()
+{
+    this->detach();
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::buffered_reader::read(const record_handler & handler)
+{
+    if (this->eof_)
+    {
+        return linuxpp::syscall_return<::ssize_t> {0};
+    }
+
+    if (this->begin_ > 0)
+    {
+        // Move the incomplete record to the front to make room
+        std::memmove(this->buffer_.get(),
+                     this->buffer_.get() + this->begin_,
+                     this->end_ - this->begin_);
+        this->end_ -= this->begin_;
+        this->scanned_ -= this->begin_;
+        this->begin_ = 0;
+    }
+
+    if (this->end_ == this->capacity_)
+    {
+        if (this->capacity_ >= this->max_record_size_)
+        {
+            // The rest of the record is still in the descriptor, so
+            // it's skipped through the next delimiter
+            this->scanned_ = 0;
+            this->end_ = 0;
+            this->discarding_ = true;
+            return linuxpp::syscall_return<::ssize_t> {EMSGSIZE, -1};
+        }
+
+        const std::size_t capacity = std::min(this->capacity_ * 2, this->max_record_size_);
+        std::unique_ptr<char[]> buffer {new char[capacity]};
+        std::memcpy(buffer.get(), this->buffer_.get(), this->end_);
+        this->buffer_ = std::move(buffer);
+        this->capacity_ = capacity;
+    }
+
+    const auto ret = linuxpp::read(std::nothrow,
+                                   this->fd_,
+                                   this->buffer_.get() + this->end_,
+                                   this->capacity_ - this->end_);
+    if (!ret)
+    {
+        return ret;
+    }
+
+    char const * const buffer = this->buffer_.get();
+    if (ret.return_value() == 0)
+    {
+        this->eof_ = true;
+        if (!this->discarding_ && this->end_ > this->begin_)
+        {
+            const std::size_t begin = this->begin_;
+            this->begin_ = this->end_;
+            handler(buffer + begin, this->end_ - begin);
+        }
+
+        return ret;
+    }
+
+    this->end_ += static_cast<std::size_t>(ret.return_value());
+    char const * const last = buffer + this->end_;
+    char const * position = buffer + this->scanned_;
+    if (this->discarding_)
+    {
+        position = linuxpp::find_byte(position, last, this->delimiter_);
+        if (position == last)
+        {
+            this->scanned_ = 0;
+            this->end_ = 0;
+            return ret;
+        }
+
+        // The oversized record ends here, so framing resumes after it
+        this->discarding_ = false;
+        this->begin_ = static_cast<std::size_t>(position - buffer) + 1;
+        this->scanned_ = this->begin_;
+        ++position;
+    }
+
+    while ((position = linuxpp::find_byte(position, last, this->delimiter_)) != last)
+    {
+        // Advance past the record first, so a throwing handler
+        // doesn't see it again
+        char const * const record = buffer + this->begin_;
+        this->begin_ = static_cast<std::size_t>(position - buffer) + 1;
+        this->scanned_ = this->begin_;
+        handler(record, static_cast<std::size_t>(position - record));
+        ++position;
+    }
+
+    this->scanned_ = this->end_;
+    return ret;
+}
+
+std::size_t
+linuxpp::buffered_reader::buffered() const noexcept
+{
+    return this->end_ - this->begin_;
+}
+
+bool
+linuxpp::buffered_reader::eof() const noexcept
+{
+    return this->eof_;
+}
+
+void
+linuxpp::buffered_reader::attach(linuxpp::ioloop & loop,
+                                 record_handler records,
+                                 done_handler done)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "buffered_reader is already attached to an ioloop");
+    }
+
+    const int flags = linuxpp::fcntl(this->fd_, F_GETFL);
+    linuxpp::fcntl(this->fd_, F_SETFL, flags | O_NONBLOCK);
+
+    loop.add_handler(this->fd_,
+                     linuxpp::ioloop::event_enum::read | linuxpp::ioloop::event_enum::error,
+                     [this] (int, uint32_t) { this->handle_events(); });
+
+    this->record_handler_ = std::move(records);
+    this->done_handler_ = std::move(done);
+    this->loop_ = &loop;
+}
+
+void
+linuxpp::buffered_reader::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    this->loop_->remove_handler(this->fd_);
+    this->loop_ = nullptr;
+}
+
+int
+linuxpp::buffered_reader::descriptor() const noexcept
+{
+    return this->fd_;
+}
+
+void
+linuxpp::buffered_reader::handle_events()
+{
+    // One read per event keeps the reader from starving the other
+    // descriptors, the ioloop reports the descriptor again while
+    // it's readable
+    const auto ret = this->read(this->record_handler_);
+    if (ret && ret.return_value() > 0)
+    {
+        return;
+    }
+
+    if (!ret && (ret.errno_value() == EAGAIN ||
+                 ret.errno_value() == EWOULDBLOCK ||
+                 ret.errno_value() == EINTR))
+    {
+        return;
+    }
+
+    this->detach();
+    done_handler done = std::move(this->done_handler_);
+    if (done)
+    {
+        done(ret ? 0 : ret.errno_value());
+    }
+}
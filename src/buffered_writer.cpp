@@ -0,0 +1,391 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/buffered_writer.hpp>
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/write.hpp>
+
+namespace
+{
+    bool is_socket(const int fd)
+    {
+        struct ::stat info;
+        if (::fstat(fd, &info) == -1)
+        {
+            throw ndgpp_error(std::system_error,
+                              std::error_code (errno, std::system_category()),
+                              "failed to fstat the buffered_writer's file descriptor");
+        }
+
+        return S_ISSOCK(info.st_mode);
+    }
+}
+
+constexpr std::size_t linuxpp::buffered_writer::default_chunk_size;
+constexpr std::size_t linuxpp::buffered_writer::default_high_watermark;
+constexpr std::size_t linuxpp::buffered_writer::default_low_watermark;
+
+linuxpp::buffered_writer::buffered_writer(const int fd,
+                                          const std::size_t high_watermark,
+                                          const std::size_t low_watermark,
+                                          const std::size_t chunk_size):
+    fd_(fd),
+    socket_(::is_socket(fd)),
+    high_watermark_(high_watermark),
+    low_watermark_(low_watermark),
+    chunk_size_(chunk_size)
+{
+    if (chunk_size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "buffered_writer chunk size must be greater than 0");
+    }
+
+    if (low_watermark > high_watermark)
+    {
+        throw ndgpp_error(std::invalid_argument, "buffered_writer low watermark is greater than its high watermark");
+    }
+
+    // Keep enough chunks around to buffer up to the high watermark
+    // without allocating
+    this->max_free_chunks_ = std::max<std::size_t>(1, (high_watermark + chunk_size - 1) / chunk_size);
+    this->iovecs_.reserve(IOV_MAX);
+}
+
+linuxpp::buffered_writer::~buffered_writer()
+{
+    this->detach();
+}
+
+std::unique_ptr<unsigned char[]>
+linuxpp::buffered_writer::allocate_chunk()
+{
+    if (this->free_chunks_.empty())
+    {
+        return std::unique_ptr<unsigned char[]> {new unsigned char[this->chunk_size_]};
+    }
+
+    auto data = std::move(this->free_chunks_.back());
+    this->free_chunks_.pop_back();
+    return data;
+}
+
+bool
+linuxpp::buffered_writer::write(void const * const buf, const std::size_t length)
+{
+    if (this->error_ != 0)
+    {
+        return false;
+    }
+
+    auto source = static_cast<unsigned char const *>(buf);
+    std::size_t remaining = length;
+    while (remaining > 0)
+    {
+        if (this->chunks_.empty() || this->chunks_.back().end == this->chunk_size_)
+        {
+            this->chunks_.push_back(chunk {this->allocate_chunk(), 0, 0});
+        }
+
+        chunk & back = this->chunks_.back();
+        const std::size_t count = std::min(remaining, this->chunk_size_ - back.end);
+        std::memcpy(back.data.get() + back.end, source, count);
+        back.end += count;
+        source += count;
+        remaining -= count;
+    }
+
+    this->buffered_ += length;
+    if (this->buffered_ >= this->high_watermark_)
+    {
+        this->above_high_watermark_ = true;
+    }
+
+    return !this->above_high_watermark_;
+}
+
+void
+linuxpp::buffered_writer::consume(std::size_t length) noexcept
+{
+    this->buffered_ -= length;
+    while (length > 0)
+    {
+        chunk & front = this->chunks_.front();
+        const std::size_t count = std::min(length, front.end - front.begin);
+        front.begin += count;
+        length -= count;
+        if (front.begin != front.end)
+        {
+            break;
+        }
+
+        if (this->free_chunks_.size() < this->max_free_chunks_)
+        {
+            // Doesn't allocate, the capacity never exceeds the
+            // maximum number of free chunks
+            this->free_chunks_.push_back(std::move(front.data));
+        }
+
+        this->chunks_.pop_front();
+    }
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::buffered_writer::flush()
+{
+    if (this->buffered_ == 0)
+    {
+        return linuxpp::syscall_return<::ssize_t> {0};
+    }
+
+    this->iovecs_.clear();
+    for (const chunk & chunk : this->chunks_)
+    {
+        if (this->iovecs_.size() == IOV_MAX)
+        {
+            break;
+        }
+
+        this->iovecs_.push_back(::iovec {chunk.data.get() + chunk.begin, chunk.end - chunk.begin});
+    }
+
+    linuxpp::syscall_return<::ssize_t> ret {0};
+    if (this->socket_)
+    {
+        struct ::msghdr msg = {};
+        msg.msg_iov = this->iovecs_.data();
+        msg.msg_iovlen = this->iovecs_.size();
+        ret = linuxpp::net::send(std::nothrow, this->fd_, msg, MSG_NOSIGNAL);
+    }
+    else
+    {
+        ret = linuxpp::write(std::nothrow, this->fd_, this->iovecs_.data(), this->iovecs_.size());
+    }
+
+    if (!ret)
+    {
+        return ret;
+    }
+
+    this->consume(static_cast<std::size_t>(ret.return_value()));
+    if (this->above_high_watermark_ && this->buffered_ <= this->low_watermark_)
+    {
+        this->above_high_watermark_ = false;
+        if (this->drain_handler_)
+        {
+            this->drain_handler_();
+        }
+    }
+
+    return ret;
+}
+
+std::size_t
+linuxpp::buffered_writer::buffered() const noexcept
+{
+    return this->buffered_;
+}
+
+bool
+linuxpp::buffered_writer::above_high_watermark() const noexcept
+{
+    return this->above_high_watermark_;
+}
+
+bool
+linuxpp::buffered_writer::blocked() const noexcept
+{
+    return this->blocked_;
+}
+
+int
+linuxpp::buffered_writer::error() const noexcept
+{
+    return this->error_;
+}
+
+void
+linuxpp::buffered_writer::set_drain_handler(drain_handler handler)
+{
+    this->drain_handler_ = std::move(handler);
+}
+
+void
+linuxpp::buffered_writer::attach(linuxpp::ioloop & loop,
+                                 error_handler handler,
+                                 event_handler events_handler)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "buffered_writer is already attached to an ioloop");
+    }
+
+    const int flags = linuxpp::fcntl(this->fd_, F_GETFL);
+    linuxpp::fcntl(this->fd_, F_SETFL, flags | O_NONBLOCK);
+
+    if (events_handler)
+    {
+        loop.add_handler(this->fd_,
+                         linuxpp::ioloop::event_enum::read | linuxpp::ioloop::event_enum::error,
+                         [this] (int, uint32_t events) { this->handle_events(events); });
+    }
+
+    try
+    {
+        // A blocked writer waits for the write event instead of
+        // flushing every iteration
+        this->iteration_ = loop.add_iteration_handler([this] () {
+                                                          if (!this->blocked_ && this->buffered_ > 0)
+                                                          {
+                                                              this->flush_attached();
+                                                          }
+                                                      },
+                                                      [this] () {
+                                                          return !this->blocked_ && this->buffered_ > 0;
+                                                      });
+    }
+    catch (...)
+    {
+        if (events_handler)
+        {
+            loop.remove_handler(this->fd_);
+        }
+
+        throw;
+    }
+
+    this->error_handler_ = std::move(handler);
+    this->event_handler_ = std::move(events_handler);
+    this->loop_ = &loop;
+}
+
+void
+linuxpp::buffered_writer::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    this->loop_->remove_iteration_handler(this->iteration_);
+    if (this->event_handler_ || this->blocked_)
+    {
+        this->loop_->remove_handler(this->fd_);
+    }
+
+    this->blocked_ = false;
+    this->event_handler_ = nullptr;
+    this->loop_ = nullptr;
+}
+
+int
+linuxpp::buffered_writer::descriptor() const noexcept
+{
+    return this->fd_;
+}
+
+bool
+linuxpp::buffered_writer::flush_attached()
+{
+    std::size_t attempted = 0;
+    for (std::size_t i = 0; i < this->chunks_.size() && i < IOV_MAX; ++i)
+    {
+        attempted += this->chunks_[i].end - this->chunks_[i].begin;
+    }
+
+    const auto ret = this->flush();
+    if (!ret)
+    {
+        if (ret.errno_value() == EAGAIN || ret.errno_value() == EWOULDBLOCK)
+        {
+            this->set_blocked(true);
+        }
+        else if (ret.errno_value() != EINTR)
+        {
+            this->fail(ret.errno_value());
+            return false;
+        }
+
+        return true;
+    }
+
+    // A short write means the descriptor is full, otherwise the rest
+    // of the backlog is flushed in the next iteration
+    this->set_blocked(static_cast<std::size_t>(ret.return_value()) < attempted);
+    return true;
+}
+
+void
+linuxpp::buffered_writer::set_blocked(const bool blocked)
+{
+    if (blocked == this->blocked_)
+    {
+        return;
+    }
+
+    if (this->event_handler_)
+    {
+        this->loop_->modify_handler(this->fd_,
+                                    linuxpp::ioloop::event_enum::read |
+                                    linuxpp::ioloop::event_enum::error |
+                                    (blocked ? linuxpp::ioloop::event_enum::write : 0));
+    }
+    else if (blocked)
+    {
+        this->loop_->add_handler(this->fd_,
+                                 linuxpp::ioloop::event_enum::write | linuxpp::ioloop::event_enum::error,
+                                 [this] (int, uint32_t events) { this->handle_events(events); });
+    }
+    else
+    {
+        this->loop_->remove_handler(this->fd_);
+    }
+
+    this->blocked_ = blocked;
+}
+
+void
+linuxpp::buffered_writer::handle_events(const uint32_t events)
+{
+    if (this->blocked_ &&
+        (events & (linuxpp::ioloop::event_enum::write | linuxpp::ioloop::event_enum::error)) != 0)
+    {
+        if (!this->flush_attached())
+        {
+            // The writer may have been destroyed by the error handler
+            return;
+        }
+    }
+
+    if (this->event_handler_ &&
+        (events & (linuxpp::ioloop::event_enum::read | linuxpp::ioloop::event_enum::error)) != 0)
+    {
+        this->event_handler_(this->fd_, events);
+    }
+}
+
+void
+linuxpp::buffered_writer::fail(const int errno_value)
+{
+    this->set_blocked(false);
+    this->error_ = errno_value;
+    this->chunks_.clear();
+    this->buffered_ = 0;
+    this->above_high_watermark_ = false;
+    if (this->error_handler_)
+    {
+        this->error_handler_(errno_value);
+    }
+}
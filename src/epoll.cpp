@@ -192,14 +192,29 @@ void linuxpp::epoll::wait(std::vector<epoll_event>& events, const int timeout)
 }
 
 linuxpp::syscall_return<int> linuxpp::epoll::wait(std::nothrow_t, std::vector<epoll_event> & events)
+{
+    return this->wait(std::nothrow, events, -1);
+}
+
+linuxpp::syscall_return<int> linuxpp::epoll::wait(std::nothrow_t,
+                                                  std::vector<epoll_event> & events,
+                                                  const std::chrono::milliseconds timeout)
+{
+    return this->wait(std::nothrow, events, static_cast<int>(timeout.count()));
+}
+
+linuxpp::syscall_return<int> linuxpp::epoll::wait(std::nothrow_t,
+                                                  std::vector<epoll_event> & events,
+                                                  const int timeout)
 {
     events.resize(std::get<size_events>(this->members_));
     const int ret = ::epoll_wait(std::get<epoll_fd>(this->members_).get(),
                                  events.data(),
                                  events.size(),
-                                 -1);
+                                 timeout);
     if (ret == -1)
     {
+        events.clear();
         return linuxpp::syscall_return<int> {errno, ret};
     }
 
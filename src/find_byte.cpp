@@ -0,0 +1,125 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LIBLINUXPP_FIND_BYTE_X86 1
+#endif
+
+#include <liblinuxpp/find_byte.hpp>
+
+namespace
+{
+    char const * find_scalar(char const * first,
+                             char const * const last,
+                             const char value) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            if (*first == value)
+            {
+                return first;
+            }
+        }
+
+        return last;
+    }
+
+#ifdef LIBLINUXPP_FIND_BYTE_X86
+
+    __attribute__((target("sse2")))
+    char const * find_sse2(char const * first,
+                           char const * const last,
+                           const char value) noexcept
+    {
+        const __m128i needle = _mm_set1_epi8(value);
+        while (last - first >= 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(first));
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+            if (mask != 0)
+            {
+                return first + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+
+            first += 16;
+        }
+
+        return ::find_scalar(first, last, value);
+    }
+
+    __attribute__((target("avx2")))
+    char const * find_avx2(char const * first,
+                           char const * const last,
+                           const char value) noexcept
+    {
+        const __m256i needle = _mm256_set1_epi8(value);
+        while (last - first >= 32)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first));
+            const int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+            if (mask != 0)
+            {
+                return first + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+
+            first += 32;
+        }
+
+        // The tail is shorter than an AVX2 register
+        return ::find_sse2(first, last, value);
+    }
+
+#endif
+
+    linuxpp::find_byte_isa detect_isa() noexcept
+    {
+#ifdef LIBLINUXPP_FIND_BYTE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return linuxpp::find_byte_isa::avx2;
+        }
+
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return linuxpp::find_byte_isa::sse2;
+        }
+#endif
+        return linuxpp::find_byte_isa::scalar;
+    }
+
+    // Scalar until it's initialized, which keeps find_byte correct
+    // when called from other static initializers
+    const linuxpp::find_byte_isa supported_isa = ::detect_isa();
+}
+
+linuxpp::find_byte_isa
+linuxpp::find_byte_supported() noexcept
+{
+    return ::supported_isa;
+}
+
+char const *
+linuxpp::find_byte(char const * const first,
+                   char const * const last,
+                   const char value) noexcept
+{
+    return linuxpp::find_byte(::supported_isa, first, last, value);
+}
+
+char const *
+linuxpp::find_byte(const linuxpp::find_byte_isa isa,
+                   char const * const first,
+                   char const * const last,
+                   const char value) noexcept
+{
+    switch (isa)
+    {
+#ifdef LIBLINUXPP_FIND_BYTE_X86
+        case linuxpp::find_byte_isa::avx2:
+            return ::find_avx2(first, last, value);
+        case linuxpp::find_byte_isa::sse2:
+            return ::find_sse2(first, last, value);
+#endif
+        default:
+            return ::find_scalar(first, last, value);
+    }
+}
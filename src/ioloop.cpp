@@ -1,4 +1,8 @@
+#include <pthread.h>
+#include <signal.h>
 #include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
 
 #include <cerrno>
 
@@ -18,7 +22,22 @@ uint32_t epoll_events(uint32_t ioloop_events)
     return
         (ioloop_events & linuxpp::ioloop::event_enum::read ? EPOLLIN : 0) |
         (ioloop_events & linuxpp::ioloop::event_enum::write ? EPOLLOUT : 0) |
-        (ioloop_events & linuxpp::ioloop::event_enum::error ? EPOLLERR : 0);
+        (ioloop_events & linuxpp::ioloop::event_enum::error ? EPOLLERR : 0) |
+        (ioloop_events & linuxpp::ioloop::event_enum::exclusive ? EPOLLEXCLUSIVE : 0);
+}
+
+/// Converts the events reported by epoll to ioloop::event_enum values
+static uint32_t ioloop_events(const uint32_t epoll_events,
+                              const uint32_t registered_events)
+{
+    // A hang up is reported as readable to the handlers interested
+    // in reading, since a read will report the end of file
+    const bool hangup = epoll_events & EPOLLHUP;
+    return
+        (epoll_events & EPOLLIN || (hangup && registered_events & linuxpp::ioloop::event_enum::read) ?
+         linuxpp::ioloop::event_enum::read : 0) |
+        (epoll_events & EPOLLOUT ? linuxpp::ioloop::event_enum::write : 0) |
+        (epoll_events & EPOLLERR || hangup ? linuxpp::ioloop::event_enum::error : 0);
 }
 
 unsigned long long linuxpp::ioloop::timeout_handle::next_id_ = 0;
@@ -34,9 +53,27 @@ linuxpp::ioloop::periodic_timeout_handle::periodic_timeout_handle():
     id_(linuxpp::ioloop::periodic_timeout_handle::next_id_++)
 {}
 
+unsigned long long linuxpp::ioloop::batch_group_handle::next_id_ = 0;
+
+linuxpp::ioloop::batch_group_handle::batch_group_handle():
+    id_(linuxpp::ioloop::batch_group_handle::next_id_++)
+{}
+
+unsigned long long linuxpp::ioloop::iteration_handle::next_id_ = 0;
+
+linuxpp::ioloop::iteration_handle::iteration_handle():
+    id_(linuxpp::ioloop::iteration_handle::next_id_++)
+{}
+
 linuxpp::ioloop::ioloop():
-    callbacks_eventfd_(EFD_NONBLOCK)
+    timeout_timerfd_(TFD_NONBLOCK),
+    periodic_timeout_timerfd_(TFD_NONBLOCK),
+    callbacks_eventfd_(EFD_NONBLOCK),
+    signalfd_(SFD_NONBLOCK),
+    signal_infos_(32)
 {
+    sigemptyset(&this->signal_mask_);
+
     this->add_handler(this->callbacks_eventfd_.fd(),
                       linuxpp::ioloop::event_enum::read,
                       std::bind(&linuxpp::ioloop::process_callbacks, this));
@@ -52,6 +89,14 @@ linuxpp::ioloop::ioloop():
     this->add_handler(this->periodic_timeout_timerfd_.fd(),
                       linuxpp::ioloop::event_enum::read,
                       std::bind(&linuxpp::ioloop::process_periodic_timeouts, this));
+
+    this->add_handler(this->wakeup_notifier_.fd(),
+                      linuxpp::ioloop::event_enum::read,
+                      std::bind(&linuxpp::ioloop::process_wakeup, this));
+
+    this->add_handler(this->signalfd_.fd(),
+                      linuxpp::ioloop::event_enum::read,
+                      std::bind(&linuxpp::ioloop::process_signals, this));
 }
 
 void
@@ -78,15 +123,68 @@ linuxpp::ioloop::add_callback(std::function<void ()> callback)
 }
 
 void
-linuxpp::ioloop::add_handler(const int fd,
-                             const uint32_t events,
-                             std::function<void (int, uint32_t)> callback)
+linuxpp::ioloop::epoll_del_handler(const int fd)
+{
+    const auto epoll_ret = this->epoll_.del(std::nothrow, fd);
+    if (!epoll_ret)
+    {
+        if (epoll_ret.errno_value() != ENOENT && epoll_ret.errno_value() != EBADF)
+        {
+            // Something weird happened
+            throw ndgpp_error(std::system_error,
+                              std::error_code{epoll_ret.errno_value(), std::system_category()},
+                              "linuxpp::ioloop::epoll_.del(...) failed");
+        }
+
+        // At this point the file descriptor was closed prior to its
+        // handler being removed, which also removed it from epoll, so
+        // the epoll_del error is acceptable
+    }
+}
+
+void
+linuxpp::ioloop::prune_handler(linuxpp::ioloop::handler_map_type::iterator handler)
+{
+    const int fd = handler->first;
+    this->epoll_del_handler(fd);
+
+    const auto group = handler->second->group;
+    if (group != nullptr)
+    {
+        group->ready.erase(std::remove_if(group->ready.begin(),
+                                          group->ready.end(),
+                                          [fd] (const linuxpp::ioloop::batch_event & event)
+                                          {
+                                              return event.fd == fd;
+                                          }),
+                           group->ready.end());
+    }
+
+    this->removed_handlers_.erase(std::remove(this->removed_handlers_.begin(),
+                                              this->removed_handlers_.end(),
+                                              fd),
+                                  this->removed_handlers_.end());
+
+    // Events of the current iteration may still point to the
+    // handler, which stays marked as removed until the iteration ends
+    this->pruned_handlers_.push_back(std::move(handler->second));
+    this->handlers_.erase(handler);
+}
+
+void
+linuxpp::ioloop::insert_handler(const int fd,
+                                const uint32_t events,
+                                linuxpp::ioloop::handler_callback handler)
 {
-    const auto ret =
-        this->handlers_.emplace(fd,
-                                linuxpp::ioloop::handler_callback {
-                                        events,
-                                        std::move(callback)});
+    const auto removed = this->handlers_.find(fd);
+    if (removed != this->handlers_.end() && removed->second->removed)
+    {
+        this->prune_handler(removed);
+    }
+
+    handler.fd = fd;
+    const auto ret = this->handlers_.emplace(fd, std::unique_ptr<linuxpp::ioloop::handler_callback> {
+            new linuxpp::ioloop::handler_callback {std::move(handler)}});
     if (!ret.second)
     {
         throw ndgpp_error(std::runtime_error,
@@ -95,7 +193,7 @@ linuxpp::ioloop::add_handler(const int fd,
 
     try
     {
-        this->epoll_.add(fd, ::epoll_events(events), &(*ret.first));
+        this->epoll_.add(fd, ::epoll_events(events), ret.first->second.get());
     }
     catch (...)
     {
@@ -104,6 +202,18 @@ linuxpp::ioloop::add_handler(const int fd,
     }
 }
 
+void
+linuxpp::ioloop::add_handler(const int fd,
+                             const uint32_t events,
+                             std::function<void (int, uint32_t)> callback)
+{
+    this->insert_handler(fd,
+                         events,
+                         linuxpp::ioloop::handler_callback {
+                             events,
+                             std::move(callback)});
+}
+
 void
 linuxpp::ioloop::remove_handler(const int fd)
 {
@@ -116,34 +226,47 @@ linuxpp::ioloop::remove_handler(const int fd)
 
     if (this->processing_handlers_)
     {
+        if (handler->second->removed)
+        {
+            return;
+        }
+
         // postpone removal until the ioloop is done processing the
         // handlers
+        handler->second->removed = true;
         this->removed_handlers_.push_back(fd);
     }
+    else if (handler->second->removed)
+    {
+        // removed while processing the handlers, e.g. again from an
+        // iteration handler, so it's still in removed_handlers_
+        this->prune_handler(handler);
+    }
     else
     {
         this->handlers_.erase(handler);
-        const auto epoll_ret = this->epoll_.del(std::nothrow, fd);
-        if (!epoll_ret)
-        {
-            if (epoll_ret.errno_value() != ENOENT)
-            {
-                // Something weird happened
-                throw ndgpp_error(std::system_error,
-                                  std::error_code{epoll_ret.errno_value(), std::system_category()},
-                                  "linuxpp::epoll_.del(...) failed in linuxpp::ioloop::remove_handler");
-            }
+        this->epoll_del_handler(fd);
+    }
+}
 
-            // At this point the file descriptor was closed prior
-            // to its handler being removed so the epoll_del error
-            // is acceptable
-        }
+void
+linuxpp::ioloop::modify_handler(const int fd, const uint32_t events)
+{
+    auto handler = this->handlers_.find(fd);
+    if (handler == this->handlers_.end() || handler->second->removed)
+    {
+        throw ndgpp_error(std::runtime_error,
+                          "failed to modify handler: fd is not handled");
     }
+
+    this->epoll_.mod(fd, ::epoll_events(events), handler->second.get());
+    handler->second->events = events;
 }
 
 linuxpp::ioloop::timeout_handle
 linuxpp::ioloop::insert_timeout(const linuxpp::ioloop::time_type timeout,
-                                std::function<void ()> callback)
+                                std::function<void ()> callback,
+                                const bool precise)
 {
     const auto later_timeout = std::lower_bound(this->timeouts_.cbegin(),
                                                 this->timeouts_.cend(),
@@ -152,13 +275,30 @@ linuxpp::ioloop::insert_timeout(const linuxpp::ioloop::time_type timeout,
     const auto entry = this->timeouts_.emplace(later_timeout,
                                                linuxpp::ioloop::timeout_handle {},
                                                timeout,
-                                               std::move(callback));
+                                               std::move(callback),
+                                               precise);
     return entry->handle;
 }
 
 linuxpp::ioloop::timeout_handle
 linuxpp::ioloop::add_timeout(const linuxpp::ioloop::time_type timeout,
                              std::function<void ()> callback)
+{
+    return this->add_timeout(timeout, std::move(callback), false);
+}
+
+linuxpp::ioloop::timeout_handle
+linuxpp::ioloop::add_timeout(linuxpp::precise_t,
+                             const linuxpp::ioloop::time_type timeout,
+                             std::function<void ()> callback)
+{
+    return this->add_timeout(timeout, std::move(callback), true);
+}
+
+linuxpp::ioloop::timeout_handle
+linuxpp::ioloop::add_timeout(const linuxpp::ioloop::time_type timeout,
+                             std::function<void ()> callback,
+                             const bool precise)
 {
     if (this->processing_timeouts_)
     {
@@ -167,34 +307,83 @@ linuxpp::ioloop::add_timeout(const linuxpp::ioloop::time_type timeout,
 
         this->pending_timeout_additions_.emplace_back(linuxpp::ioloop::timeout_handle {},
                                                       timeout,
-                                                      std::move(callback));
+                                                      std::move(callback),
+                                                      precise);
 
         return this->pending_timeout_additions_.back().handle;
     }
 
-    if (this->timeouts_.empty())
+    const auto handle = this->insert_timeout(timeout, std::move(callback), precise);
+
+    // Only re-arm the timer if the new timeout needs an earlier
+    // wakeup
+    const auto wakeup_time = precise ? timeout - this->precise_timeout_margin_ : timeout;
+    if (wakeup_time < this->timeout_timer_armed_time_)
     {
-        this->timeouts_.emplace_back(linuxpp::ioloop::timeout_handle {},
-                                     timeout,
-                                     std::move(callback));
-        this->timeout_timerfd_.set_oneshot(timeout);
-        return this->timeouts_.back().handle;
+        this->arm_timeout_timer(wakeup_time);
     }
 
-    // At this point we're not processing timeouts and timeouts
-    // already exist, so see if we'll need to re-arm the timer based
-    // on the new timeout
+    return handle;
+}
 
-    const auto current_earliest_timeout = this->timeouts_.front().timeout;
-    const auto handle = this->insert_timeout(timeout, callback);
+linuxpp::ioloop::time_type
+linuxpp::ioloop::timeout_wakeup_time() const
+{
+    if (this->timeouts_.empty())
+    {
+        return linuxpp::ioloop::time_type::max();
+    }
 
-    if (current_earliest_timeout > timeout)
+    // Precise timeouts need to wake up the ioloop early, so a
+    // precise timeout that's within the margin of the earliest
+    // timeout may need the earliest wakeup
+    auto wakeup_time = this->timeouts_.front().timeout;
+    for (const auto & timeout : this->timeouts_)
     {
-        // Re-arm the timer with the earlier timeout
-        this->timeout_timerfd_.set_oneshot(timeout);
+        const auto early_wakeup_time = timeout.timeout - this->precise_timeout_margin_;
+        if (early_wakeup_time >= wakeup_time)
+        {
+            break;
+        }
+
+        if (timeout.precise && !timeout.remove)
+        {
+            wakeup_time = early_wakeup_time;
+        }
     }
 
-    return handle;
+    return wakeup_time;
+}
+
+void
+linuxpp::ioloop::arm_timeout_timer(const linuxpp::ioloop::time_type wakeup_time)
+{
+    this->timeout_timerfd_.set_oneshot(wakeup_time);
+    this->timeout_timer_armed_time_ = wakeup_time;
+}
+
+std::chrono::nanoseconds
+linuxpp::ioloop::precise_timeout_margin() const noexcept
+{
+    return this->precise_timeout_margin_;
+}
+
+void
+linuxpp::ioloop::update_precise_timeout_margin(const std::chrono::nanoseconds lateness)
+{
+    // Track the lateness with a smoothed mean and mean deviation
+    // like TCP's RTT estimator (RFC 6298), and wake up early enough
+    // to cover nearly all of the observed lateness
+    constexpr std::chrono::nanoseconds min_margin {10000};
+    constexpr std::chrono::nanoseconds max_margin {1000000};
+
+    const auto error = lateness - this->timer_lateness_;
+    this->timer_lateness_ += error / 8;
+    this->timer_lateness_deviation_ +=
+        ((error < std::chrono::nanoseconds::zero() ? -error : error) - this->timer_lateness_deviation_) / 4;
+
+    const auto margin = this->timer_lateness_ + 4 * this->timer_lateness_deviation_;
+    this->precise_timeout_margin_ = std::min(std::max(margin, min_margin), max_margin);
 }
 
 void
@@ -236,35 +425,83 @@ linuxpp::ioloop::remove_timeout(const linuxpp::ioloop::timeout_handle handle)
 void
 linuxpp::ioloop::process_timeouts()
 {
-    this->timeout_timerfd_.read();
+    const auto read_ret = this->timeout_timerfd_.read(std::nothrow);
+    if (!read_ret)
+    {
+        if (read_ret.errno_value() == EAGAIN)
+        {
+            // The timer was re-armed after it expired, so there's
+            // nothing to do until it expires again
+            return;
+        }
+
+        throw ndgpp_error(std::system_error,
+                          std::error_code{read_ret.errno_value(), std::system_category()},
+                          "failed to read ioloop's timeout timerfd");
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (this->timeout_timer_armed_time_ <= now)
+    {
+        this->update_precise_timeout_margin(now - this->timeout_timer_armed_time_);
+    }
+
+    this->timeout_timer_armed_time_ = linuxpp::ioloop::time_type::max();
 
     {
         ndgpp::bool_sentry sentry {this->processing_timeouts_};
         this->processing_timeouts_ = true;
 
+        // Precise timeouts within the margin are spun on, so they
+        // have to be considered expired now, and so do the regular
+        // timeouts before them.  Otherwise the timer is re-armed for
+        // the early wakeup that already passed, and fires until the
+        // regular timeout is due.
+        const auto horizon = now + this->precise_timeout_margin_;
+        auto spin_until = linuxpp::ioloop::time_type::min();
+        for (const auto & timeout : this->timeouts_)
+        {
+            if (timeout.timeout > horizon)
+            {
+                break;
+            }
+
+            if (timeout.precise && !timeout.remove)
+            {
+                spin_until = timeout.timeout;
+            }
+        }
+
         auto i = this->timeouts_.begin();
-        const auto now = std::chrono::steady_clock::now();
         while (i != this->timeouts_.end())
         {
             auto & timeout_callback = *i;
-            ++i;
 
             if (timeout_callback.remove)
             {
+                ++i;
                 continue;
             }
 
-            if (timeout_callback.timeout <= now)
-            {
-                // timeout expired, so call its call back
-                timeout_callback.callback();
-            }
-            else
+            if (timeout_callback.timeout > now)
             {
-                // this timeout and the remaining timeouts have not
-                // expired so stop calling timeout callbacks
-                break;
+                if (timeout_callback.timeout > spin_until)
+                {
+                    // this timeout and the remaining timeouts have
+                    // not expired so stop calling timeout callbacks
+                    break;
+                }
+
+                // spin until the timeout expires
+                while ((now = std::chrono::steady_clock::now()) < timeout_callback.timeout)
+                {
+                }
             }
+
+            ++i;
+
+            // timeout expired, so call its call back
+            timeout_callback.callback();
         }
 
         // remove the exipired timeouts
@@ -294,7 +531,7 @@ linuxpp::ioloop::process_timeouts()
 
     if (!this->timeouts_.empty())
     {
-        this->timeout_timerfd_.set_oneshot(this->timeouts_.front().timeout);
+        this->arm_timeout_timer(this->timeout_wakeup_time());
     }
 }
 
@@ -335,7 +572,20 @@ linuxpp::ioloop::remove_timeout(const linuxpp::ioloop::periodic_timeout_handle h
 void
 linuxpp::ioloop::process_periodic_timeouts()
 {
-    this->periodic_timeout_timerfd_.read();
+    const auto read_ret = this->periodic_timeout_timerfd_.read(std::nothrow);
+    if (!read_ret)
+    {
+        if (read_ret.errno_value() == EAGAIN)
+        {
+            // The timer was re-armed after it expired, so there's
+            // nothing to do until it expires again
+            return;
+        }
+
+        throw ndgpp_error(std::system_error,
+                          std::error_code{read_ret.errno_value(), std::system_category()},
+                          "failed to read ioloop's periodic timeout timerfd");
+    }
 
     {
         ndgpp::bool_sentry sentry {this->processing_periodic_timeouts_};
@@ -441,6 +691,361 @@ linuxpp::ioloop::process_callbacks()
     }
 }
 
+void
+linuxpp::ioloop::add_signal_handler(const int signo,
+                                    std::function<void (const signalfd_siginfo &)> callback)
+{
+    const auto ret = this->signal_handlers_.emplace(signo, std::move(callback));
+    if (!ret.second)
+    {
+        throw ndgpp_error(std::runtime_error,
+                          "failed to insert signal handler: signal is already handled");
+    }
+
+    sigset_t signal;
+    sigemptyset(&signal);
+    sigaddset(&signal, signo);
+
+    const int sigmask_ret = ::pthread_sigmask(SIG_BLOCK, &signal, nullptr);
+    if (sigmask_ret != 0)
+    {
+        this->signal_handlers_.erase(ret.first);
+        throw ndgpp_error(std::system_error,
+                          std::error_code{sigmask_ret, std::system_category()},
+                          "failed to block signal");
+    }
+
+    sigset_t new_mask = this->signal_mask_;
+    sigaddset(&new_mask, signo);
+
+    try
+    {
+        this->signalfd_.set_mask(new_mask);
+    }
+    catch (...)
+    {
+        this->signal_handlers_.erase(signo);
+        throw;
+    }
+
+    this->signal_mask_ = new_mask;
+}
+
+void
+linuxpp::ioloop::remove_signal_handler(const int signo)
+{
+    auto handler = this->signal_handlers_.find(signo);
+    if (handler == this->signal_handlers_.end())
+    {
+        return;
+    }
+
+    sigset_t new_mask = this->signal_mask_;
+    sigdelset(&new_mask, signo);
+    this->signalfd_.set_mask(new_mask);
+    this->signal_mask_ = new_mask;
+
+    if (this->processing_signal_handlers_)
+    {
+        // The handler may be the one that's being called, so
+        // postpone its removal
+        this->removed_signal_handlers_.push_back(signo);
+    }
+    else
+    {
+        this->signal_handlers_.erase(handler);
+    }
+}
+
+void
+linuxpp::ioloop::process_signals()
+{
+    {
+        ndgpp::bool_sentry sentry {this->processing_signal_handlers_};
+        this->processing_signal_handlers_ = true;
+
+        while (true)
+        {
+            const auto ret = this->signalfd_.read(std::nothrow,
+                                                  this->signal_infos_.data(),
+                                                  this->signal_infos_.size());
+            if (!ret)
+            {
+                if (ret.errno_value() == EAGAIN || ret.errno_value() == EINTR)
+                {
+                    break;
+                }
+
+                throw ndgpp_error(std::system_error,
+                                  std::error_code{ret.errno_value(), std::system_category()},
+                                  "failed to read from ioloop's signalfd");
+            }
+
+            const std::size_t count = ret.return_value();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const signalfd_siginfo & info = this->signal_infos_[i];
+                const int signo = static_cast<int>(info.ssi_signo);
+                if (std::find(this->removed_signal_handlers_.cbegin(),
+                              this->removed_signal_handlers_.cend(),
+                              signo) != this->removed_signal_handlers_.cend())
+                {
+                    continue;
+                }
+
+                const auto handler = this->signal_handlers_.find(signo);
+                if (handler != this->signal_handlers_.end())
+                {
+                    handler->second(info);
+                }
+            }
+
+            if (count < this->signal_infos_.size())
+            {
+                // The signalfd has been drained
+                break;
+            }
+        }
+    }
+
+    for (const auto signo : this->removed_signal_handlers_)
+    {
+        this->signal_handlers_.erase(signo);
+    }
+
+    this->removed_signal_handlers_.clear();
+}
+
+linuxpp::ioloop::batch_group_handle
+linuxpp::ioloop::add_batch_group(linuxpp::ioloop::batch_callback callback)
+{
+    this->batch_groups_.emplace_back(new linuxpp::ioloop::batch_group {
+            linuxpp::ioloop::batch_group_handle {},
+            std::move(callback)});
+
+    return this->batch_groups_.back()->handle;
+}
+
+void
+linuxpp::ioloop::remove_batch_group(const linuxpp::ioloop::batch_group_handle handle)
+{
+    const auto group = std::find_if(this->batch_groups_.begin(),
+                                    this->batch_groups_.end(),
+                                    [handle] (const std::unique_ptr<linuxpp::ioloop::batch_group> & g)
+                                    {
+                                        return g->handle == handle;
+                                    });
+
+    if (group == this->batch_groups_.end())
+    {
+        return;
+    }
+
+    std::vector<int> fds;
+    for (const auto & handler : this->handlers_)
+    {
+        if (handler.second->group == group->get() && !handler.second->removed)
+        {
+            fds.push_back(handler.first);
+        }
+    }
+
+    for (const auto fd : fds)
+    {
+        this->remove_handler(fd);
+    }
+
+    if (this->processing_handlers_)
+    {
+        // The group may be ready or its callback may be running, so
+        // postpone its destruction
+        (*group)->remove = true;
+    }
+    else
+    {
+        this->batch_groups_.erase(group);
+    }
+}
+
+void
+linuxpp::ioloop::add_batch_handler(const linuxpp::ioloop::batch_group_handle handle,
+                                   const int fd,
+                                   const uint32_t events,
+                                   void * const user_data)
+{
+    const auto group = std::find_if(this->batch_groups_.begin(),
+                                    this->batch_groups_.end(),
+                                    [handle] (const std::unique_ptr<linuxpp::ioloop::batch_group> & g)
+                                    {
+                                        return g->handle == handle && !g->remove;
+                                    });
+
+    if (group == this->batch_groups_.end())
+    {
+        throw ndgpp_error(std::runtime_error,
+                          "failed to insert batch handler: batch group does not exist");
+    }
+
+    this->insert_handler(fd,
+                         events,
+                         linuxpp::ioloop::handler_callback {
+                             events,
+                             group->get(),
+                             user_data});
+}
+
+void
+linuxpp::ioloop::process_batch_groups()
+{
+    for (auto group : this->ready_batch_groups_)
+    {
+        if (!group->remove)
+        {
+            // Skip the file descriptors removed by an earlier
+            // callback in this iteration
+            group->ready.erase(std::remove_if(group->ready.begin(),
+                                              group->ready.end(),
+                                              [this] (const linuxpp::ioloop::batch_event & event)
+                                              {
+                                                  return this->handlers_.at(event.fd)->removed;
+                                              }),
+                               group->ready.end());
+
+            if (!group->ready.empty())
+            {
+                group->callback(group->ready.data(), group->ready.size());
+            }
+        }
+
+        group->ready.clear();
+    }
+
+    this->ready_batch_groups_.clear();
+}
+
+linuxpp::ioloop::iteration_handle
+linuxpp::ioloop::add_iteration_handler(std::function<void ()> callback,
+                                       std::function<bool ()> pending)
+{
+    if (this->processing_iteration_handlers_)
+    {
+        this->pending_iteration_handler_additions_.emplace_back(linuxpp::ioloop::iteration_handle {},
+                                                                std::move(callback),
+                                                                std::move(pending));
+        return this->pending_iteration_handler_additions_.back().handle;
+    }
+
+    this->iteration_handlers_.emplace_back(linuxpp::ioloop::iteration_handle {},
+                                           std::move(callback),
+                                           std::move(pending));
+    return this->iteration_handlers_.back().handle;
+}
+
+void
+linuxpp::ioloop::remove_iteration_handler(const linuxpp::ioloop::iteration_handle handle)
+{
+    for (auto it = this->iteration_handlers_.begin();
+         it != this->iteration_handlers_.end();
+         ++it)
+    {
+        if (it->handle == handle)
+        {
+            if (this->processing_iteration_handlers_)
+            {
+                it->remove = true;
+            }
+            else
+            {
+                this->iteration_handlers_.erase(it);
+            }
+
+            return;
+        }
+    }
+
+    for (auto it = this->pending_iteration_handler_additions_.begin();
+         it != this->pending_iteration_handler_additions_.end();
+         ++it)
+    {
+        if (it->handle == handle)
+        {
+            this->pending_iteration_handler_additions_.erase(it);
+            return;
+        }
+    }
+}
+
+void
+linuxpp::ioloop::process_iteration_handlers()
+{
+    {
+        ndgpp::bool_sentry sentry {this->processing_iteration_handlers_};
+        this->processing_iteration_handlers_ = true;
+
+        for (auto & handler : this->iteration_handlers_)
+        {
+            if (!handler.remove)
+            {
+                handler.callback();
+            }
+        }
+    }
+
+    this->iteration_handlers_.erase(std::remove_if(this->iteration_handlers_.begin(),
+                                                   this->iteration_handlers_.end(),
+                                                   [] (const linuxpp::ioloop::iteration_callback & handler)
+                                                   {
+                                                       return handler.remove == true;
+                                                   }),
+                                    this->iteration_handlers_.end());
+
+    for (auto & new_handler : this->pending_iteration_handler_additions_)
+    {
+        this->iteration_handlers_.push_back(std::move(new_handler));
+    }
+
+    this->pending_iteration_handler_additions_.clear();
+}
+
+int
+linuxpp::ioloop::prepare_sleep()
+{
+    // Declare that the ioloop is about to sleep before checking the
+    // pending functions, so either the pending check observes the
+    // other thread's work, or the other thread's wakeup observes the
+    // ioloop sleeping and writes to the notifier's eventfd.
+    this->wakeup_notifier_.prepare_wait();
+
+    for (const auto & handler : this->iteration_handlers_)
+    {
+        if (handler.pending())
+        {
+            this->wakeup_notifier_.finish_wait();
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+bool
+linuxpp::ioloop::sleeping() const noexcept
+{
+    return this->wakeup_notifier_.sleeping();
+}
+
+bool
+linuxpp::ioloop::wakeup()
+{
+    return this->wakeup_notifier_.notify();
+}
+
+void
+linuxpp::ioloop::process_wakeup()
+{
+    this->wakeup_notifier_.consume();
+}
+
 void
 linuxpp::ioloop::start()
 {
@@ -449,7 +1054,13 @@ linuxpp::ioloop::start()
     while (this->keep_running_)
     {
         // process the handlers
-        const auto ret = this->epoll_.wait(std::nothrow, this->epoll_events_);
+        const int timeout = this->prepare_sleep();
+        const auto ret = this->epoll_.wait(std::nothrow, this->epoll_events_, std::chrono::milliseconds {timeout});
+        if (timeout != 0)
+        {
+            this->wakeup_notifier_.finish_wait();
+        }
+
         if (! ret)
         {
             if (ret.errno_value() == EINTR)
@@ -465,11 +1076,45 @@ linuxpp::ioloop::start()
 
             for (const auto & event: this->epoll_events_)
             {
-                auto handler = static_cast<linuxpp::ioloop::handler_map_type::value_type *> (event.data.ptr);
-                handler->second.callback(handler->first, handler->second.events);
+                auto handler = static_cast<linuxpp::ioloop::handler_callback *> (event.data.ptr);
+                if (handler->removed)
+                {
+                    continue;
+                }
+
+                const uint32_t events = ::ioloop_events(event.events, handler->events);
+                auto group = handler->group;
+                if (group == nullptr)
+                {
+                    handler->callback(handler->fd, events);
+                    continue;
+                }
+
+                if (group->ready.empty())
+                {
+                    this->ready_batch_groups_.push_back(group);
+                }
+
+                group->ready.push_back(linuxpp::ioloop::batch_event {handler->fd,
+                                                                     events,
+                                                                     handler->user_data});
             }
+
+            this->process_batch_groups();
         }
 
+        // destroy the batch groups removed while processing handlers
+        this->batch_groups_.erase(std::remove_if(this->batch_groups_.begin(),
+                                                 this->batch_groups_.end(),
+                                                 [] (const std::unique_ptr<linuxpp::ioloop::batch_group> & group)
+                                                 {
+                                                     return group->remove;
+                                                 }),
+                                  this->batch_groups_.end());
+
+        this->process_iteration_handlers();
+        this->pruned_handlers_.clear();
+
         if (this->removed_handlers_.empty())
         {
             continue;
@@ -478,22 +1123,7 @@ linuxpp::ioloop::start()
         // prune any handlers marked for removal
         for (auto handler : this->removed_handlers_)
         {
-            const auto epoll_ret = this->epoll_.del(std::nothrow, handler);
-            if (!epoll_ret)
-            {
-                if (epoll_ret.errno_value() != ENOENT)
-                {
-                    // Something weird happened
-                    throw ndgpp_error(std::system_error,
-                                      std::error_code{epoll_ret.errno_value(), std::system_category()},
-                                      "linuxpp::ioloop::epoll_.del(...) failed in linuxpp::ioloop::start");
-                }
-
-                // At this point the file descriptor was closed prior
-                // to its handler being removed so the epoll_del error
-                // is acceptable
-            }
-
+            this->epoll_del_handler(handler);
             this->handlers_.erase(handler);
         }
 
@@ -501,6 +1131,19 @@ linuxpp::ioloop::start()
     }
 }
 
+void
+linuxpp::ioloop::start(const linuxpp::thread_tuning & tuning,
+                       std::function<void (const linuxpp::thread_tuning_result &)> report)
+{
+    const auto result = tuning.apply();
+    if (report)
+    {
+        report(result);
+    }
+
+    this->start();
+}
+
 void
 linuxpp::ioloop::stop()
 {
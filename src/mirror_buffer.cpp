@@ -0,0 +1,212 @@
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <initializer_list>
+#include <stdexcept>
+#include <system_error>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/mirror_buffer.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+namespace
+{
+    std::size_t round_to_pages(const std::size_t size)
+    {
+        const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return (size + page_size - 1) / page_size * page_size;
+    }
+
+    [[noreturn]] void throw_system_error(const char * const message)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code (errno, std::system_category()),
+                          message);
+    }
+
+    /// Maps the memory twice in a row and returns the first mapping
+    char * map_mirrored(const std::size_t capacity)
+    {
+        const linuxpp::unique_fd<> memory {::memfd_create("liblinuxpp-mirror_buffer", MFD_CLOEXEC)};
+        if (!memory)
+        {
+            ::throw_system_error("failed to create the mirror_buffer's memory");
+        }
+
+        if (::ftruncate(memory.get(), static_cast<::off_t>(capacity)) == -1)
+        {
+            ::throw_system_error("failed to size the mirror_buffer's memory");
+        }
+
+        // Reserve the address range for both mappings, so nothing
+        // else can be mapped between them
+        void * const reserved = ::mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED)
+        {
+            ::throw_system_error("failed to reserve the mirror_buffer's address range");
+        }
+
+        char * const base = static_cast<char *>(reserved);
+        for (char * const address : {base, base + capacity})
+        {
+            if (::mmap(address, capacity,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_FIXED,
+                       memory.get(), 0) == MAP_FAILED)
+            {
+                const int error = errno;
+                ::munmap(reserved, capacity * 2);
+                errno = error;
+                ::throw_system_error("failed to map the mirror_buffer's memory");
+            }
+        }
+
+        // The mappings keep the memory alive after its descriptor is closed
+        return base;
+    }
+}
+
+linuxpp::mirror_buffer::mirror_buffer(const std::size_t capacity):
+    capacity_(::round_to_pages(capacity))
+{
+    if (capacity == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "mirror_buffer capacity must be greater than 0");
+    }
+
+    this->base_ = ::map_mirrored(this->capacity_);
+}
+
+linuxpp::mirror_buffer::~mirror_buffer()
+{
+    ::munmap(this->base_, this->capacity_ * 2);
+}
+
+std::size_t
+linuxpp::mirror_buffer::capacity() const noexcept
+{
+    return this->capacity_;
+}
+
+std::size_t
+linuxpp::mirror_buffer::size() const noexcept
+{
+    return this->size_;
+}
+
+std::size_t
+linuxpp::mirror_buffer::available() const noexcept
+{
+    return this->capacity_ - this->size_;
+}
+
+bool
+linuxpp::mirror_buffer::empty() const noexcept
+{
+    return this->size_ == 0;
+}
+
+bool
+linuxpp::mirror_buffer::full() const noexcept
+{
+    return this->size_ == this->capacity_;
+}
+
+char *
+linuxpp::mirror_buffer::read_data() noexcept
+{
+    return this->base_ + this->read_;
+}
+
+char const *
+linuxpp::mirror_buffer::read_data() const noexcept
+{
+    return this->base_ + this->read_;
+}
+
+char *
+linuxpp::mirror_buffer::write_data() noexcept
+{
+    // May be in the second mapping, which is the same memory
+    return this->base_ + this->read_ + this->size_;
+}
+
+struct ::iovec
+linuxpp::mirror_buffer::read_iovec() noexcept
+{
+    return ::iovec {this->read_data(), this->size_};
+}
+
+struct ::iovec
+linuxpp::mirror_buffer::write_iovec() noexcept
+{
+    return ::iovec {this->write_data(), this->available()};
+}
+
+void
+linuxpp::mirror_buffer::commit(const std::size_t length) noexcept
+{
+    this->size_ += length;
+}
+
+void
+linuxpp::mirror_buffer::consume(const std::size_t length) noexcept
+{
+    this->size_ -= length;
+    this->read_ += length;
+    if (this->read_ >= this->capacity_)
+    {
+        this->read_ -= this->capacity_;
+    }
+}
+
+void
+linuxpp::mirror_buffer::clear() noexcept
+{
+    this->read_ = 0;
+    this->size_ = 0;
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::mirror_buffer::recv(std::nothrow_t,
+                             const int sd,
+                             const int flags) noexcept
+{
+    if (this->full())
+    {
+        // 0 would look like the end of file
+        return linuxpp::syscall_return<::ssize_t> {ENOBUFS, -1};
+    }
+
+    const auto ret = linuxpp::net::recv(std::nothrow, sd, this->write_data(), this->available(), flags);
+    if (ret)
+    {
+        this->commit(static_cast<std::size_t>(ret.return_value()));
+    }
+
+    return ret;
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::mirror_buffer::send(std::nothrow_t,
+                             const int sd,
+                             const int flags) noexcept
+{
+    if (this->empty())
+    {
+        return linuxpp::syscall_return<::ssize_t> {0};
+    }
+
+    const auto ret = linuxpp::net::send(std::nothrow, sd, this->read_data(), this->size_, flags);
+    if (ret)
+    {
+        this->consume(static_cast<std::size_t>(ret.return_value()));
+    }
+
+    return ret;
+}
@@ -1,5 +1,8 @@
 #include <sys/timerfd.h>
+#include <unistd.h>
 
+#include <cerrno>
+#include <system_error>
 
 #include <libndgpp/error.hpp>
 
@@ -21,21 +24,63 @@ linuxpp::monotonic_timerfd::monotonic_timerfd():
     monotonic_timerfd(0)
 {}
 
+linuxpp::monotonic_timerfd::monotonic_timerfd(linuxpp::monotonic_timerfd &&) = default;
+linuxpp::monotonic_timerfd & linuxpp::monotonic_timerfd::operator=(linuxpp::monotonic_timerfd &&) = default;
+
+struct ::itimerspec
+linuxpp::monotonic_timerfd::settime(const int flags,
+                                    const struct ::itimerspec & new_spec)
+{
+    struct ::itimerspec old_spec = {};
+    const int ret = ::timerfd_settime(this->fd_.get(), flags, &new_spec, &old_spec);
+    if (ret == -1)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code{errno, std::system_category()},
+                          "timerfd_settime system call failed");
+    }
+
+    return old_spec;
+}
+
 struct ::itimerspec
 linuxpp::monotonic_timerfd::set_oneshot(const std::chrono::steady_clock::time_point timeout)
 {
-    const auto now = std::chrono::steady_clock::now();
-    if (timeout > now)
+    struct ::itimerspec new_spec = {};
+    new_spec.it_value = monotonic_timerfd::to_timespec(timeout.time_since_epoch());
+
+    // A zero it_value disarms the timer.  Any time in the past
+    // expires right away with TFD_TIMER_ABSTIME, so use the earliest
+    // non-zero time instead.
+    if (new_spec.it_value.tv_sec <= 0 && new_spec.it_value.tv_nsec <= 0)
     {
-        return this->set_oneshot(timeout - now);
+        new_spec.it_value.tv_sec = 0;
+        new_spec.it_value.tv_nsec = 1;
     }
-    else
+
+    return this->settime(TFD_TIMER_ABSTIME, new_spec);
+}
+
+struct ::itimerspec
+linuxpp::monotonic_timerfd::disarm()
+{
+    const struct ::itimerspec new_spec = {};
+    return this->settime(0, new_spec);
+}
+
+struct ::itimerspec
+linuxpp::monotonic_timerfd::gettime() const
+{
+    struct ::itimerspec spec = {};
+    const int ret = ::timerfd_gettime(this->fd_.get(), &spec);
+    if (ret == -1)
     {
-        // By the time set_oneshot was called, the timeout time has
-        // been surpased so just arm the timer so it expires right
-        // away
-        return this->set_oneshot(std::chrono::nanoseconds(1));
+        throw ndgpp_error(std::system_error,
+                          std::error_code{errno, std::system_category()},
+                          "timerfd_gettime system call failed");
     }
+
+    return spec;
 }
 
 uint64_t
@@ -46,6 +91,19 @@ linuxpp::monotonic_timerfd::read()
     return value;
 }
 
+linuxpp::syscall_return<uint64_t>
+linuxpp::monotonic_timerfd::read(std::nothrow_t)
+{
+    uint64_t value = 0;
+    const ssize_t ret = ::read(this->fd_.get(), &value, sizeof(value));
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<uint64_t> {errno, 0};
+    }
+
+    return linuxpp::syscall_return<uint64_t> {value};
+}
+
 int
 linuxpp::monotonic_timerfd::fd() const
 {
@@ -1,31 +1,64 @@
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <stdexcept>
 #include <tuple>
 
+#include <libndgpp/error.hpp>
+
 #include <liblinuxpp/net/accept.hpp>
 #include <liblinuxpp/net/sockaddr.hpp>
 
 namespace detail
 {
-    int accept(const int sd,
-               struct ::sockaddr * sockaddr,
-               socklen_t * socklen,
-               const int flags = 0)
+    linuxpp::syscall_return<int> accept(const int sd,
+                                        struct ::sockaddr * sockaddr,
+                                        socklen_t * socklen,
+                                        const int flags = 0) noexcept
     {
         const int ret = ::accept4(sd, sockaddr, socklen, flags);
         if (ret == -1)
         {
-            throw ndgpp_error(std::system_error,
-                              std::error_code (errno, std::system_category()),
-                              "accept system call failed");
+            return linuxpp::syscall_return<int> {errno, ret};
         }
 
-        return ret;
+        return linuxpp::syscall_return<int> {ret};
     }
 }
 
+linuxpp::syscall_return<int> linuxpp::net::accept(std::nothrow_t,
+                                                  const int sd,
+                                                  const int flags) noexcept
+{
+    return detail::accept(sd, nullptr, nullptr, flags | SOCK_CLOEXEC);
+}
+
 int linuxpp::net::accept(const int sd,
                          const int flags)
 {
-    return detail::accept(sd, nullptr, nullptr, flags | SOCK_CLOEXEC);
+    return linuxpp::value_or_throw(linuxpp::net::accept(std::nothrow, sd, flags),
+                                   "accept system call failed");
+}
+
+linuxpp::syscall_return<int> linuxpp::net::accept(std::nothrow_t,
+                                                  const int sd,
+                                                  struct ::sockaddr_in & sockaddr,
+                                                  const int flags) noexcept
+{
+    ::socklen_t socklen = sizeof(sockaddr);
+    const auto ret = detail::accept(sd,
+                                    reinterpret_cast<struct ::sockaddr *>(&sockaddr),
+                                    &socklen,
+                                    flags | SOCK_CLOEXEC);
+
+    if (ret && socklen != sizeof(sockaddr))
+    {
+        ::close(ret.return_value());
+        return linuxpp::syscall_return<int> {EINVAL, -1};
+    }
+
+    return ret;
 }
 
 int linuxpp::net::accept(const int sd,
@@ -33,10 +66,11 @@ int linuxpp::net::accept(const int sd,
                          const int flags)
 {
     ::socklen_t socklen = sizeof(sockaddr);
-    const int ret = detail::accept(sd,
-                                   reinterpret_cast<struct ::sockaddr *>(&sockaddr),
-                                   &socklen,
-                                   flags | SOCK_CLOEXEC);
+    const int ret = linuxpp::value_or_throw(detail::accept(sd,
+                                                           reinterpret_cast<struct ::sockaddr *>(&sockaddr),
+                                                           &socklen,
+                                                           flags | SOCK_CLOEXEC),
+                                            "accept system call failed");
 
     if (socklen != sizeof(sockaddr))
     {
@@ -47,13 +81,29 @@ int linuxpp::net::accept(const int sd,
     return ret;
 }
 
+linuxpp::syscall_return<int> linuxpp::net::accept(std::nothrow_t,
+                                                  const int sd,
+                                                  ndgpp::net::ipv4_address & addr,
+                                                  ndgpp::net::port & port,
+                                                  const int flags) noexcept
+{
+    struct ::sockaddr_in sockaddr = {};
+    const auto ret = linuxpp::net::accept(std::nothrow, sd, sockaddr, flags);
+    if (ret)
+    {
+        std::tie(addr, port) = linuxpp::net::parse_sockaddr(sockaddr);
+    }
+
+    return ret;
+}
+
 int linuxpp::net::accept(const int sd,
                          ndgpp::net::ipv4_address & addr,
                          ndgpp::net::port & port,
                          const int flags)
 {
     struct ::sockaddr_in sockaddr = {};
-    const int ret = linuxpp::net::accept(sd, sockaddr);
+    const int ret = linuxpp::net::accept(sd, sockaddr, flags);
     std::tie(addr, port) = linuxpp::net::parse_sockaddr(sockaddr);
     return ret;
 }
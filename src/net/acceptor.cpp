@@ -0,0 +1,217 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/file_descriptor.hpp>
+#include <liblinuxpp/net/accept.hpp>
+#include <liblinuxpp/net/acceptor.hpp>
+#include <liblinuxpp/open.hpp>
+
+namespace
+{
+    linuxpp::unique_fd<> open_reserve() noexcept
+    {
+        const auto ret = linuxpp::open(std::nothrow, "/dev/null", O_RDONLY);
+        return linuxpp::unique_fd<> {ret ? ret.return_value() : linuxpp::closed_fd};
+    }
+
+    /// Errors that only affect the connection being accepted, see man 2 accept
+    bool connection_error(const int errno_value) noexcept
+    {
+        switch (errno_value)
+        {
+            case EINTR:
+            case ECONNABORTED:
+            case EPROTO:
+            case EPERM:
+            case ENETDOWN:
+            case ENOPROTOOPT:
+            case EHOSTDOWN:
+            case ENONET:
+            case EHOSTUNREACH:
+            case EOPNOTSUPP:
+            case ENETUNREACH:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+constexpr std::size_t linuxpp::net::acceptor::default_batch_size;
+
+linuxpp::net::acceptor::acceptor(const int sd,
+                                 const std::size_t batch_size):
+    sd_(sd),
+    batch_size_(batch_size),
+    reserve_(linuxpp::open("/dev/null", O_RDONLY))
+{
+    if (batch_size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "acceptor batch size must be greater than 0");
+    }
+
+    const int flags = linuxpp::fcntl(sd, F_GETFL);
+    linuxpp::fcntl(sd, F_SETFL, flags | O_NONBLOCK);
+    this->batch_.reserve(batch_size);
+}
+
+linuxpp::net::acceptor::~acceptor()
+{
+    this->detach();
+}
+
+void
+linuxpp::net::acceptor::set_tuning(const linuxpp::net::socket_tuning & tuning)
+{
+    this->tuning_ = tuning;
+    this->tuned_ = true;
+}
+
+bool
+linuxpp::net::acceptor::reject()
+{
+    if (!this->reserve_)
+    {
+        // The reserve is reopened on the next call, when descriptors
+        // may be available again
+        return false;
+    }
+
+    this->reserve_.reset();
+    const auto ret = linuxpp::net::accept(std::nothrow, this->sd_);
+    if (ret)
+    {
+        ::close(ret.return_value());
+        ++this->rejected_;
+    }
+
+    this->reserve_ = ::open_reserve();
+    return static_cast<bool>(ret);
+}
+
+std::size_t
+linuxpp::net::acceptor::accept_pending(const connection_handler & handler)
+{
+    if (!this->reserve_)
+    {
+        this->reserve_ = ::open_reserve();
+    }
+
+    std::size_t count = 0;
+    const auto flush = [this, &handler, &count] () {
+        if (this->batch_.empty())
+        {
+            return;
+        }
+
+        const std::size_t size = this->batch_.size();
+        try
+        {
+            handler(this->batch_.data(), size);
+        }
+        catch (...)
+        {
+            this->batch_.clear();
+            throw;
+        }
+
+        this->batch_.clear();
+        count += size;
+    };
+
+    while (true)
+    {
+        const auto ret = linuxpp::net::accept(std::nothrow, this->sd_, SOCK_NONBLOCK);
+        if (ret)
+        {
+            this->batch_.emplace_back(linuxpp::file_descriptor {ret.return_value()});
+            if (this->tuned_)
+            {
+                // Settings the kernel rejects are left at their defaults
+                this->tuning_.apply(ret.return_value());
+            }
+
+            if (this->batch_.size() == this->batch_size_)
+            {
+                flush();
+            }
+
+            continue;
+        }
+
+        const int error = ret.errno_value();
+        if (::connection_error(error))
+        {
+            continue;
+        }
+
+        if ((error == EMFILE || error == ENFILE) && this->reject())
+        {
+            continue;
+        }
+
+        flush();
+        if (error == EAGAIN || error == EWOULDBLOCK ||
+            error == EMFILE || error == ENFILE ||
+            error == ENOBUFS || error == ENOMEM)
+        {
+            return count;
+        }
+
+        throw ndgpp_error(std::system_error,
+                          std::error_code (error, std::system_category()),
+                          "failed to accept a connection");
+    }
+}
+
+void
+linuxpp::net::acceptor::attach(linuxpp::ioloop & loop,
+                               connection_handler handler,
+                               const bool exclusive)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "acceptor is already attached to an ioloop");
+    }
+
+    this->handler_ = std::move(handler);
+    loop.add_handler(this->sd_,
+                     linuxpp::ioloop::event_enum::read |
+                     (exclusive ? linuxpp::ioloop::event_enum::exclusive : 0),
+                     [this] (int, uint32_t) { this->accept_pending(this->handler_); });
+    this->loop_ = &loop;
+}
+
+void
+linuxpp::net::acceptor::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    this->loop_->remove_handler(this->sd_);
+    this->loop_ = nullptr;
+}
+
+std::size_t
+linuxpp::net::acceptor::rejected() const noexcept
+{
+    return this->rejected_;
+}
+
+int
+linuxpp::net::acceptor::descriptor() const noexcept
+{
+    return this->sd_;
+}
@@ -0,0 +1,148 @@
+#include <linux/filter.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/bpf.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+
+namespace
+{
+    std::uint32_t full_mask(const std::uint16_t size) noexcept
+    {
+        switch (size)
+        {
+            case BPF_B:
+                return 0xff;
+            case BPF_H:
+                return 0xffff;
+            default:
+                return 0xffffffff;
+        }
+    }
+
+    std::uint8_t jump_offset(const std::size_t offset)
+    {
+        if (offset > std::numeric_limits<std::uint8_t>::max())
+        {
+            throw ndgpp_error(std::length_error, "bpf filter jump is out of range");
+        }
+
+        return static_cast<std::uint8_t>(offset);
+    }
+}
+
+linuxpp::net::bpf::filter &
+linuxpp::net::bpf::filter::add(const std::uint16_t size,
+                               const std::uint32_t offset,
+                               const std::uint32_t mask,
+                               std::vector<std::uint32_t> values)
+{
+    this->conditions_.push_back(condition {size, offset, mask, std::move(values)});
+    return *this;
+}
+
+linuxpp::net::bpf::filter &
+linuxpp::net::bpf::filter::match_byte(const std::uint32_t offset,
+                                      const std::uint8_t value,
+                                      const std::uint8_t mask)
+{
+    if ((value & ~mask) != 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "bpf filter value has bits outside of its mask");
+    }
+
+    return this->add(BPF_B, offset, mask, {value});
+}
+
+linuxpp::net::bpf::filter &
+linuxpp::net::bpf::filter::match_byte(const std::uint32_t offset,
+                                      std::initializer_list<std::uint8_t> values)
+{
+    if (values.size() == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "bpf filter condition has no values");
+    }
+
+    return this->add(BPF_B, offset, 0xff, std::vector<std::uint32_t>(values.begin(), values.end()));
+}
+
+linuxpp::net::bpf::filter &
+linuxpp::net::bpf::filter::match_u16(const std::uint32_t offset,
+                                     const std::uint16_t value)
+{
+    return this->add(BPF_H, offset, 0xffff, {value});
+}
+
+linuxpp::net::bpf::filter &
+linuxpp::net::bpf::filter::match_u32(const std::uint32_t offset,
+                                     const std::uint32_t value)
+{
+    return this->add(BPF_W, offset, 0xffffffff, {value});
+}
+
+linuxpp::net::bpf::program
+linuxpp::net::bpf::filter::build() const
+{
+    // Every condition loads its field, optionally masks it, and
+    // compares it to each of its values.  A match jumps to the next
+    // condition, and a field that matches none of the values jumps
+    // to the trailing drop instruction.
+    std::size_t length = 2;
+    for (const auto & cond : this->conditions_)
+    {
+        length += 1 + (cond.mask != ::full_mask(cond.size) ? 1 : 0) + cond.values.size();
+    }
+
+    const std::size_t drop = length - 1;
+    std::vector<struct ::sock_filter> instructions;
+    instructions.reserve(length);
+
+    for (const auto & cond : this->conditions_)
+    {
+        instructions.push_back(linuxpp::net::bpf::stmt(BPF_LD | cond.size | BPF_ABS, cond.offset));
+        if (cond.mask != ::full_mask(cond.size))
+        {
+            instructions.push_back(linuxpp::net::bpf::stmt(BPF_ALU | BPF_AND | BPF_K, cond.mask));
+        }
+
+        const std::size_t count = cond.values.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t next = instructions.size() + 1;
+            const std::uint8_t jt = ::jump_offset(count - 1 - i);
+            const std::uint8_t jf = i + 1 < count ? 0 : ::jump_offset(drop - next);
+            instructions.push_back(linuxpp::net::bpf::jump(BPF_JMP | BPF_JEQ | BPF_K, cond.values[i], jt, jf));
+        }
+    }
+
+    instructions.push_back(linuxpp::net::bpf::stmt(BPF_RET | BPF_K, std::numeric_limits<std::uint32_t>::max()));
+    instructions.push_back(linuxpp::net::bpf::stmt(BPF_RET | BPF_K, 0));
+    return linuxpp::net::bpf::program {std::move(instructions)};
+}
+
+void
+linuxpp::net::bpf::attach_filter(const int sd, const linuxpp::net::bpf::program & program)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::attach_filter>(sd, program.fprog());
+}
+
+void
+linuxpp::net::bpf::detach_filter(const int sd)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::detach_filter>(sd, 0);
+}
+
+void
+linuxpp::net::bpf::lock_filter(const int sd)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::lock_filter>(sd, 1);
+}
@@ -1,21 +1,39 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 
+#include <cerrno>
+
 #include <liblinuxpp/net/connect.hpp>
 #include <liblinuxpp/net/sockaddr.hpp>
 
-void linuxpp::net::connect(const int sd,
-                           const struct ::sockaddr_in sockaddr)
+linuxpp::syscall_return<int> linuxpp::net::connect(std::nothrow_t,
+                                                   const int sd,
+                                                   const struct ::sockaddr_in sockaddr) noexcept
 {
     const int ret = ::connect(sd,
                               reinterpret_cast<const struct ::sockaddr*>(&sockaddr),
                               sizeof(struct ::sockaddr_in));
     if (ret == -1)
     {
-        throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
-                          "failed to connect socket");
+        return linuxpp::syscall_return<int> {errno, ret};
     }
+
+    return linuxpp::syscall_return<int> {ret};
+}
+
+void linuxpp::net::connect(const int sd,
+                           const struct ::sockaddr_in sockaddr)
+{
+    linuxpp::value_or_throw(linuxpp::net::connect(std::nothrow, sd, sockaddr),
+                            "failed to connect socket");
+}
+
+linuxpp::syscall_return<int> linuxpp::net::connect(std::nothrow_t,
+                                                   const int sd,
+                                                   const ndgpp::net::ipv4_address addr,
+                                                   const ndgpp::net::port port) noexcept
+{
+    return linuxpp::net::connect(std::nothrow, sd, linuxpp::net::make_sockaddr(addr, port));
 }
 
 void linuxpp::net::connect(const int sd,
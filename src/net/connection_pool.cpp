@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/connection_pool.hpp>
+
+linuxpp::net::connection_pool::connection_pool(linuxpp::ioloop & loop,
+                                               const ndgpp::net::ipv4_address address,
+                                               const ndgpp::net::port port,
+                                               const std::size_t size,
+                                               const linuxpp::net::socket_tuning & tuning,
+                                               const std::chrono::milliseconds connect_timeout,
+                                               const std::chrono::milliseconds retry_delay):
+    loop_(loop),
+    connector_(loop),
+    address_(address),
+    port_(port),
+    size_(size),
+    connect_timeout_(connect_timeout),
+    retry_delay_(retry_delay)
+{
+    if (size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "connection pool size must be greater than 0");
+    }
+
+    this->connector_.set_tuning(tuning);
+    this->idle_.reserve(size);
+    this->fill();
+}
+
+linuxpp::net::connection_pool::~connection_pool()
+{
+    for (const auto & socket : this->idle_)
+    {
+        this->loop_.remove_handler(socket.descriptor());
+    }
+
+    if (this->retry_pending_)
+    {
+        this->loop_.remove_timeout(this->retry_);
+    }
+}
+
+void
+linuxpp::net::connection_pool::fill()
+{
+    while (this->idle_.size() + this->connecting_ < this->size_)
+    {
+        try
+        {
+            this->connector_.connect(this->address_,
+                                     this->port_,
+                                     this->connect_timeout_,
+                                     [this] (int errno_value, linuxpp::net::tcp_socket socket) {
+                                         this->connected(errno_value, std::move(socket));
+                                     });
+        }
+        catch (const std::system_error &)
+        {
+            // e.g. out of local ports or file descriptors
+            ++this->failures_;
+            this->schedule_retry();
+            return;
+        }
+
+        ++this->connecting_;
+    }
+}
+
+void
+linuxpp::net::connection_pool::schedule_retry()
+{
+    if (this->retry_pending_)
+    {
+        return;
+    }
+
+    this->retry_pending_ = true;
+    this->retry_ = this->loop_.add_timeout(this->retry_delay_, [this] () {
+        this->retry_pending_ = false;
+        this->fill();
+    });
+}
+
+void
+linuxpp::net::connection_pool::connected(const int errno_value, linuxpp::net::tcp_socket socket)
+{
+    --this->connecting_;
+    if (errno_value != 0)
+    {
+        ++this->failures_;
+        this->schedule_retry();
+        return;
+    }
+
+    // Released connections may have filled the pool in the meantime
+    if (this->idle_.size() < this->size_)
+    {
+        this->add_idle(std::move(socket));
+    }
+}
+
+void
+linuxpp::net::connection_pool::add_idle(linuxpp::net::tcp_socket && socket)
+{
+    const int sd = socket.descriptor();
+    this->idle_.push_back(std::move(socket));
+    try
+    {
+        this->loop_.add_handler(sd,
+                                linuxpp::ioloop::event_enum::read | linuxpp::ioloop::event_enum::error,
+                                [this] (int fd, uint32_t) { this->drop_idle(fd); });
+    }
+    catch (...)
+    {
+        this->idle_.pop_back();
+        throw;
+    }
+}
+
+void
+linuxpp::net::connection_pool::drop_idle(const int sd)
+{
+    const auto socket = std::find_if(this->idle_.begin(),
+                                     this->idle_.end(),
+                                     [sd] (const linuxpp::net::tcp_socket & idle) { return idle.descriptor() == sd; });
+    if (socket == this->idle_.end())
+    {
+        return;
+    }
+
+    this->loop_.remove_handler(sd);
+    std::swap(*socket, this->idle_.back());
+    this->idle_.pop_back();
+    this->fill();
+}
+
+linuxpp::net::tcp_socket
+linuxpp::net::connection_pool::acquire()
+{
+    if (this->idle_.empty())
+    {
+        return linuxpp::net::tcp_socket {};
+    }
+
+    linuxpp::net::tcp_socket socket = std::move(this->idle_.back());
+    this->idle_.pop_back();
+    this->loop_.remove_handler(socket.descriptor());
+    this->fill();
+    return socket;
+}
+
+void
+linuxpp::net::connection_pool::release(linuxpp::net::tcp_socket && socket)
+{
+    // Takes ownership even when the connection is closed
+    linuxpp::net::tcp_socket released {std::move(socket)};
+    if (!released || this->idle_.size() + this->connecting_ >= this->size_)
+    {
+        return;
+    }
+
+    this->add_idle(std::move(released));
+}
+
+std::size_t
+linuxpp::net::connection_pool::idle() const noexcept
+{
+    return this->idle_.size();
+}
+
+std::size_t
+linuxpp::net::connection_pool::connecting() const noexcept
+{
+    return this->connecting_;
+}
+
+std::size_t
+linuxpp::net::connection_pool::failures() const noexcept
+{
+    return this->failures_;
+}
@@ -0,0 +1,123 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+
+#include <system_error>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/net/connector.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+
+linuxpp::net::connector::connector(linuxpp::ioloop & loop):
+    loop_(loop)
+{}
+
+linuxpp::net::connector::~connector()
+{
+    for (auto & entry : this->attempts_)
+    {
+        this->loop_.remove_handler(entry.first);
+        this->loop_.remove_timeout(entry.second.timeout);
+    }
+}
+
+void
+linuxpp::net::connector::set_tuning(const linuxpp::net::socket_tuning & tuning)
+{
+    this->tuning_ = tuning;
+    this->tuned_ = true;
+}
+
+void
+linuxpp::net::connector::connect(const ndgpp::net::ipv4_address address,
+                                 const ndgpp::net::port port,
+                                 const std::chrono::milliseconds timeout,
+                                 connect_handler handler)
+{
+    linuxpp::net::tcp_socket socket {AF_INET};
+    const int sd = socket.descriptor();
+    const int flags = linuxpp::fcntl(sd, F_GETFL);
+    linuxpp::fcntl(sd, F_SETFL, flags | O_NONBLOCK);
+    if (this->tuned_)
+    {
+        this->tuning_.apply(sd);
+    }
+
+    const auto ret = socket.connect(std::nothrow, address, port);
+    if (!ret && ret.errno_value() != EINPROGRESS)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code (ret.errno_value(), std::system_category()),
+                          "failed to start connecting");
+    }
+
+    // A connect that completed immediately is reported by the
+    // ioloop as well, since the socket is already writable
+    auto & entry = this->attempts_[sd];
+    entry.socket = std::move(socket);
+    entry.handler = std::move(handler);
+    bool handler_added = false;
+    try
+    {
+        this->loop_.add_handler(sd,
+                                linuxpp::ioloop::event_enum::write | linuxpp::ioloop::event_enum::error,
+                                [this] (int fd, uint32_t) {
+                                    using traits = linuxpp::net::so::traits<linuxpp::net::so::error>;
+                                    int value = 0;
+                                    ::socklen_t length = sizeof(value);
+                                    if (::getsockopt(fd, traits::level(), traits::name, &value, &length) == -1)
+                                    {
+                                        value = errno;
+                                    }
+
+                                    this->finish(fd, value);
+                                });
+        handler_added = true;
+
+        entry.timeout = this->loop_.add_timeout(timeout, [this, sd] () { this->finish(sd, ETIMEDOUT); });
+    }
+    catch (...)
+    {
+        // Removed before the socket is closed by the erase
+        if (handler_added)
+        {
+            this->loop_.remove_handler(sd);
+        }
+
+        this->attempts_.erase(sd);
+        throw;
+    }
+}
+
+void
+linuxpp::net::connector::finish(const int sd, const int errno_value)
+{
+    auto entry = this->attempts_.find(sd);
+    if (entry == this->attempts_.end())
+    {
+        return;
+    }
+
+    this->loop_.remove_handler(sd);
+    this->loop_.remove_timeout(entry->second.timeout);
+
+    attempt finished = std::move(entry->second);
+    this->attempts_.erase(entry);
+    if (errno_value != 0)
+    {
+        // Closes the socket before the handler can start a new attempt
+        finished.socket = linuxpp::net::tcp_socket {};
+    }
+
+    finished.handler(errno_value, std::move(finished.socket));
+}
+
+std::size_t
+linuxpp::net::connector::pending() const noexcept
+{
+    return this->attempts_.size();
+}
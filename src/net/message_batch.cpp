@@ -0,0 +1,127 @@
+#include <stdexcept>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/message_batch.hpp>
+#include <liblinuxpp/net/recv.hpp>
+
+namespace
+{
+    /// Returns the number of cmsghdrs that hold size control buffers
+    std::size_t control_headers(const std::size_t size, const std::size_t control_size)
+    {
+        return (size * control_size + sizeof(struct ::cmsghdr) - 1) / sizeof(struct ::cmsghdr);
+    }
+}
+
+linuxpp::net::message_batch::message_batch(const std::size_t size,
+                                           const std::size_t buffer_size,
+                                           const std::size_t control_size):
+    members_(buffer_size,
+             CMSG_ALIGN(control_size),
+             std::vector<char>(size * buffer_size),
+             std::vector<struct ::cmsghdr>(::control_headers(size, CMSG_ALIGN(control_size))),
+             std::vector<struct ::iovec>(size),
+             std::vector<struct ::sockaddr_in>(size),
+             std::vector<struct ::mmsghdr>(size))
+{
+    if (size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "message_batch size cannot be 0");
+    }
+
+    if (buffer_size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "message_batch buffer size cannot be 0");
+    }
+
+    auto & buffers = std::get<members::buffers>(this->members_);
+    // Every control buffer starts at a multiple of CMSG_ALIGN, so
+    // each one is aligned for struct cmsghdr
+    const std::size_t aligned_control_size = this->control_size();
+    auto controls = reinterpret_cast<unsigned char *>(std::get<members::controls>(this->members_).data());
+    auto & iovecs = std::get<members::iovecs>(this->members_);
+    auto & addresses = std::get<members::addresses>(this->members_);
+    auto & headers = std::get<members::headers>(this->members_);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        iovecs[i].iov_base = &buffers[i * buffer_size];
+        iovecs[i].iov_len = buffer_size;
+
+        auto & hdr = headers[i].msg_hdr;
+        hdr.msg_name = &addresses[i];
+        hdr.msg_namelen = sizeof(addresses[i]);
+        hdr.msg_iov = &iovecs[i];
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = aligned_control_size == 0 ? nullptr : controls + i * aligned_control_size;
+        hdr.msg_controllen = aligned_control_size;
+        hdr.msg_flags = 0;
+        headers[i].msg_len = 0;
+    }
+}
+
+void
+linuxpp::net::message_batch::set_length(const std::size_t i, const std::size_t length)
+{
+    if (length > this->buffer_size())
+    {
+        throw ndgpp_error(std::invalid_argument, "message length exceeds message_batch buffer size");
+    }
+
+    std::get<iovecs>(this->members_)[i].iov_len = length;
+}
+
+void
+linuxpp::net::message_batch::set_address(const std::size_t i,
+                                         const struct ::sockaddr_in & address) noexcept
+{
+    std::get<addresses>(this->members_)[i] = address;
+    auto & hdr = std::get<headers>(this->members_)[i].msg_hdr;
+    hdr.msg_name = &std::get<addresses>(this->members_)[i];
+    hdr.msg_namelen = sizeof(address);
+}
+
+void
+linuxpp::net::message_batch::clear_address(const std::size_t i) noexcept
+{
+    auto & hdr = std::get<headers>(this->members_)[i].msg_hdr;
+    hdr.msg_name = nullptr;
+    hdr.msg_namelen = 0;
+}
+
+void
+linuxpp::net::message_batch::set_control_length(const std::size_t i, const std::size_t length)
+{
+    if (length > this->control_size())
+    {
+        throw ndgpp_error(std::invalid_argument, "control length exceeds message_batch control size");
+    }
+
+    // A zero length with a non-null control pointer is fine, the
+    // kernel only looks at the pointer when the length is non-zero
+    std::get<headers>(this->members_)[i].msg_hdr.msg_controllen = length;
+}
+
+struct ::timespec
+linuxpp::net::message_batch::timestamp(const std::size_t i) const noexcept
+{
+    return linuxpp::net::receive_timestamp(std::get<headers>(this->members_)[i].msg_hdr);
+}
+
+void
+linuxpp::net::message_batch::prepare_recv() noexcept
+{
+    auto & iovecs = std::get<members::iovecs>(this->members_);
+    auto & addresses = std::get<members::addresses>(this->members_);
+    auto & headers = std::get<members::headers>(this->members_);
+    for (std::size_t i = 0; i < headers.size(); ++i)
+    {
+        iovecs[i].iov_len = this->buffer_size();
+
+        auto & hdr = headers[i].msg_hdr;
+        hdr.msg_name = &addresses[i];
+        hdr.msg_namelen = sizeof(addresses[i]);
+        hdr.msg_controllen = this->control_size();
+        hdr.msg_flags = 0;
+    }
+}
@@ -0,0 +1,275 @@
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/net/cmsg.hpp>
+#include <liblinuxpp/net/interface.hpp>
+#include <liblinuxpp/net/ip_options.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/multicast_subscriber.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/sockaddr.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+
+namespace
+{
+    struct ::group_req make_group_req(const ndgpp::net::multicast_ipv4_address group,
+                                      const unsigned int ifindex)
+    {
+        struct ::group_req req = {};
+        req.gr_interface = ifindex;
+
+        const struct ::sockaddr_in group_addr = linuxpp::net::make_sockaddr(ndgpp::net::ipv4_address {group.to_uint32()});
+        std::memcpy(&req.gr_group, &group_addr, sizeof(group_addr));
+        return req;
+    }
+
+    struct ::group_source_req make_group_source_req(const ndgpp::net::multicast_ipv4_address group,
+                                                    const ndgpp::net::ipv4_address source,
+                                                    const unsigned int ifindex)
+    {
+        struct ::group_source_req req = {};
+        req.gsr_interface = ifindex;
+
+        const struct ::sockaddr_in group_addr = linuxpp::net::make_sockaddr(ndgpp::net::ipv4_address {group.to_uint32()});
+        const struct ::sockaddr_in source_addr = linuxpp::net::make_sockaddr(source);
+        std::memcpy(&req.gsr_group, &group_addr, sizeof(group_addr));
+        std::memcpy(&req.gsr_source, &source_addr, sizeof(source_addr));
+        return req;
+    }
+}
+
+linuxpp::net::multicast_subscriber::multicast_subscriber(const ndgpp::net::port port,
+                                                         const std::size_t batch_size,
+                                                         const std::size_t buffer_size):
+    socket_(AF_INET),
+    batch_(batch_size,
+           buffer_size,
+           linuxpp::net::cmsg::space<linuxpp::net::cmsg::pktinfo>::value)
+{
+    const int fd = this->socket_.descriptor();
+    linuxpp::fcntl(fd, F_SETFL, linuxpp::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // Only receive the groups this socket joins, not every group
+    // joined on the host on the same port
+    linuxpp::net::setsockopt<linuxpp::net::so::multicast_all>(fd, 0);
+    linuxpp::net::setsockopt<linuxpp::net::so::pktinfo>(fd, 1);
+
+    this->socket_.bind(linuxpp::net::inaddr_any, port, true);
+}
+
+linuxpp::net::multicast_subscriber::~multicast_subscriber()
+{
+    this->detach();
+}
+
+unsigned int
+linuxpp::net::multicast_subscriber::ifindex(char const * const interface)
+{
+    const auto it = this->ifindex_cache_.find(interface);
+    if (it != this->ifindex_cache_.end())
+    {
+        return it->second;
+    }
+
+    const unsigned int index = linuxpp::net::if_nametoindex(interface);
+    this->ifindex_cache_.emplace(interface, index);
+    return index;
+}
+
+linuxpp::net::multicast_subscriber::dispatch_sentry::dispatch_sentry(linuxpp::net::multicast_subscriber & subscriber) noexcept:
+    subscriber(subscriber)
+{
+    this->subscriber.dispatching_ = true;
+}
+
+linuxpp::net::multicast_subscriber::dispatch_sentry::~dispatch_sentry()
+{
+    // Also runs when a handler throws, so the retired handlers don't
+    // pile up
+    this->subscriber.dispatching_ = false;
+    this->subscriber.retired_handlers_.clear();
+}
+
+void
+linuxpp::net::multicast_subscriber::add_membership(const ndgpp::net::multicast_ipv4_address group,
+                                                   handler_type handler)
+{
+    std::unique_ptr<handler_type> replacement {new handler_type {std::move(handler)}};
+    auto & entry = this->groups_[group.to_uint32()];
+    if (this->dispatching_ && entry.handler)
+    {
+        this->retired_handlers_.push_back(std::move(entry.handler));
+    }
+
+    entry.handler = std::move(replacement);
+    ++entry.memberships;
+}
+
+void
+linuxpp::net::multicast_subscriber::remove_membership(const ndgpp::net::multicast_ipv4_address group)
+{
+    const auto it = this->groups_.find(group.to_uint32());
+    if (it != this->groups_.end() && --it->second.memberships == 0)
+    {
+        if (this->dispatching_)
+        {
+            this->retired_handlers_.push_back(std::move(it->second.handler));
+        }
+
+        this->groups_.erase(it);
+    }
+}
+
+void
+linuxpp::net::multicast_subscriber::subscribe(const ndgpp::net::multicast_ipv4_address group,
+                                              char const * const interface,
+                                              handler_type handler)
+{
+    const auto req = ::make_group_req(group, this->ifindex(interface));
+    linuxpp::net::setsockopt<linuxpp::net::so::mcast_join_group>(this->descriptor(), req);
+    this->add_membership(group, std::move(handler));
+}
+
+void
+linuxpp::net::multicast_subscriber::subscribe(const ndgpp::net::multicast_ipv4_address group,
+                                              const ndgpp::net::ipv4_address source,
+                                              char const * const interface,
+                                              handler_type handler)
+{
+    const auto req = ::make_group_source_req(group, source, this->ifindex(interface));
+    linuxpp::net::setsockopt<linuxpp::net::so::mcast_join_source_group>(this->descriptor(), req);
+    this->add_membership(group, std::move(handler));
+}
+
+void
+linuxpp::net::multicast_subscriber::unsubscribe(const ndgpp::net::multicast_ipv4_address group,
+                                                char const * const interface)
+{
+    const auto req = ::make_group_req(group, this->ifindex(interface));
+    linuxpp::net::setsockopt<linuxpp::net::so::mcast_leave_group>(this->descriptor(), req);
+    this->remove_membership(group);
+}
+
+void
+linuxpp::net::multicast_subscriber::unsubscribe(const ndgpp::net::multicast_ipv4_address group,
+                                                const ndgpp::net::ipv4_address source,
+                                                char const * const interface)
+{
+    const auto req = ::make_group_source_req(group, source, this->ifindex(interface));
+    linuxpp::net::setsockopt<linuxpp::net::so::mcast_leave_source_group>(this->descriptor(), req);
+    this->remove_membership(group);
+}
+
+std::size_t
+linuxpp::net::multicast_subscriber::receive(const std::size_t max_batches)
+{
+    std::size_t received = 0;
+    for (std::size_t batch = 0; batch < max_batches; ++batch)
+    {
+        this->batch_.prepare_recv();
+        const auto ret = linuxpp::net::recv(std::nothrow,
+                                            this->descriptor(),
+                                            this->batch_.data(),
+                                            this->batch_.size(),
+                                            MSG_DONTWAIT);
+        if (!ret)
+        {
+            if (ret.errno_value() == EAGAIN || ret.errno_value() == EINTR)
+            {
+                break;
+            }
+
+            linuxpp::value_or_throw(ret, "recvmmsg failed");
+        }
+
+        const std::size_t count = static_cast<std::size_t>(ret.return_value());
+        const dispatch_sentry sentry {*this};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const linuxpp::net::cmsg::parser control {this->batch_.data()[i].msg_hdr};
+            struct ::in_pktinfo pktinfo;
+            if (!control.get<linuxpp::net::cmsg::pktinfo>(pktinfo))
+            {
+                continue;
+            }
+
+            const std::uint32_t group = ntohl(pktinfo.ipi_addr.s_addr);
+            const auto it = this->groups_.find(group);
+            if (it == this->groups_.end())
+            {
+                continue;
+            }
+
+            datagram dgram;
+            dgram.group = ndgpp::net::ipv4_address {group};
+            std::tie(dgram.source, dgram.source_port) = linuxpp::net::parse_sockaddr(this->batch_.address(i));
+            dgram.ifindex = pktinfo.ipi_ifindex;
+            dgram.data = this->batch_.buffer(i);
+            dgram.size = this->batch_.length(i) < this->batch_.buffer_size() ? this->batch_.length(i) : this->batch_.buffer_size();
+            dgram.truncated = (this->batch_.flags(i) & MSG_TRUNC) != 0;
+
+            (*it->second.handler)(dgram);
+        }
+
+        received += count;
+
+        // A partial batch means the socket was drained
+        if (count < this->batch_.size())
+        {
+            break;
+        }
+    }
+
+    return received;
+}
+
+void
+linuxpp::net::multicast_subscriber::attach(linuxpp::ioloop & loop)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "multicast_subscriber is already attached to an ioloop");
+    }
+
+    loop.add_handler(this->descriptor(),
+                     linuxpp::ioloop::event_enum::read,
+                     [this] (int, uint32_t) { this->receive(); });
+    this->loop_ = &loop;
+}
+
+void
+linuxpp::net::multicast_subscriber::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    this->loop_->remove_handler(this->descriptor());
+    this->loop_ = nullptr;
+}
+
+std::size_t
+linuxpp::net::multicast_subscriber::group_count() const noexcept
+{
+    return this->groups_.size();
+}
+
+int
+linuxpp::net::multicast_subscriber::descriptor() const noexcept
+{
+    return this->socket_.descriptor();
+}
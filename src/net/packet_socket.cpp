@@ -0,0 +1,336 @@
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <atomic>
+#include <stdexcept>
+#include <system_error>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/interface.hpp>
+#include <liblinuxpp/net/packet_options.hpp>
+#include <liblinuxpp/net/packet_socket.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+
+namespace
+{
+    // The offset of a TX frame's data, where the kernel expects it
+    // when PACKET_TX_HAS_OFF isn't set
+    constexpr std::size_t tx_data_offset = TPACKET_ALIGN(sizeof(struct ::tpacket3_hdr));
+
+    struct ::tpacket_req3 make_req(const linuxpp::net::packet_ring_config & config,
+                                   const bool rx)
+    {
+        struct ::tpacket_req3 req = {};
+        if (config.block_count == 0)
+        {
+            return req;
+        }
+
+        if (config.frame_size == 0 || config.frame_size > config.block_size)
+        {
+            throw ndgpp_error(std::invalid_argument, "packet ring frame size must be between 1 and the block size");
+        }
+
+        req.tp_block_size = static_cast<unsigned int>(config.block_size);
+        req.tp_block_nr = static_cast<unsigned int>(config.block_count);
+        req.tp_frame_size = static_cast<unsigned int>(config.frame_size);
+        req.tp_frame_nr = static_cast<unsigned int>((config.block_size / config.frame_size) * config.block_count);
+
+        // The kernel rejects a TX ring with any of the RX block settings
+        if (rx)
+        {
+            req.tp_retire_blk_tov = static_cast<unsigned int>(config.block_timeout.count());
+        }
+
+        return req;
+    }
+}
+
+linuxpp::net::packet_socket::packet_socket(char const * const interface,
+                                           const linuxpp::net::packet_ring_config & rx,
+                                           const linuxpp::net::packet_ring_config & tx,
+                                           const std::uint16_t protocol):
+    socket_(linuxpp::net::socket(AF_PACKET, SOCK_RAW, htons(protocol)))
+{
+    if (rx.block_count == 0 && tx.block_count == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "packet_socket requires an RX or a TX ring");
+    }
+
+    this->ifindex_ = static_cast<int>(linuxpp::net::if_nametoindex(interface));
+
+    const int fd = this->descriptor();
+    linuxpp::net::setsockopt<linuxpp::net::so::packet_version>(fd, TPACKET_V3);
+
+    const struct ::tpacket_req3 rx_req = ::make_req(rx, true);
+    const struct ::tpacket_req3 tx_req = ::make_req(tx, false);
+    if (rx.block_count != 0)
+    {
+        linuxpp::net::setsockopt<linuxpp::net::so::packet_rx_ring>(fd, rx_req);
+    }
+
+    if (tx.block_count != 0)
+    {
+        linuxpp::net::setsockopt<linuxpp::net::so::packet_tx_ring>(fd, tx_req);
+    }
+
+    // Both rings share one mapping, RX first
+    const std::size_t rx_size = rx.block_size * rx.block_count;
+    const std::size_t tx_size = tx.block_size * tx.block_count;
+    void * const map = ::mmap(nullptr, rx_size + tx_size,
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE,
+                              fd, 0);
+    if (map == MAP_FAILED)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code (errno, std::system_category()),
+                          "failed to map the packet rings");
+    }
+
+    this->map_ = map;
+    this->map_size_ = rx_size + tx_size;
+
+    char * const base = static_cast<char *>(map);
+    if (rx.block_count != 0)
+    {
+        this->rx_.base = base;
+        this->rx_.block_size = rx.block_size;
+        this->rx_.block_count = rx.block_count;
+        this->rx_.frame_size = rx.frame_size;
+        this->rx_.frames_per_block = rx.block_size / rx.frame_size;
+    }
+
+    if (tx.block_count != 0)
+    {
+        this->tx_.base = base + rx_size;
+        this->tx_.block_size = tx.block_size;
+        this->tx_.block_count = tx.block_count;
+        this->tx_.frame_size = tx.frame_size;
+        this->tx_.frames_per_block = tx.block_size / tx.frame_size;
+    }
+
+    // Binding after the rings are set up keeps frames from being
+    // received before there's somewhere to put them
+    struct ::sockaddr_ll addr = {};
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(protocol);
+    addr.sll_ifindex = this->ifindex_;
+    if (::bind(fd, reinterpret_cast<struct ::sockaddr *>(&addr), sizeof(addr)) == -1)
+    {
+        const int error = errno;
+        ::munmap(this->map_, this->map_size_);
+        throw ndgpp_error(std::system_error,
+                          std::error_code (error, std::system_category()),
+                          "failed to bind the packet socket");
+    }
+}
+
+linuxpp::net::packet_socket::~packet_socket()
+{
+    this->detach();
+    ::munmap(this->map_, this->map_size_);
+}
+
+void
+linuxpp::net::packet_socket::join_fanout(const std::uint16_t group,
+                                         const int mode,
+                                         const int flags)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::packet_fanout>(this->descriptor(),
+                                                                group | ((mode | flags) << 16));
+}
+
+bool
+linuxpp::net::packet_socket::rx_ready() const noexcept
+{
+    if (this->rx_.block_count == 0)
+    {
+        return false;
+    }
+
+    struct ::tpacket_block_desc const * const desc =
+        reinterpret_cast<struct ::tpacket_block_desc const *>(this->rx_.base + this->rx_.index * this->rx_.block_size);
+
+    const bool ready = (desc->hdr.bh1.block_status & TP_STATUS_USER) != 0;
+
+    // The block's frames must not be read before its status
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return ready;
+}
+
+linuxpp::net::packet_block
+linuxpp::net::packet_socket::rx_block() const noexcept
+{
+    return linuxpp::net::packet_block {
+        reinterpret_cast<struct ::tpacket_block_desc const *>(this->rx_.base + this->rx_.index * this->rx_.block_size)};
+}
+
+void
+linuxpp::net::packet_socket::release_rx_block() noexcept
+{
+    struct ::tpacket_block_desc * const desc =
+        reinterpret_cast<struct ::tpacket_block_desc *>(this->rx_.base + this->rx_.index * this->rx_.block_size);
+
+    // The block's frames must be done with before the kernel reuses it
+    std::atomic_thread_fence(std::memory_order_release);
+    desc->hdr.bh1.block_status = TP_STATUS_KERNEL;
+    this->rx_.index = (this->rx_.index + 1) % this->rx_.block_count;
+}
+
+std::size_t
+linuxpp::net::packet_socket::receive(const frame_handler & handler,
+                                     const std::size_t max_blocks)
+{
+    std::size_t frames = 0;
+    for (std::size_t block = 0; block < max_blocks && this->rx_ready(); ++block)
+    {
+        for (const auto frame : this->rx_block())
+        {
+            handler(frame);
+            ++frames;
+        }
+
+        this->release_rx_block();
+    }
+
+    return frames;
+}
+
+struct ::tpacket3_hdr *
+linuxpp::net::packet_socket::tx_header(const std::size_t index) const noexcept
+{
+    const std::size_t block = index / this->tx_.frames_per_block;
+    const std::size_t frame = index % this->tx_.frames_per_block;
+    return reinterpret_cast<struct ::tpacket3_hdr *>(this->tx_.base +
+                                                     block * this->tx_.block_size +
+                                                     frame * this->tx_.frame_size);
+}
+
+std::size_t
+linuxpp::net::packet_socket::tx_frame_capacity() const noexcept
+{
+    return this->tx_.frame_size > ::tx_data_offset ? this->tx_.frame_size - ::tx_data_offset : 0;
+}
+
+void *
+linuxpp::net::packet_socket::tx_frame() noexcept
+{
+    if (this->tx_.block_count == 0)
+    {
+        return nullptr;
+    }
+
+    struct ::tpacket3_hdr * const header = this->tx_header(this->tx_.index);
+    const std::uint32_t status = reinterpret_cast<volatile std::uint32_t &>(header->tp_status);
+    if (status != TP_STATUS_AVAILABLE && status != TP_STATUS_WRONG_FORMAT)
+    {
+        return nullptr;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return reinterpret_cast<char *>(header) + ::tx_data_offset;
+}
+
+void
+linuxpp::net::packet_socket::commit_tx_frame(const std::size_t length)
+{
+    if (length > this->tx_frame_capacity())
+    {
+        throw ndgpp_error(std::invalid_argument, "packet_socket frame exceeds the TX frame capacity");
+    }
+
+    struct ::tpacket3_hdr * const header = this->tx_header(this->tx_.index);
+    header->tp_len = static_cast<std::uint32_t>(length);
+    header->tp_snaplen = static_cast<std::uint32_t>(length);
+    header->tp_next_offset = 0;
+
+    // The frame must be written before the kernel can see it
+    std::atomic_thread_fence(std::memory_order_release);
+    reinterpret_cast<volatile std::uint32_t &>(header->tp_status) = TP_STATUS_SEND_REQUEST;
+
+    const std::size_t frame_count = this->tx_.frames_per_block * this->tx_.block_count;
+    this->tx_.index = (this->tx_.index + 1) % frame_count;
+}
+
+bool
+linuxpp::net::packet_socket::queue(void const * const data, const std::size_t length)
+{
+    if (length > this->tx_frame_capacity())
+    {
+        throw ndgpp_error(std::invalid_argument, "packet_socket frame exceeds the TX frame capacity");
+    }
+
+    void * const frame = this->tx_frame();
+    if (frame == nullptr)
+    {
+        return false;
+    }
+
+    std::memcpy(frame, data, length);
+    this->commit_tx_frame(length);
+    return true;
+}
+
+void
+linuxpp::net::packet_socket::flush(const int flags)
+{
+    if (::send(this->descriptor(), nullptr, 0, flags) == -1 && errno != EAGAIN)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code (errno, std::system_category()),
+                          "failed to send the packet TX ring");
+    }
+}
+
+void
+linuxpp::net::packet_socket::attach(linuxpp::ioloop & loop, frame_handler handler)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "packet_socket is already attached to an ioloop");
+    }
+
+    loop.add_handler(this->descriptor(),
+                     linuxpp::ioloop::event_enum::read,
+                     [this, handler] (int, uint32_t) { this->receive(handler); });
+    this->loop_ = &loop;
+}
+
+void
+linuxpp::net::packet_socket::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    this->loop_->remove_handler(this->descriptor());
+    this->loop_ = nullptr;
+}
+
+struct ::tpacket_stats_v3
+linuxpp::net::packet_socket::statistics()
+{
+    return linuxpp::net::getsockopt<linuxpp::net::so::packet_statistics>(this->descriptor()).option_value;
+}
+
+int
+linuxpp::net::packet_socket::ifindex() const noexcept
+{
+    return this->ifindex_;
+}
+
+int
+linuxpp::net::packet_socket::descriptor() const noexcept
+{
+    return this->socket_.get();
+}
@@ -1,3 +1,8 @@
+#include <sys/socket.h>
+#include <time.h>
+
+#include <cerrno>
+
 #include <stdexcept>
 #include <tuple>
 
@@ -6,20 +11,218 @@
 #include <liblinuxpp/net/recv.hpp>
 #include <liblinuxpp/net/sockaddr.hpp>
 
+namespace detail
+{
+namespace
+{
+    /** Calls recvmsg
+     *
+     *  @param name_length [out] The length of the source address
+     *                     written by the kernel
+     */
+    linuxpp::syscall_return<::ssize_t> recvmsg(const int sd,
+                                               struct iovec * const buffs,
+                                               const std::size_t size_buffs,
+                                               void * const msg_name,
+                                               const socklen_t size_msg_name,
+                                               linuxpp::net::cmsg::parser * const control,
+                                               const int flags,
+                                               socklen_t & name_length) noexcept
+    {
+        struct msghdr msghdr = {};
+        msghdr.msg_name = msg_name;
+        msghdr.msg_namelen = size_msg_name;
+        msghdr.msg_iov = buffs;
+        msghdr.msg_iovlen = size_buffs;
+        msghdr.msg_control = nullptr;
+        msghdr.msg_controllen = 0;
+        if (control != nullptr)
+        {
+            control->prepare(msghdr);
+        }
+
+        const ::ssize_t ret = ::recvmsg(sd, &msghdr, flags);
+        if (ret == -1)
+        {
+            return linuxpp::syscall_return<::ssize_t> {errno, ret};
+        }
+
+        name_length = msghdr.msg_namelen;
+        if (control != nullptr)
+        {
+            control->received(msghdr);
+        }
+
+        return linuxpp::syscall_return<::ssize_t> {ret};
+    }
+
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_buffs,
+                                            void * const msg_name,
+                                            const socklen_t size_msg_name,
+                                            linuxpp::net::cmsg::parser * const control,
+                                            const int flags) noexcept
+    {
+        socklen_t name_length = 0;
+        const auto ret = detail::recvmsg(sd, buffs, size_buffs, msg_name, size_msg_name, control, flags, name_length);
+        if (ret && name_length != size_msg_name)
+        {
+            return linuxpp::syscall_return<::ssize_t> {EINVAL, -1};
+        }
+
+        return ret;
+    }
+
+    std::size_t recv(const int sd,
+                     struct iovec * const buffs,
+                     const std::size_t size_buffs,
+                     void * const msg_name,
+                     const socklen_t size_msg_name,
+                     linuxpp::net::cmsg::parser * const control,
+                     const int flags)
+    {
+        socklen_t name_length = 0;
+        const auto ret = detail::recvmsg(sd, buffs, size_buffs, msg_name, size_msg_name, control, flags, name_length);
+        const ::ssize_t length = linuxpp::value_or_throw(ret, "recvmsg failed");
+        if (name_length != size_msg_name)
+        {
+            throw ndgpp_error(std::invalid_argument,
+                              "msg_name length missmatch in recvmsg");
+        }
+
+        return static_cast<std::size_t>(length);
+    }
+
+    /// Calls recvmsg with a control buffer large enough for a receive timestamp
+    linuxpp::syscall_return<::ssize_t> recv(std::nothrow_t,
+                                            const int sd,
+                                            struct iovec * const buffs,
+                                            const std::size_t size_buffs,
+                                            void * const msg_name,
+                                            const socklen_t size_msg_name,
+                                            struct ::timespec & timestamp,
+                                            const int flags) noexcept
+    {
+        linuxpp::net::cmsg::control_buffer<linuxpp::net::timestamp_control_size> buffer;
+        linuxpp::net::cmsg::parser control {buffer};
+        const auto ret = detail::recv(std::nothrow, sd, buffs, size_buffs, msg_name, size_msg_name, &control, flags);
+        if (ret)
+        {
+            timestamp = linuxpp::net::receive_timestamp(control);
+        }
+
+        return ret;
+    }
+
+    std::size_t recv(const int sd,
+                     struct iovec * const buffs,
+                     const std::size_t size_buffs,
+                     void * const msg_name,
+                     const socklen_t size_msg_name,
+                     struct ::timespec & timestamp,
+                     const int flags)
+    {
+        linuxpp::net::cmsg::control_buffer<linuxpp::net::timestamp_control_size> buffer;
+        linuxpp::net::cmsg::parser control {buffer};
+        const std::size_t ret = detail::recv(sd, buffs, size_buffs, msg_name, size_msg_name, &control, flags);
+        timestamp = linuxpp::net::receive_timestamp(control);
+        return ret;
+    }
+
+    linuxpp::syscall_return<::ssize_t> recvmmsg(const int sd,
+                                                struct ::mmsghdr * const msgs,
+                                                const std::size_t size_msgs,
+                                                const int flags,
+                                                struct ::timespec * const timeout) noexcept
+    {
+        const int ret = ::recvmmsg(sd, msgs, size_msgs, flags, timeout);
+        if (ret == -1)
+        {
+            return linuxpp::syscall_return<::ssize_t> {errno, ret};
+        }
+
+        return linuxpp::syscall_return<::ssize_t> {ret};
+    }
+
+    struct ::timespec make_timespec(const std::chrono::nanoseconds timeout) noexcept
+    {
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        struct ::timespec timespec = {};
+        timespec.tv_sec = seconds.count();
+        timespec.tv_nsec = (timeout - seconds).count();
+        return timespec;
+    }
+}
+}
+
+struct ::timespec linuxpp::net::receive_timestamp(const struct ::msghdr & msg) noexcept
+{
+    return linuxpp::net::receive_timestamp(linuxpp::net::cmsg::parser {msg});
+}
+
+struct ::timespec linuxpp::net::receive_timestamp(const linuxpp::net::cmsg::parser & control) noexcept
+{
+    struct ::timespec timestamp = {};
+    if (control.get<linuxpp::net::cmsg::timestamp_ns>(timestamp))
+    {
+        return timestamp;
+    }
+
+    linuxpp::net::cmsg::scm_timestamping timestamps = {};
+    if (control.get<linuxpp::net::cmsg::timestamping>(timestamps))
+    {
+        // Prefer the software timestamp, the raw hardware timestamp
+        // is only set when hardware timestamping is enabled
+        const bool has_software = timestamps.software.tv_sec != 0 || timestamps.software.tv_nsec != 0;
+        return has_software ? timestamps.software : timestamps.hardware;
+    }
+
+    return timestamp;
+}
+
+// void * buffer based functions
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      const int flags) noexcept
+{
+    const ::ssize_t ret = ::recv(sd, buf, len, flags);
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
 std::size_t linuxpp::net::recv(const int sd,
                                void * buf,
                                const std::size_t len,
                                const int flags)
 {
-    const int ret = ::recv(sd, buf, len, flags);
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::net::recv(std::nothrow, sd, buf, len, flags),
+                                                            "recv failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      struct ::sockaddr * sockaddr,
+                                                      ::socklen_t * addrlen,
+                                                      const int flags) noexcept
+{
+    const ::ssize_t ret = ::recvfrom(sd, buf, len, flags, sockaddr, addrlen);
     if (ret == -1)
     {
-        throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
-                          "recv failed");
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
     }
 
-    return static_cast<std::size_t>(ret);
+    return linuxpp::syscall_return<::ssize_t> {ret};
 }
 
 std::size_t linuxpp::net::recv(const int sd,
@@ -29,15 +232,31 @@ std::size_t linuxpp::net::recv(const int sd,
                                ::socklen_t * addrlen,
                                const int flags)
 {
-    const int ret = ::recvfrom(sd, buf, len, flags, sockaddr, addrlen);
-    if (ret == -1)
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::net::recv(std::nothrow, sd, buf, len, sockaddr, addrlen, flags),
+                                                            "recvfrom failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      struct ::sockaddr_in & sockaddr,
+                                                      const int flags) noexcept
+{
+    ::socklen_t addr_len = sizeof(sockaddr);
+    const auto ret = linuxpp::net::recv(std::nothrow,
+                                        sd,
+                                        buf,
+                                        len,
+                                        reinterpret_cast<struct ::sockaddr *>(&sockaddr),
+                                        &addr_len,
+                                        flags);
+    if (ret && addr_len != sizeof(sockaddr))
     {
-        throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
-                          "recvfrom failed");
+        return linuxpp::syscall_return<::ssize_t> {EINVAL, -1};
     }
 
-    return static_cast<std::size_t>(ret);
+    return ret;
 }
 
 std::size_t linuxpp::net::recv(const int sd,
@@ -62,6 +281,24 @@ std::size_t linuxpp::net::recv(const int sd,
     return ret;
 }
 
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      ndgpp::net::ipv4_address & addr,
+                                                      ndgpp::net::port & port,
+                                                      const int flags) noexcept
+{
+    struct ::sockaddr_in sockaddr = {};
+    const auto ret = linuxpp::net::recv(std::nothrow, sd, buf, len, sockaddr, flags);
+    if (ret)
+    {
+        std::tie(addr, port) = linuxpp::net::parse_sockaddr(sockaddr);
+    }
+
+    return ret;
+}
+
 std::size_t linuxpp::net::recv(const int sd,
                                void * buf,
                                const std::size_t len,
@@ -75,43 +312,15 @@ std::size_t linuxpp::net::recv(const int sd,
     return ret;
 }
 
-namespace detail
-{
-namespace
-{
-    std::size_t recv(const int sd,
-                     struct iovec * const buffs,
-                     const std::size_t size_buffs,
-                     void * const msg_name,
-                     const socklen_t size_msg_name,
-                     const bool variable_name_length,
-                     const int flags)
-    {
-        struct msghdr msghdr = {};
-        msghdr.msg_name = msg_name;
-        msghdr.msg_namelen = size_msg_name;
-        msghdr.msg_iov = buffs;
-        msghdr.msg_iovlen = size_buffs;
-        msghdr.msg_control = nullptr;
-        msghdr.msg_controllen = 0;
-
-        const int ret = ::recvmsg(sd, &msghdr, flags);
-        if (ret == -1)
-        {
-            throw ndgpp_error(std::system_error,
-                              std::error_code (errno, std::system_category()),
-                              "recvmsg failed");
-        }
-
-        if (!variable_name_length && msghdr.msg_namelen != size_msg_name)
-        {
-            throw ndgpp_error(std::invalid_argument,
-                              "msg_name length missmatch in recvmsg");
-        }
+// struct iovec based functions
 
-        return static_cast<std::size_t>(ret);
-    }
-}
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      const int flags) noexcept
+{
+    return detail::recv(std::nothrow, sd, buffs, size_buffs, nullptr, 0, nullptr, flags);
 }
 
 std::size_t linuxpp::net::recv(const int sd,
@@ -119,7 +328,17 @@ std::size_t linuxpp::net::recv(const int sd,
                                const std::size_t size_buffs,
                                const int flags)
 {
-    return detail::recv(sd, buffs, size_buffs, nullptr, 0, false, flags);
+    return detail::recv(sd, buffs, size_buffs, nullptr, 0, nullptr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      struct ::sockaddr_in & sockaddr,
+                                                      const int flags) noexcept
+{
+    return detail::recv(std::nothrow, sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), nullptr, flags);
 }
 
 std::size_t linuxpp::net::recv(const int sd,
@@ -128,7 +347,25 @@ std::size_t linuxpp::net::recv(const int sd,
                                struct ::sockaddr_in & sockaddr,
                                const int flags)
 {
-    return detail::recv(sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), false, flags);
+    return detail::recv(sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), nullptr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      ndgpp::net::ipv4_address & addr,
+                                                      ndgpp::net::port & port,
+                                                      const int flags) noexcept
+{
+    struct sockaddr_in sockaddr = {};
+    const auto ret = linuxpp::net::recv(std::nothrow, sd, buffs, size_buffs, sockaddr, flags);
+    if (ret)
+    {
+        std::tie(addr, port) = linuxpp::net::parse_sockaddr(sockaddr);
+    }
+
+    return ret;
 }
 
 std::size_t linuxpp::net::recv(const int sd,
@@ -143,3 +380,217 @@ std::size_t linuxpp::net::recv(const int sd,
     std::tie(addr, port) = linuxpp::net::parse_sockaddr(sockaddr);
     return ret;
 }
+
+// receive timestamp functions
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      struct ::timespec & timestamp,
+                                                      const int flags) noexcept
+{
+    return detail::recv(std::nothrow, sd, buffs, size_buffs, nullptr, 0, timestamp, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               struct iovec * const buffs,
+                               const std::size_t size_buffs,
+                               struct ::timespec & timestamp,
+                               const int flags)
+{
+    return detail::recv(sd, buffs, size_buffs, nullptr, 0, timestamp, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      struct ::sockaddr_in & sockaddr,
+                                                      struct ::timespec & timestamp,
+                                                      const int flags) noexcept
+{
+    return detail::recv(std::nothrow, sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), timestamp, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               struct iovec * const buffs,
+                               const std::size_t size_buffs,
+                               struct ::sockaddr_in & sockaddr,
+                               struct ::timespec & timestamp,
+                               const int flags)
+{
+    return detail::recv(sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), timestamp, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      struct ::timespec & timestamp,
+                                                      const int flags) noexcept
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(std::nothrow, sd, &iovec, 1, nullptr, 0, timestamp, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               void * buf,
+                               const std::size_t len,
+                               struct ::timespec & timestamp,
+                               const int flags)
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(sd, &iovec, 1, nullptr, 0, timestamp, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      struct ::sockaddr_in & sockaddr,
+                                                      struct ::timespec & timestamp,
+                                                      const int flags) noexcept
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(std::nothrow, sd, &iovec, 1, &sockaddr, sizeof(sockaddr), timestamp, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               void * buf,
+                               const std::size_t len,
+                               struct ::sockaddr_in & sockaddr,
+                               struct ::timespec & timestamp,
+                               const int flags)
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(sd, &iovec, 1, &sockaddr, sizeof(sockaddr), timestamp, flags);
+}
+
+// control message functions
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      linuxpp::net::cmsg::parser & control,
+                                                      const int flags) noexcept
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(std::nothrow, sd, &iovec, 1, nullptr, 0, &control, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               void * buf,
+                               const std::size_t len,
+                               linuxpp::net::cmsg::parser & control,
+                               const int flags)
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(sd, &iovec, 1, nullptr, 0, &control, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      void * buf,
+                                                      const std::size_t len,
+                                                      struct ::sockaddr_in & sockaddr,
+                                                      linuxpp::net::cmsg::parser & control,
+                                                      const int flags) noexcept
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(std::nothrow, sd, &iovec, 1, &sockaddr, sizeof(sockaddr), &control, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               void * buf,
+                               const std::size_t len,
+                               struct ::sockaddr_in & sockaddr,
+                               linuxpp::net::cmsg::parser & control,
+                               const int flags)
+{
+    struct iovec iovec = {buf, len};
+    return detail::recv(sd, &iovec, 1, &sockaddr, sizeof(sockaddr), &control, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      linuxpp::net::cmsg::parser & control,
+                                                      const int flags) noexcept
+{
+    return detail::recv(std::nothrow, sd, buffs, size_buffs, nullptr, 0, &control, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               struct iovec * const buffs,
+                               const std::size_t size_buffs,
+                               linuxpp::net::cmsg::parser & control,
+                               const int flags)
+{
+    return detail::recv(sd, buffs, size_buffs, nullptr, 0, &control, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec * const buffs,
+                                                      const std::size_t size_buffs,
+                                                      struct ::sockaddr_in & sockaddr,
+                                                      linuxpp::net::cmsg::parser & control,
+                                                      const int flags) noexcept
+{
+    return detail::recv(std::nothrow, sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), &control, flags);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               struct iovec * const buffs,
+                               const std::size_t size_buffs,
+                               struct ::sockaddr_in & sockaddr,
+                               linuxpp::net::cmsg::parser & control,
+                               const int flags)
+{
+    return detail::recv(sd, buffs, size_buffs, &sockaddr, sizeof(sockaddr), &control, flags);
+}
+
+// struct mmsghdr based functions
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct ::mmsghdr * const msgs,
+                                                      const std::size_t size_msgs,
+                                                      const int flags) noexcept
+{
+    return detail::recvmmsg(sd, msgs, size_msgs, flags, nullptr);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               struct ::mmsghdr * const msgs,
+                               const std::size_t size_msgs,
+                               const int flags)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(detail::recvmmsg(sd, msgs, size_msgs, flags, nullptr),
+                                                            "recvmmsg failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::recv(std::nothrow_t,
+                                                      const int sd,
+                                                      struct ::mmsghdr * const msgs,
+                                                      const std::size_t size_msgs,
+                                                      const int flags,
+                                                      const std::chrono::nanoseconds timeout) noexcept
+{
+    struct ::timespec timespec = detail::make_timespec(timeout);
+    return detail::recvmmsg(sd, msgs, size_msgs, flags, &timespec);
+}
+
+std::size_t linuxpp::net::recv(const int sd,
+                               struct ::mmsghdr * const msgs,
+                               const std::size_t size_msgs,
+                               const int flags,
+                               const std::chrono::nanoseconds timeout)
+{
+    struct ::timespec timespec = detail::make_timespec(timeout);
+    return static_cast<std::size_t>(linuxpp::value_or_throw(detail::recvmmsg(sd, msgs, size_msgs, flags, &timespec),
+                                                            "recvmmsg failed"));
+}
@@ -0,0 +1,53 @@
+#include <linux/filter.h>
+#include <sys/socket.h>
+
+#include <stdexcept>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/reuseport_group.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+
+linuxpp::net::bpf::program
+linuxpp::net::reuseport_program(const linuxpp::net::reuseport_steering steering,
+                                const std::uint32_t group_size)
+{
+    if (group_size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "reuseport group size cannot be 0");
+    }
+
+    using linuxpp::net::bpf::jump;
+    using linuxpp::net::bpf::stmt;
+
+    switch (steering)
+    {
+        case linuxpp::net::reuseport_steering::cpu:
+            return {stmt(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_CPU),
+                    stmt(BPF_ALU | BPF_MOD | BPF_K, group_size),
+                    stmt(BPF_RET | BPF_A, 0)};
+
+        case linuxpp::net::reuseport_steering::hash:
+            // Returning an index outside of the group makes the
+            // kernel fall back to its own 4-tuple hash, which is used
+            // for packets without a receive hash
+            return {stmt(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_RXHASH),
+                    jump(BPF_JMP | BPF_JEQ | BPF_K, 0, 2, 0),
+                    stmt(BPF_ALU | BPF_MOD | BPF_K, group_size),
+                    stmt(BPF_RET | BPF_A, 0),
+                    stmt(BPF_RET | BPF_K, group_size)};
+
+        case linuxpp::net::reuseport_steering::kernel:
+            break;
+    }
+
+    throw ndgpp_error(std::invalid_argument, "reuseport steering policy has no program");
+}
+
+void
+linuxpp::net::attach_reuseport_program(const int sd,
+                                       const linuxpp::net::bpf::program & program)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::attach_reuseport_cbpf>(sd, program.fprog());
+}
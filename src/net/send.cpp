@@ -1,23 +1,63 @@
 #include <sys/types.h>
 
+#include <cerrno>
+
 #include <libndgpp/error.hpp>
 
 #include <liblinuxpp/net/send.hpp>
 #include <liblinuxpp/net/sockaddr.hpp>
 
-std::size_t linuxpp::net::send(const int sd,
-                               const struct msghdr msg,
-                               const int flags)
+namespace
+{
+    struct msghdr make_msghdr(struct iovec const * buffers,
+                              const std::size_t size_buffers,
+                              struct ::sockaddr_in const * const sockaddr) noexcept
+    {
+        struct msghdr msghdr = {};
+        if (sockaddr != nullptr)
+        {
+            msghdr.msg_name = const_cast<struct ::sockaddr_in *>(sockaddr);
+            msghdr.msg_namelen = sizeof(struct ::sockaddr_in);
+        }
+
+        msghdr.msg_iov = const_cast<struct iovec*>(buffers);
+        msghdr.msg_iovlen = size_buffers;
+        return msghdr;
+    }
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      const struct msghdr msg,
+                                                      const int flags) noexcept
 {
     const ssize_t ret = ::sendmsg(sd, &msg, flags);
     if (ret == -1)
     {
-        throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
-                          "sendmsg failed");
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
     }
 
-    return static_cast<std::size_t>(ret);
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
+std::size_t linuxpp::net::send(const int sd,
+                               const struct msghdr msg,
+                               const int flags)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::net::send(std::nothrow, sd, msg, flags),
+                                                            "sendmsg failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int fd,
+                                                      struct iovec const * buffers,
+                                                      const std::size_t size_buffers,
+                                                      const ndgpp::net::ipv4_address address,
+                                                      const ndgpp::net::port port,
+                                                      const int flags) noexcept
+{
+    const struct ::sockaddr_in sockaddr = linuxpp::net::make_sockaddr(address, port);
+    return linuxpp::net::send(std::nothrow, fd, ::make_msghdr(buffers, size_buffers, &sockaddr), flags);
 }
 
 std::size_t linuxpp::net::send(const int fd,
@@ -27,15 +67,17 @@ std::size_t linuxpp::net::send(const int fd,
                                const ndgpp::net::port port,
                                const int flags)
 {
-    struct ::sockaddr_in sockaddr = linuxpp::net::make_sockaddr(address, port);
-    struct msghdr msghdr = {};
-
-    msghdr.msg_name = &sockaddr;
-    msghdr.msg_namelen = sizeof(struct ::sockaddr_in);
-    msghdr.msg_iov = const_cast<struct iovec*>(buffers);
-    msghdr.msg_iovlen = size_buffers;
+    const struct ::sockaddr_in sockaddr = linuxpp::net::make_sockaddr(address, port);
+    return linuxpp::net::send(fd, ::make_msghdr(buffers, size_buffers, &sockaddr), flags);
+}
 
-    return linuxpp::net::send(fd, msghdr, flags);
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int fd,
+                                                      struct iovec const * buffers,
+                                                      const std::size_t size_buffers,
+                                                      const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, fd, ::make_msghdr(buffers, size_buffers, nullptr), flags);
 }
 
 std::size_t linuxpp::net::send(const int fd,
@@ -43,11 +85,28 @@ std::size_t linuxpp::net::send(const int fd,
                                const std::size_t size_buffers,
                                const int flags)
 {
-    struct msghdr msghdr = {};
-    msghdr.msg_iov = const_cast<struct iovec*>(buffers);
-    msghdr.msg_iovlen = size_buffers;
+    return linuxpp::net::send(fd, ::make_msghdr(buffers, size_buffers, nullptr), flags);
+}
 
-    return linuxpp::net::send(fd, msghdr, flags);
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      void const * const msg,
+                                                      const std::size_t length,
+                                                      const struct ::sockaddr_in sockaddr,
+                                                      const int flags) noexcept
+{
+    const ssize_t ret = ::sendto(sd,
+                                 msg,
+                                 length,
+                                 flags,
+                                 reinterpret_cast<const struct ::sockaddr *>(&sockaddr),
+                                 sizeof(struct ::sockaddr_in));
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
 }
 
 std::size_t linuxpp::net::send(const int sd,
@@ -56,20 +115,24 @@ std::size_t linuxpp::net::send(const int sd,
                                const struct ::sockaddr_in sockaddr,
                                const int flags)
 {
-    const int ret = ::sendto(sd,
-                             msg,
-                             length,
-                             flags,
-                             reinterpret_cast<const struct ::sockaddr *>(&sockaddr),
-                             sizeof(struct ::sockaddr_in));
-    if (ret == -1)
-    {
-        throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
-                          "sendmsg failed");
-    }
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::net::send(std::nothrow, sd, msg, length, sockaddr, flags),
+                                                            "sendto failed"));
+}
 
-    return static_cast<std::size_t>(ret);
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      void const * const msg,
+                                                      const std::size_t length,
+                                                      const ndgpp::net::ipv4_address address,
+                                                      const ndgpp::net::port port,
+                                                      const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow,
+                              sd,
+                              msg,
+                              length,
+                              linuxpp::net::make_sockaddr(address, port),
+                              flags);
 }
 
 std::size_t linuxpp::net::send(const int sd,
@@ -86,19 +149,142 @@ std::size_t linuxpp::net::send(const int sd,
                               flags);
 }
 
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      void const * const msg,
+                                                      const std::size_t length,
+                                                      const int flags) noexcept
+{
+    const ssize_t ret = ::send(sd, msg, length, flags);
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
 std::size_t linuxpp::net::send(const int sd,
                                void const * const msg,
                                const std::size_t length,
                                const int flags)
 {
-    const int ret = ::send(sd, msg, length, flags);
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::net::send(std::nothrow, sd, msg, length, flags),
+                                                            "send failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      void const * const msg,
+                                                      const std::size_t length,
+                                                      const linuxpp::net::cmsg::builder & control,
+                                                      const int flags) noexcept
+{
+    struct iovec iovec = {const_cast<void *>(msg), length};
+    return linuxpp::net::send(std::nothrow, sd, &iovec, 1, control, flags);
+}
+
+std::size_t linuxpp::net::send(const int sd,
+                               void const * const msg,
+                               const std::size_t length,
+                               const linuxpp::net::cmsg::builder & control,
+                               const int flags)
+{
+    struct iovec iovec = {const_cast<void *>(msg), length};
+    return linuxpp::net::send(sd, &iovec, 1, control, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      void const * const msg,
+                                                      const std::size_t length,
+                                                      const struct ::sockaddr_in sockaddr,
+                                                      const linuxpp::net::cmsg::builder & control,
+                                                      const int flags) noexcept
+{
+    struct iovec iovec = {const_cast<void *>(msg), length};
+    return linuxpp::net::send(std::nothrow, sd, &iovec, 1, sockaddr, control, flags);
+}
+
+std::size_t linuxpp::net::send(const int sd,
+                               void const * const msg,
+                               const std::size_t length,
+                               const struct ::sockaddr_in sockaddr,
+                               const linuxpp::net::cmsg::builder & control,
+                               const int flags)
+{
+    struct iovec iovec = {const_cast<void *>(msg), length};
+    return linuxpp::net::send(sd, &iovec, 1, sockaddr, control, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec const * buffers,
+                                                      const std::size_t size_buffers,
+                                                      const linuxpp::net::cmsg::builder & control,
+                                                      const int flags) noexcept
+{
+    struct msghdr msghdr = ::make_msghdr(buffers, size_buffers, nullptr);
+    control.apply(msghdr);
+    return linuxpp::net::send(std::nothrow, sd, msghdr, flags);
+}
+
+std::size_t linuxpp::net::send(const int sd,
+                               struct iovec const * buffers,
+                               const std::size_t size_buffers,
+                               const linuxpp::net::cmsg::builder & control,
+                               const int flags)
+{
+    struct msghdr msghdr = ::make_msghdr(buffers, size_buffers, nullptr);
+    control.apply(msghdr);
+    return linuxpp::net::send(sd, msghdr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      struct iovec const * buffers,
+                                                      const std::size_t size_buffers,
+                                                      const struct ::sockaddr_in sockaddr,
+                                                      const linuxpp::net::cmsg::builder & control,
+                                                      const int flags) noexcept
+{
+    struct msghdr msghdr = ::make_msghdr(buffers, size_buffers, &sockaddr);
+    control.apply(msghdr);
+    return linuxpp::net::send(std::nothrow, sd, msghdr, flags);
+}
+
+std::size_t linuxpp::net::send(const int sd,
+                               struct iovec const * buffers,
+                               const std::size_t size_buffers,
+                               const struct ::sockaddr_in sockaddr,
+                               const linuxpp::net::cmsg::builder & control,
+                               const int flags)
+{
+    struct msghdr msghdr = ::make_msghdr(buffers, size_buffers, &sockaddr);
+    control.apply(msghdr);
+    return linuxpp::net::send(sd, msghdr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::send(std::nothrow_t,
+                                                      const int sd,
+                                                      struct ::mmsghdr * const msgs,
+                                                      const std::size_t size_msgs,
+                                                      const int flags) noexcept
+{
+    const int ret = ::sendmmsg(sd, msgs, size_msgs, flags);
     if (ret == -1)
     {
-        throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
-                          "send failed");
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
     }
 
-    return static_cast<std::size_t>(ret);
+    return linuxpp::syscall_return<::ssize_t> {ret};
 }
 
+std::size_t linuxpp::net::send(const int sd,
+                               struct ::mmsghdr * const msgs,
+                               const std::size_t size_msgs,
+                               const int flags)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::net::send(std::nothrow, sd, msgs, size_msgs, flags),
+                                                            "sendmmsg failed"));
+}
@@ -0,0 +1,317 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/socket_proxy.hpp>
+#include <liblinuxpp/splice.hpp>
+
+namespace
+{
+    void set_nonblocking(const int fd)
+    {
+        const int flags = linuxpp::fcntl(fd, F_GETFL);
+        linuxpp::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+
+    std::size_t size_pipe(linuxpp::pipe & pipe, const std::size_t size)
+    {
+        if (size != 0)
+        {
+            linuxpp::fcntl(pipe.write_fd().get(), F_SETPIPE_SZ, static_cast<int>(size));
+        }
+
+        // The kernel rounds the size up to a power of two number of pages
+        return static_cast<std::size_t>(linuxpp::fcntl(pipe.write_fd().get(), F_GETPIPE_SZ));
+    }
+}
+
+bool
+linuxpp::net::socket_proxy::direction::wants_read() const noexcept
+{
+    return !this->eof && !this->blocked && this->buffered < this->capacity;
+}
+
+bool
+linuxpp::net::socket_proxy::direction::wants_write() const noexcept
+{
+    return this->buffered > 0;
+}
+
+bool
+linuxpp::net::socket_proxy::direction::finished() const noexcept
+{
+    return this->shut_down;
+}
+
+linuxpp::net::socket_proxy::socket_proxy(linuxpp::net::tcp_socket && first,
+                                         linuxpp::net::tcp_socket && second,
+                                         const std::size_t pipe_size):
+    first_(std::move(first)),
+    second_(std::move(second)),
+    first_to_second_ {this->first_.descriptor(), this->second_.descriptor(), linuxpp::pipe {O_NONBLOCK}, 0},
+    second_to_first_ {this->second_.descriptor(), this->first_.descriptor(), linuxpp::pipe {O_NONBLOCK}, 0}
+{
+    ::set_nonblocking(this->first_.descriptor());
+    ::set_nonblocking(this->second_.descriptor());
+    this->first_to_second_.capacity = ::size_pipe(this->first_to_second_.pipe, pipe_size);
+    this->second_to_first_.capacity = ::size_pipe(this->second_to_first_.pipe, pipe_size);
+}
+
+linuxpp::net::socket_proxy::~socket_proxy()
+{
+    this->detach();
+}
+
+int
+linuxpp::net::socket_proxy::pump(direction & dir)
+{
+    constexpr unsigned int flags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+    while (true)
+    {
+        bool progress = false;
+        if (dir.wants_read())
+        {
+            const auto ret = linuxpp::splice(std::nothrow, dir.source, dir.pipe, dir.capacity - dir.buffered, flags);
+            if (ret)
+            {
+                if (ret.return_value() == 0)
+                {
+                    dir.eof = true;
+                }
+
+                dir.buffered += static_cast<std::size_t>(ret.return_value());
+                progress = true;
+            }
+            else if (ret.errno_value() == EAGAIN)
+            {
+                // A pipe holds a limited number of buffers, so it can
+                // be full before capacity is reached.  The source may
+                // just be empty, but either way waiting for the
+                // destination to drain the pipe avoids spinning on a
+                // readable source.
+                dir.blocked = dir.buffered > 0;
+            }
+            else
+            {
+                return ret.errno_value();
+            }
+        }
+
+        if (dir.buffered > 0)
+        {
+            const auto ret = linuxpp::splice(std::nothrow, dir.pipe, dir.destination, dir.buffered, flags);
+            if (ret)
+            {
+                dir.buffered -= static_cast<std::size_t>(ret.return_value());
+                dir.forwarded += static_cast<std::uint64_t>(ret.return_value());
+                dir.blocked = false;
+                progress = true;
+            }
+            else if (ret.errno_value() != EAGAIN)
+            {
+                return ret.errno_value();
+            }
+        }
+
+        if (!progress)
+        {
+            break;
+        }
+    }
+
+    if (dir.eof && dir.buffered == 0 && !dir.shut_down)
+    {
+        if (::shutdown(dir.destination, SHUT_WR) == -1)
+        {
+            return errno;
+        }
+
+        dir.shut_down = true;
+    }
+
+    return 0;
+}
+
+void
+linuxpp::net::socket_proxy::handle_events(const int sd, const uint32_t events)
+{
+    this->error_ = this->pump(this->first_to_second_);
+    if (this->error_ == 0)
+    {
+        this->error_ = this->pump(this->second_to_first_);
+    }
+
+    if (this->error_ == 0 && (events & linuxpp::ioloop::event_enum::error))
+    {
+        // An error that the splices didn't report is still pending,
+        // otherwise the socket hung up
+        using traits = linuxpp::net::so::traits<linuxpp::net::so::error>;
+        int value = 0;
+        ::socklen_t length = sizeof(value);
+        if (::getsockopt(sd, traits::level(), traits::name, &value, &length) == -1)
+        {
+            this->error_ = errno;
+        }
+        else if (value != 0)
+        {
+            this->error_ = value;
+        }
+        else if (sd == this->first_.descriptor())
+        {
+            this->first_hung_up_ = true;
+        }
+        else
+        {
+            this->second_hung_up_ = true;
+        }
+    }
+
+    if (!this->done())
+    {
+        this->update_events();
+        return;
+    }
+
+    // The handler may destroy this object, so it's called last
+    this->detach();
+    const done_handler handler = std::move(this->handler_);
+    if (handler)
+    {
+        handler(this->error_);
+    }
+}
+
+void
+linuxpp::net::socket_proxy::update_events()
+{
+    using event_enum = linuxpp::ioloop::event_enum;
+
+    const auto update = [this] (const int sd, uint32_t & registered, const bool hung_up, const uint32_t events) {
+        // A socket is monitored for errors while it's idle, except
+        // once it hung up, after which only a splice can fail
+        const uint32_t wanted = events != 0 ? events | event_enum::error :
+            hung_up ? 0 : event_enum::error;
+
+        if (wanted == registered)
+        {
+            return;
+        }
+
+        if (wanted == 0)
+        {
+            this->loop_->remove_handler(sd);
+        }
+        else if (registered == 0)
+        {
+            this->loop_->add_handler(sd, wanted, [this] (int fd, uint32_t revents) { this->handle_events(fd, revents); });
+        }
+        else
+        {
+            this->loop_->modify_handler(sd, wanted);
+        }
+
+        registered = wanted;
+    };
+
+    update(this->first_.descriptor(),
+           this->first_events_,
+           this->first_hung_up_,
+           (this->first_to_second_.wants_read() ? event_enum::read : 0) |
+           (this->second_to_first_.wants_write() ? event_enum::write : 0));
+
+    update(this->second_.descriptor(),
+           this->second_events_,
+           this->second_hung_up_,
+           (this->second_to_first_.wants_read() ? event_enum::read : 0) |
+           (this->first_to_second_.wants_write() ? event_enum::write : 0));
+}
+
+void
+linuxpp::net::socket_proxy::attach(linuxpp::ioloop & loop, done_handler handler)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "socket_proxy is already attached to an ioloop");
+    }
+
+    this->loop_ = &loop;
+    this->handler_ = std::move(handler);
+    try
+    {
+        this->update_events();
+    }
+    catch (...)
+    {
+        this->detach();
+        throw;
+    }
+}
+
+void
+linuxpp::net::socket_proxy::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    if (this->first_events_ != 0)
+    {
+        this->loop_->remove_handler(this->first_.descriptor());
+        this->first_events_ = 0;
+    }
+
+    if (this->second_events_ != 0)
+    {
+        this->loop_->remove_handler(this->second_.descriptor());
+        this->second_events_ = 0;
+    }
+
+    this->loop_ = nullptr;
+}
+
+bool
+linuxpp::net::socket_proxy::done() const noexcept
+{
+    return this->error_ != 0 ||
+        (this->first_to_second_.finished() && this->second_to_first_.finished());
+}
+
+int
+linuxpp::net::socket_proxy::error() const noexcept
+{
+    return this->error_;
+}
+
+std::uint64_t
+linuxpp::net::socket_proxy::first_to_second() const noexcept
+{
+    return this->first_to_second_.forwarded;
+}
+
+std::uint64_t
+linuxpp::net::socket_proxy::second_to_first() const noexcept
+{
+    return this->second_to_first_.forwarded;
+}
+
+const linuxpp::net::tcp_socket &
+linuxpp::net::socket_proxy::first() const noexcept
+{
+    return this->first_;
+}
+
+const linuxpp::net::tcp_socket &
+linuxpp::net::socket_proxy::second() const noexcept
+{
+    return this->second_;
+}
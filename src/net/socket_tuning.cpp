@@ -0,0 +1,327 @@
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <stdexcept>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/ip_options.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/tcp_options.hpp>
+
+namespace
+{
+    template <class T>
+    using readback_check = bool (*)(const T requested, const T actual);
+
+    template <class T>
+    bool exact(const T requested, const T actual)
+    {
+        return actual == requested;
+    }
+
+    /// For the options the kernel rounds up
+    template <class T>
+    bool at_least(const T requested, const T actual)
+    {
+        return actual >= requested;
+    }
+
+    /// The kernel doubles buffer sizes, a capped size reads back smaller
+    bool doubled(const int requested, const int actual)
+    {
+        return static_cast<std::int64_t>(actual) >= 2 * static_cast<std::int64_t>(requested);
+    }
+
+    /// The kernel owns the ECN bits of a TCP socket's TOS byte
+    bool same_dscp(const int requested, const int actual)
+    {
+        return (actual & ~0x03) == (requested & ~0x03);
+    }
+
+    int to_int(const std::size_t value, char const * const what)
+    {
+        if (value > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        {
+            throw ndgpp_error(std::invalid_argument, what);
+        }
+
+        return static_cast<int>(value);
+    }
+
+    /** Sets SetOption and, when check isn't null, reads back GetOption
+     *
+     *  The two options differ for the SO_*BUFFORCE options, which
+     *  are read back through their SO_*BUF counterparts.
+     */
+    template <class SetOption, class GetOption = SetOption>
+    linuxpp::tuning_status apply_option(const int sd,
+                                        const bool requested,
+                                        const typename linuxpp::net::so::traits<SetOption>::value_type value,
+                                        const readback_check<typename linuxpp::net::so::traits<SetOption>::value_type> check)
+    {
+        using set_traits = linuxpp::net::so::traits<SetOption>;
+        using get_traits = linuxpp::net::so::traits<GetOption>;
+
+        linuxpp::tuning_status status;
+        if (!requested)
+        {
+            return status;
+        }
+
+        status.requested = true;
+        if (::setsockopt(sd, set_traits::level(), set_traits::name, &value, sizeof(value)) == -1)
+        {
+            status.errno_value = errno;
+            return status;
+        }
+
+        if (check == nullptr)
+        {
+            status.applied = true;
+            return status;
+        }
+
+        typename get_traits::value_type actual {};
+        ::socklen_t length = sizeof(actual);
+        if (::getsockopt(sd, get_traits::level(), get_traits::name, &actual, &length) == -1)
+        {
+            status.errno_value = errno;
+            return status;
+        }
+
+        status.applied = length == sizeof(actual) && check(value, actual);
+        return status;
+    }
+}
+
+bool
+linuxpp::net::socket_tuning_result::all_applied() const noexcept
+{
+    for (const auto status : {this->receive_buffer,
+                              this->send_buffer,
+                              this->receive_low_watermark,
+                              this->busy_poll,
+                              this->prefer_busy_poll,
+                              this->incoming_cpu,
+                              this->zerocopy,
+                              this->max_pacing_rate,
+                              this->tos,
+                              this->priority,
+                              this->tcp_nodelay,
+                              this->tcp_quickack,
+                              this->tcp_cork,
+                              this->tcp_notsent_lowat,
+                              this->tcp_defer_accept,
+                              this->tcp_fastopen})
+    {
+        if (status.requested && !status.applied)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+linuxpp::net::socket_tuning::set_receive_buffer(const std::size_t size,
+                                                const bool force)
+{
+    this->receive_buffer_.value = ::to_int(size, "receive buffer size is too large");
+    this->receive_buffer_.requested = true;
+    this->receive_buffer_force_ = force;
+}
+
+void
+linuxpp::net::socket_tuning::set_send_buffer(const std::size_t size,
+                                             const bool force)
+{
+    this->send_buffer_.value = ::to_int(size, "send buffer size is too large");
+    this->send_buffer_.requested = true;
+    this->send_buffer_force_ = force;
+}
+
+void
+linuxpp::net::socket_tuning::set_receive_low_watermark(const std::size_t size)
+{
+    this->receive_low_watermark_.value = ::to_int(size, "receive low watermark is too large");
+    this->receive_low_watermark_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_busy_poll(const std::chrono::microseconds duration)
+{
+    if (duration.count() < 0 || duration.count() > std::numeric_limits<int>::max())
+    {
+        throw ndgpp_error(std::invalid_argument, "invalid busy poll duration");
+    }
+
+    this->busy_poll_.value = static_cast<int>(duration.count());
+    this->busy_poll_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_prefer_busy_poll(const bool enable)
+{
+    this->prefer_busy_poll_.value = enable ? 1 : 0;
+    this->prefer_busy_poll_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_incoming_cpu(const int cpu)
+{
+    if (cpu < 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "invalid CPU number");
+    }
+
+    this->incoming_cpu_.value = cpu;
+    this->incoming_cpu_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_zerocopy(const bool enable)
+{
+    this->zerocopy_.value = enable ? 1 : 0;
+    this->zerocopy_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_max_pacing_rate(const std::uint64_t bytes_per_second)
+{
+    this->max_pacing_rate_.value = bytes_per_second;
+    this->max_pacing_rate_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tos(const int tos)
+{
+    if (tos < 0 || tos > 0xff)
+    {
+        throw ndgpp_error(std::invalid_argument, "invalid TOS value");
+    }
+
+    this->tos_.value = tos;
+    this->tos_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_priority(const int priority)
+{
+    this->priority_.value = priority;
+    this->priority_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tcp_nodelay(const bool enable)
+{
+    this->tcp_nodelay_.value = enable ? 1 : 0;
+    this->tcp_nodelay_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tcp_quickack(const bool enable)
+{
+    this->tcp_quickack_.value = enable ? 1 : 0;
+    this->tcp_quickack_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tcp_cork(const bool enable)
+{
+    this->tcp_cork_.value = enable ? 1 : 0;
+    this->tcp_cork_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tcp_notsent_lowat(const std::size_t size)
+{
+    this->tcp_notsent_lowat_.value = ::to_int(size, "TCP not sent low watermark is too large");
+    this->tcp_notsent_lowat_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tcp_defer_accept(const std::chrono::seconds duration)
+{
+    if (duration.count() < 0 || duration.count() > std::numeric_limits<int>::max())
+    {
+        throw ndgpp_error(std::invalid_argument, "invalid TCP defer accept duration");
+    }
+
+    this->tcp_defer_accept_.value = static_cast<int>(duration.count());
+    this->tcp_defer_accept_.requested = true;
+}
+
+void
+linuxpp::net::socket_tuning::set_tcp_fastopen(const int queue_length)
+{
+    if (queue_length < 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "invalid TCP fast open queue length");
+    }
+
+    this->tcp_fastopen_.value = queue_length;
+    this->tcp_fastopen_.requested = true;
+}
+
+linuxpp::net::socket_tuning_result
+linuxpp::net::socket_tuning::apply(const int sd) const
+{
+    namespace so = linuxpp::net::so;
+
+    linuxpp::net::socket_tuning_result result;
+
+    result.receive_buffer = this->receive_buffer_force_ ?
+        ::apply_option<so::rcv_buf_force, so::rcv_buf>(sd, this->receive_buffer_.requested, this->receive_buffer_.value, ::doubled) :
+        ::apply_option<so::rcv_buf>(sd, this->receive_buffer_.requested, this->receive_buffer_.value, ::doubled);
+
+    result.send_buffer = this->send_buffer_force_ ?
+        ::apply_option<so::snd_buf_force, so::snd_buf>(sd, this->send_buffer_.requested, this->send_buffer_.value, ::doubled) :
+        ::apply_option<so::snd_buf>(sd, this->send_buffer_.requested, this->send_buffer_.value, ::doubled);
+
+    // A low watermark of 0 is stored as 1
+    result.receive_low_watermark = ::apply_option<so::rcv_lowat>(sd,
+                                                                 this->receive_low_watermark_.requested,
+                                                                 this->receive_low_watermark_.value,
+                                                                 ::at_least<int>);
+
+    result.busy_poll = ::apply_option<so::busy_poll>(sd, this->busy_poll_.requested, this->busy_poll_.value, ::exact<int>);
+    result.prefer_busy_poll = ::apply_option<so::prefer_busy_poll>(sd,
+                                                                   this->prefer_busy_poll_.requested,
+                                                                   this->prefer_busy_poll_.value,
+                                                                   ::exact<int>);
+
+    result.incoming_cpu = ::apply_option<so::incoming_cpu>(sd, this->incoming_cpu_.requested, this->incoming_cpu_.value, ::exact<int>);
+    result.zerocopy = ::apply_option<so::zerocopy>(sd, this->zerocopy_.requested, this->zerocopy_.value, ::exact<int>);
+    result.max_pacing_rate = ::apply_option<so::max_pacing_rate>(sd,
+                                                                 this->max_pacing_rate_.requested,
+                                                                 this->max_pacing_rate_.value,
+                                                                 ::exact<std::uint64_t>);
+
+    // Setting the TOS byte also sets the priority, so the priority
+    // has to come second
+    result.tos = ::apply_option<so::tos>(sd, this->tos_.requested, this->tos_.value, ::same_dscp);
+    result.priority = ::apply_option<so::priority>(sd, this->priority_.requested, this->priority_.value, ::exact<int>);
+
+    result.tcp_nodelay = ::apply_option<so::tcp_nodelay>(sd, this->tcp_nodelay_.requested, this->tcp_nodelay_.value, ::exact<int>);
+    result.tcp_quickack = ::apply_option<so::tcp_quickack>(sd, this->tcp_quickack_.requested, this->tcp_quickack_.value, nullptr);
+    result.tcp_cork = ::apply_option<so::tcp_cork>(sd, this->tcp_cork_.requested, this->tcp_cork_.value, ::exact<int>);
+    result.tcp_notsent_lowat = ::apply_option<so::tcp_notsent_lowat>(sd,
+                                                                     this->tcp_notsent_lowat_.requested,
+                                                                     this->tcp_notsent_lowat_.value,
+                                                                     ::exact<int>);
+
+    result.tcp_defer_accept = ::apply_option<so::tcp_defer_accept>(sd,
+                                                                   this->tcp_defer_accept_.requested,
+                                                                   this->tcp_defer_accept_.value,
+                                                                   ::at_least<int>);
+
+    result.tcp_fastopen = ::apply_option<so::tcp_fastopen>(sd, this->tcp_fastopen_.requested, this->tcp_fastopen_.value, ::exact<int>);
+    return result;
+}
@@ -1,3 +1,5 @@
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 
 #include <libndgpp/error.hpp>
@@ -7,6 +9,9 @@
 #include <liblinuxpp/net/connect.hpp>
 #include <liblinuxpp/net/recv.hpp>
 #include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/tcp_options.hpp>
 #include <liblinuxpp/net/tcp_socket.hpp>
 
 
@@ -114,6 +119,19 @@ std::size_t linuxpp::net::tcp_socket::recv(void * buf,
     return linuxpp::net::recv(this->descriptor(), buf, buflen, flags);
 }
 
+void linuxpp::net::tcp_socket::set_timestamps(const bool enable)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::timestamp_ns>(this->descriptor(), enable ? 1 : 0);
+}
+
+std::size_t linuxpp::net::tcp_socket::recv(void * buf,
+                                           const std::size_t buflen,
+                                           struct ::timespec & timestamp,
+                                           const int flags)
+{
+    return linuxpp::net::recv(this->descriptor(), buf, buflen, timestamp, flags);
+}
+
 std::size_t linuxpp::net::tcp_socket::recv(struct ::iovec * const buffs,
                                            const std::size_t size_buffs,
                                            const int flags)
@@ -134,3 +152,95 @@ std::size_t linuxpp::net::tcp_socket::send(struct iovec const * const buffers,
 {
     return linuxpp::net::send(this->descriptor(), buffers, size_buffers, flags);
 }
+
+void linuxpp::net::tcp_socket::set_fastopen(const int queue_length)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::tcp_fastopen>(this->descriptor(), queue_length);
+}
+
+void linuxpp::net::tcp_socket::set_fastopen_connect(const bool enable)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::tcp_fastopen_connect>(this->descriptor(), enable ? 1 : 0);
+}
+
+std::size_t linuxpp::net::tcp_socket::send_fastopen(void const * const buf,
+                                                    const std::size_t length,
+                                                    const ndgpp::net::ipv4_address address,
+                                                    const ndgpp::net::port port,
+                                                    const int flags)
+{
+    return linuxpp::net::send(this->descriptor(), buf, length, address, port, flags | MSG_FASTOPEN);
+}
+
+bool linuxpp::net::tcp_socket::fastopen_accepted() const
+{
+    // The kernel's tcp_info may differ in size from the C library's,
+    // so the length isn't checked
+    struct ::tcp_info info {};
+    ::socklen_t length = sizeof(info);
+    linuxpp::net::getsockopt(this->descriptor(), IPPROTO_TCP, TCP_INFO, &info, &length);
+    return (info.tcpi_options & TCPI_OPT_SYN_DATA) != 0;
+}
+
+linuxpp::syscall_return<int> linuxpp::net::tcp_socket::connect(std::nothrow_t,
+                                                               const ndgpp::net::ipv4_address address,
+                                                               const ndgpp::net::port port) noexcept
+{
+    return linuxpp::net::connect(std::nothrow, this->descriptor(), address, port);
+}
+
+linuxpp::syscall_return<int> linuxpp::net::tcp_socket::accept(std::nothrow_t,
+                                                              const int flags) noexcept
+{
+    return linuxpp::net::accept(std::nothrow, this->descriptor(), flags);
+}
+
+linuxpp::syscall_return<int> linuxpp::net::tcp_socket::accept(std::nothrow_t,
+                                                              ndgpp::net::ipv4_address & addr,
+                                                              ndgpp::net::port & port,
+                                                              const int flags) noexcept
+{
+    return linuxpp::net::accept(std::nothrow, this->descriptor(), addr, port, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::tcp_socket::recv(std::nothrow_t,
+                                                                  void * const buf,
+                                                                  const std::size_t buflen,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buf, buflen, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::tcp_socket::recv(std::nothrow_t,
+                                                                  struct ::iovec * const buffs,
+                                                                  const std::size_t size_buffs,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buffs, size_buffs, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::tcp_socket::send(std::nothrow_t,
+                                                                  void const * const buf,
+                                                                  const std::size_t length,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buf, length, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::tcp_socket::send(std::nothrow_t,
+                                                                  struct iovec const * const buffers,
+                                                                  const std::size_t size_buffers,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buffers, size_buffers, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::tcp_socket::send_fastopen(std::nothrow_t,
+                                                                           void const * const buf,
+                                                                           const std::size_t length,
+                                                                           const ndgpp::net::ipv4_address address,
+                                                                           const ndgpp::net::port port,
+                                                                           const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buf, length, address, port, flags | MSG_FASTOPEN);
+}
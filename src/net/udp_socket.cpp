@@ -6,17 +6,22 @@
 #include <sys/types.h>
 
 #include <cerrno>
+#include <stdexcept>
 #include <system_error>
 
 #include <libndgpp/error.hpp>
 
 #include <liblinuxpp/net/bind.hpp>
+#include <liblinuxpp/net/bpf.hpp>
+#include <liblinuxpp/net/cmsg.hpp>
 #include <liblinuxpp/net/interface.hpp>
 #include <liblinuxpp/net/ip_options.hpp>
 #include <liblinuxpp/net/recv.hpp>
 #include <liblinuxpp/net/send.hpp>
 #include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
 #include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/udp_options.hpp>
 #include <liblinuxpp/net/udp_socket.hpp>
 
 
@@ -100,6 +105,28 @@ std::size_t linuxpp::net::udp_socket::recv(void * buf,
     return linuxpp::net::recv(this->descriptor(), buf, buflen, addr, port, flags);
 }
 
+void linuxpp::net::udp_socket::set_timestamps(const bool enable)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::timestamp_ns>(this->descriptor(), enable ? 1 : 0);
+}
+
+std::size_t linuxpp::net::udp_socket::recv(void * buf,
+                                           const std::size_t buflen,
+                                           struct ::timespec & timestamp,
+                                           const int flags)
+{
+    return linuxpp::net::recv(this->descriptor(), buf, buflen, timestamp, flags);
+}
+
+std::size_t linuxpp::net::udp_socket::recv(void * buf,
+                                           const std::size_t buflen,
+                                           struct ::sockaddr_in & sockaddr,
+                                           struct ::timespec & timestamp,
+                                           const int flags)
+{
+    return linuxpp::net::recv(this->descriptor(), buf, buflen, sockaddr, timestamp, flags);
+}
+
 std::size_t linuxpp::net::udp_socket::recv(struct ::iovec * const buffs,
                                            const std::size_t size_buffs,
                                            const int flags)
@@ -158,6 +185,237 @@ std::size_t linuxpp::net::udp_socket::send(struct iovec const * const buffers,
     return linuxpp::net::send(this->descriptor(), buffers, size_buffers, sockaddr, flags);
 }
 
+std::size_t linuxpp::net::udp_socket::recv(linuxpp::net::message_batch & batch,
+                                           const int flags)
+{
+    batch.prepare_recv();
+    return linuxpp::net::recv(this->descriptor(), batch.data(), batch.size(), flags);
+}
+
+std::size_t linuxpp::net::udp_socket::recv(linuxpp::net::message_batch & batch,
+                                           const int flags,
+                                           const std::chrono::nanoseconds timeout)
+{
+    batch.prepare_recv();
+    return linuxpp::net::recv(this->descriptor(), batch.data(), batch.size(), flags, timeout);
+}
+
+std::size_t linuxpp::net::udp_socket::recv(struct ::mmsghdr * const msgs,
+                                           const std::size_t size_msgs,
+                                           const int flags)
+{
+    return linuxpp::net::recv(this->descriptor(), msgs, size_msgs, flags);
+}
+
+std::size_t linuxpp::net::udp_socket::send(linuxpp::net::message_batch & batch,
+                                           const std::size_t count,
+                                           const int flags)
+{
+    if (count > batch.size())
+    {
+        throw ndgpp_error(std::invalid_argument, "send count exceeds message_batch size");
+    }
+
+    return linuxpp::net::send(this->descriptor(), batch.data(), count, flags);
+}
+
+std::size_t linuxpp::net::udp_socket::send(struct ::mmsghdr * const msgs,
+                                           const std::size_t size_msgs,
+                                           const int flags)
+{
+    return linuxpp::net::send(this->descriptor(), msgs, size_msgs, flags);
+}
+
+std::size_t linuxpp::net::udp_socket::send_segments(void const * const buf,
+                                                    const std::size_t length,
+                                                    const std::uint16_t segment_size,
+                                                    const struct ::sockaddr_in sockaddr,
+                                                    const int flags)
+{
+    if (segment_size == 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "segment size cannot be 0");
+    }
+
+    linuxpp::net::cmsg::buffer_for<linuxpp::net::cmsg::udp_segment> buffer;
+    linuxpp::net::cmsg::builder control {buffer};
+    control.add<linuxpp::net::cmsg::udp_segment>(segment_size);
+
+    return linuxpp::net::send(this->descriptor(), buf, length, sockaddr, control, flags);
+}
+
+std::size_t linuxpp::net::udp_socket::send_segments(void const * const buf,
+                                                    const std::size_t length,
+                                                    const std::uint16_t segment_size,
+                                                    const ndgpp::net::ipv4_address addr,
+                                                    const ndgpp::net::port port,
+                                                    const int flags)
+{
+    return this->send_segments(buf, length, segment_size, linuxpp::net::make_sockaddr(addr, port), flags);
+}
+
+void linuxpp::net::udp_socket::set_gro(const bool enable)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::udp_gro>(this->descriptor(), enable ? 1 : 0);
+}
+
+linuxpp::net::udp_segments linuxpp::net::udp_socket::recv_segments(void * const buf,
+                                                                   const std::size_t buflen,
+                                                                   const int flags)
+{
+    linuxpp::net::cmsg::buffer_for<linuxpp::net::cmsg::udp_gro> buffer;
+    linuxpp::net::cmsg::parser control {buffer};
+    const std::size_t length = linuxpp::net::recv(this->descriptor(), buf, buflen, control, flags);
+
+    // Without a UDP_GRO control message the buffer holds a single datagram
+    int segment_size = 0;
+    control.get<linuxpp::net::cmsg::udp_gro>(segment_size);
+    return linuxpp::net::udp_segments {buf, length < buflen ? length : buflen, static_cast<std::size_t>(segment_size)};
+}
+
+linuxpp::net::udp_segments linuxpp::net::udp_socket::recv_segments(void * const buf,
+                                                                   const std::size_t buflen,
+                                                                   struct ::sockaddr_in & sockaddr,
+                                                                   const int flags)
+{
+    linuxpp::net::cmsg::buffer_for<linuxpp::net::cmsg::udp_gro> buffer;
+    linuxpp::net::cmsg::parser control {buffer};
+    const std::size_t length = linuxpp::net::recv(this->descriptor(), buf, buflen, sockaddr, control, flags);
+
+    int segment_size = 0;
+    control.get<linuxpp::net::cmsg::udp_gro>(segment_size);
+    return linuxpp::net::udp_segments {buf, length < buflen ? length : buflen, static_cast<std::size_t>(segment_size)};
+}
+
+void linuxpp::net::udp_socket::attach_filter(const linuxpp::net::bpf::program & program)
+{
+    linuxpp::net::bpf::attach_filter(this->descriptor(), program);
+}
+
+void linuxpp::net::udp_socket::detach_filter()
+{
+    linuxpp::net::bpf::detach_filter(this->descriptor());
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  void * buf,
+                                                                  const std::size_t buflen,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buf, buflen, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  void * buf,
+                                                                  const std::size_t buflen,
+                                                                  struct ::sockaddr_in & sockaddr,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buf, buflen, sockaddr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  void * buf,
+                                                                  const std::size_t buflen,
+                                                                  ndgpp::net::ipv4_address & addr,
+                                                                  ndgpp::net::port & port,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buf, buflen, addr, port, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  struct ::iovec * const buffs,
+                                                                  const std::size_t size_buffs,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buffs, size_buffs, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  struct ::iovec * const buffs,
+                                                                  const std::size_t size_buffs,
+                                                                  struct ::sockaddr_in & sockaddr,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), buffs, size_buffs, sockaddr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  linuxpp::net::message_batch & batch,
+                                                                  const int flags) noexcept
+{
+    batch.prepare_recv();
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), batch.data(), batch.size(), flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::recv(std::nothrow_t,
+                                                                  struct ::mmsghdr * const msgs,
+                                                                  const std::size_t size_msgs,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::recv(std::nothrow, this->descriptor(), msgs, size_msgs, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::send(std::nothrow_t,
+                                                                  void const * buf,
+                                                                  const std::size_t length,
+                                                                  const ndgpp::net::ipv4_address addr,
+                                                                  const ndgpp::net::port port,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buf, length, addr, port, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::send(std::nothrow_t,
+                                                                  void const * buf,
+                                                                  const std::size_t length,
+                                                                  const struct ::sockaddr_in sockaddr,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buf, length, sockaddr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::send(std::nothrow_t,
+                                                                  struct ::iovec const * const buffers,
+                                                                  const std::size_t size_buffers,
+                                                                  const ndgpp::net::ipv4_address addr,
+                                                                  const ndgpp::net::port port,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buffers, size_buffers, addr, port, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::send(std::nothrow_t,
+                                                                  struct ::iovec const * const buffers,
+                                                                  const std::size_t size_buffers,
+                                                                  const struct ::sockaddr_in sockaddr,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), buffers, size_buffers, sockaddr, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::send(std::nothrow_t,
+                                                                  linuxpp::net::message_batch & batch,
+                                                                  const std::size_t count,
+                                                                  const int flags) noexcept
+{
+    if (count > batch.size())
+    {
+        return linuxpp::syscall_return<::ssize_t> {EINVAL, -1};
+    }
+
+    return linuxpp::net::send(std::nothrow, this->descriptor(), batch.data(), count, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::net::udp_socket::send(std::nothrow_t,
+                                                                  struct ::mmsghdr * const msgs,
+                                                                  const std::size_t size_msgs,
+                                                                  const int flags) noexcept
+{
+    return linuxpp::net::send(std::nothrow, this->descriptor(), msgs, size_msgs, flags);
+}
+
 int linuxpp::net::udp_socket::descriptor() const noexcept
 {
     return std::get<sock_descriptor>(this->members_).get();
@@ -0,0 +1,240 @@
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+
+// Needs struct timespec from time.h
+#include <linux/errqueue.h>
+
+#include <cerrno>
+
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/net/cmsg.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/zerocopy_sender.hpp>
+
+constexpr std::size_t linuxpp::net::zerocopy_sender::default_threshold;
+
+linuxpp::net::zerocopy_sender::zerocopy_sender(const int sd,
+                                               const std::size_t threshold):
+    sd_(sd),
+    threshold_(threshold)
+{
+    linuxpp::net::setsockopt<linuxpp::net::so::zerocopy>(sd, 1);
+}
+
+linuxpp::net::zerocopy_sender::~zerocopy_sender()
+{
+    this->detach();
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::net::zerocopy_sender::send(void const * const buf,
+                                    const std::size_t length,
+                                    completion_handler handler,
+                                    const int flags)
+{
+    struct ::iovec iovec = {const_cast<void *>(buf), length};
+    struct ::msghdr msg = {};
+    msg.msg_iov = &iovec;
+    msg.msg_iovlen = 1;
+    return this->send_msg(msg, length, handler, flags);
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::net::zerocopy_sender::send(const struct ::msghdr & msg,
+                                    completion_handler handler,
+                                    const int flags)
+{
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < msg.msg_iovlen; ++i)
+    {
+        length += msg.msg_iov[i].iov_len;
+    }
+
+    return this->send_msg(msg, length, handler, flags);
+}
+
+linuxpp::syscall_return<::ssize_t>
+linuxpp::net::zerocopy_sender::send_msg(const struct ::msghdr & msg,
+                                        const std::size_t length,
+                                        completion_handler & handler,
+                                        const int flags)
+{
+    if (length < this->threshold_)
+    {
+        const auto ret = linuxpp::net::send(std::nothrow, this->sd_, msg, flags);
+        if (ret && handler)
+        {
+            handler(true);
+        }
+
+        return ret;
+    }
+
+    // Queued before the send, so a successful send can't lose its
+    // handler to a failed allocation
+    this->pending_.push_back(pending_send {std::move(handler)});
+
+    const auto ret = linuxpp::net::send(std::nothrow, this->sd_, msg, flags | MSG_ZEROCOPY);
+    if (!ret)
+    {
+        // A failed send doesn't consume a completion id
+        this->pending_.pop_back();
+        return ret;
+    }
+
+    ++this->pending_count_;
+    return ret;
+}
+
+std::size_t
+linuxpp::net::zerocopy_sender::complete(const std::uint32_t first,
+                                        const std::uint32_t last,
+                                        const bool copied)
+{
+    std::size_t count = 0;
+    for (std::uint32_t id = first; ; ++id)
+    {
+        // Completion ids wrap, so the index relies on unsigned arithmetic
+        const std::uint32_t index = id - this->front_id_;
+        if (index < this->pending_.size() && !this->pending_[index].done)
+        {
+            pending_send & send = this->pending_[index];
+            send.done = true;
+            --this->pending_count_;
+            ++count;
+
+            const completion_handler handler = std::move(send.handler);
+            if (handler)
+            {
+                handler(copied);
+            }
+        }
+
+        if (id == last)
+        {
+            break;
+        }
+    }
+
+    while (!this->pending_.empty() && this->pending_.front().done)
+    {
+        this->pending_.pop_front();
+        ++this->front_id_;
+    }
+
+    return count;
+}
+
+std::size_t
+linuxpp::net::zerocopy_sender::process_completions()
+{
+    namespace cmsg = linuxpp::net::cmsg;
+
+    std::size_t count = 0;
+    cmsg::control_buffer<CMSG_SPACE(sizeof(struct ::sock_extended_err) + sizeof(struct ::sockaddr_in6))> buffer;
+    cmsg::parser control {buffer};
+    while (true)
+    {
+        // The error queue's messages are all control data
+        const auto ret = linuxpp::net::recv(std::nothrow,
+                                            this->sd_,
+                                            static_cast<void *>(nullptr),
+                                            0,
+                                            control,
+                                            MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (!ret)
+        {
+            if (ret.errno_value() == EAGAIN || ret.errno_value() == EWOULDBLOCK)
+            {
+                break;
+            }
+
+            throw ndgpp_error(std::system_error,
+                              std::error_code (ret.errno_value(), std::system_category()),
+                              "failed to read the error queue");
+        }
+
+        for (const auto message : control)
+        {
+            struct ::sock_extended_err error;
+            if (message.is<cmsg::ip_recverr>())
+            {
+                error = message.value<cmsg::ip_recverr>();
+            }
+            else if (message.is<cmsg::ipv6_recverr>())
+            {
+                error = message.value<cmsg::ipv6_recverr>();
+            }
+            else
+            {
+                continue;
+            }
+
+            // The error queue also holds ICMP errors and timestamps
+            if (error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            {
+                continue;
+            }
+
+            // ee_info and ee_data hold an inclusive range of completion ids
+            count += this->complete(error.ee_info,
+                                    error.ee_data,
+                                    (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+        }
+    }
+
+    return count;
+}
+
+std::size_t
+linuxpp::net::zerocopy_sender::pending() const noexcept
+{
+    return this->pending_count_;
+}
+
+std::size_t
+linuxpp::net::zerocopy_sender::threshold() const noexcept
+{
+    return this->threshold_;
+}
+
+void
+linuxpp::net::zerocopy_sender::attach(linuxpp::ioloop & loop)
+{
+    if (this->loop_ != nullptr)
+    {
+        throw ndgpp_error(std::logic_error, "zerocopy_sender is already attached to an ioloop");
+    }
+
+    loop.add_handler(this->sd_,
+                     linuxpp::ioloop::event_enum::error,
+                     [this] (int, uint32_t) { this->process_completions(); });
+    this->loop_ = &loop;
+}
+
+void
+linuxpp::net::zerocopy_sender::detach()
+{
+    if (this->loop_ == nullptr)
+    {
+        return;
+    }
+
+    this->loop_->remove_handler(this->sd_);
+    this->loop_ = nullptr;
+}
+
+int
+linuxpp::net::zerocopy_sender::descriptor() const noexcept
+{
+    return this->sd_;
+}
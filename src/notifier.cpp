@@ -0,0 +1,135 @@
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <new>
+#include <system_error>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/notifier.hpp>
+
+linuxpp::notifier::notifier(const int flags):
+    semaphore_((flags & EFD_SEMAPHORE) != 0),
+    eventfd_(flags | EFD_NONBLOCK)
+{}
+
+linuxpp::notifier::notifier():
+    notifier(0)
+{}
+
+void
+linuxpp::notifier::prepare_wait() noexcept
+{
+    this->sleepers_.fetch_add(1, std::memory_order_relaxed);
+
+    // Order the sleepers_ increment before the consumer's check of
+    // its wake up condition.  Paired with the fence in notify, either
+    // the consumer sees the producer's change, or the producer sees
+    // the consumer waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void
+linuxpp::notifier::finish_wait() noexcept
+{
+    this->sleepers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool
+linuxpp::notifier::notify()
+{
+    // Order the producer's change of the wake up condition before
+    // the sleepers_ load, see linuxpp::notifier::prepare_wait
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->sleepers_.load(std::memory_order_relaxed) == 0)
+    {
+        return false;
+    }
+
+    if (!this->semaphore_ && this->pending_.exchange(true, std::memory_order_relaxed))
+    {
+        // Another producer's notification has not been consumed yet,
+        // and it will wake up the consumer
+        return false;
+    }
+
+    const auto ret = this->eventfd_.write(std::nothrow);
+    if (!ret && ret.errno_value() != EAGAIN)
+    {
+        // the eventfd write failed for a reason other than event
+        // counter overflow
+        throw ndgpp_error(std::system_error,
+                          std::error_code{ret.errno_value(), std::system_category()},
+                          "failed to write to notifier's eventfd");
+    }
+
+    return true;
+}
+
+uint64_t
+linuxpp::notifier::wait()
+{
+    while (true)
+    {
+        const uint64_t value = this->consume();
+        if (value != 0)
+        {
+            return value;
+        }
+
+        // Nothing is pending, or another consumer took the
+        // notification, so block until the eventfd is readable
+        pollfd pfd {this->eventfd_.fd(), POLLIN, 0};
+        const int ret = ::poll(&pfd, 1, -1);
+        if (ret == -1 && errno != EINTR)
+        {
+            throw ndgpp_error(std::system_error,
+                              std::error_code{errno, std::system_category()},
+                              "poll failed on notifier's eventfd");
+        }
+    }
+}
+
+uint64_t
+linuxpp::notifier::consume()
+{
+    uint64_t value = 0;
+    const ssize_t ret = ::read(this->eventfd_.fd(), &value, sizeof(value));
+    if (ret == -1)
+    {
+        if (errno == EAGAIN)
+        {
+            return 0;
+        }
+
+        throw ndgpp_error(std::system_error,
+                          std::error_code{errno, std::system_category()},
+                          "notifier eventfd read failed");
+    }
+
+    if (!this->semaphore_)
+    {
+        // Allow the next notification to be written.  The fence
+        // orders the store before the consumer re-checks its wake up
+        // condition, so a producer that saw pending_ set has its
+        // change observed.
+        this->pending_.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    return value;
+}
+
+bool
+linuxpp::notifier::sleeping() const noexcept
+{
+    return this->sleepers_.load(std::memory_order_relaxed) != 0;
+}
+
+int
+linuxpp::notifier::fd() const
+{
+    return this->eventfd_.fd();
+}
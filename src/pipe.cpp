@@ -61,7 +61,12 @@ linuxpp::syscall_return<ssize_t>
 linuxpp::pipe::write(std::nothrow_t, void const * const buf, const std::size_t size) noexcept
 {
     const ssize_t ret = ::write(this->write_fd().get(), buf, size);
-    return linuxpp::syscall_return<ssize_t>{errno, ret};
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<ssize_t>{errno, ret};
+    }
+
+    return linuxpp::syscall_return<ssize_t>{ret};
 }
 
 std::size_t linuxpp::pipe::write(void const * const buf, const std::size_t size)
@@ -82,7 +87,12 @@ linuxpp::syscall_return<ssize_t>
 linuxpp::pipe::read(std::nothrow_t, void * const buf, const std::size_t size) noexcept
 {
     const ssize_t ret = ::read(this->read_fd().get(), buf, size);
-    return linuxpp::syscall_return<ssize_t>{errno, ret};
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<ssize_t>{errno, ret};
+    }
+
+    return linuxpp::syscall_return<ssize_t>{ret};
 }
 
 std::size_t linuxpp::pipe::read(void * const buf, const std::size_t size)
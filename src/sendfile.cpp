@@ -0,0 +1,30 @@
+#include <sys/sendfile.h>
+#include <sys/types.h>
+
+#include <cerrno>
+
+#include <liblinuxpp/sendfile.hpp>
+
+linuxpp::syscall_return<::ssize_t> linuxpp::sendfile(std::nothrow_t,
+                                                     const int out_fd,
+                                                     const int in_fd,
+                                                     ::off_t * const offset,
+                                                     const std::size_t count) noexcept
+{
+    const ::ssize_t ret = ::sendfile(out_fd, in_fd, offset, count);
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
+std::size_t linuxpp::sendfile(const int out_fd,
+                              const int in_fd,
+                              ::off_t * const offset,
+                              const std::size_t count)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::sendfile(std::nothrow, out_fd, in_fd, offset, count),
+                                                            "sendfile failed"));
+}
@@ -18,7 +18,7 @@ void linuxpp::signal_mutex::lock()
     if (ret != 0)
     {
         throw ndgpp_error(std::system_error,
-                          std::error_code (errno, std::system_category()),
+                          std::error_code (ret, std::system_category()),
                           "failed to block signals");
     }
 }
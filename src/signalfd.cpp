@@ -0,0 +1,87 @@
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/signalfd.hpp>
+
+static sigset_t empty_sigset()
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    return mask;
+}
+
+linuxpp::signalfd::signalfd(const sigset_t & mask,
+                            const int flags):
+    fd_(::signalfd(-1, &mask, flags | SFD_CLOEXEC))
+{
+    if (!this->fd_)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code{errno, std::system_category()},
+                          "signalfd system call failed");
+    }
+}
+
+linuxpp::signalfd::signalfd(const int flags):
+    signalfd(::empty_sigset(), flags)
+{}
+
+linuxpp::signalfd::signalfd():
+    signalfd(::empty_sigset(), 0)
+{}
+
+linuxpp::signalfd::signalfd(linuxpp::signalfd &&) = default;
+linuxpp::signalfd & linuxpp::signalfd::operator= (linuxpp::signalfd &&) = default;
+
+void
+linuxpp::signalfd::set_mask(const sigset_t & mask)
+{
+    const int ret = ::signalfd(this->fd_.get(), &mask, 0);
+    if (ret == -1)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code{errno, std::system_category()},
+                          "signalfd system call failed to set the signal mask");
+    }
+}
+
+std::size_t
+linuxpp::signalfd::read(signalfd_siginfo * const infos,
+                        const std::size_t count)
+{
+    const auto ret = this->read(std::nothrow, infos, count);
+    if (!ret)
+    {
+        throw ndgpp_error(std::system_error,
+                          std::error_code{ret.errno_value(), std::system_category()},
+                          "signalfd read failed");
+    }
+
+    return ret.return_value();
+}
+
+linuxpp::syscall_return<std::size_t>
+linuxpp::signalfd::read(std::nothrow_t,
+                        signalfd_siginfo * const infos,
+                        const std::size_t count)
+{
+    const ssize_t ret = ::read(this->fd_.get(), infos, count * sizeof(signalfd_siginfo));
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<std::size_t> {errno, 0};
+    }
+
+    return linuxpp::syscall_return<std::size_t> {static_cast<std::size_t>(ret) / sizeof(signalfd_siginfo)};
+}
+
+int
+linuxpp::signalfd::fd() const
+{
+    return this->fd_.get();
+}
@@ -0,0 +1,144 @@
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cerrno>
+
+#include <liblinuxpp/splice.hpp>
+
+linuxpp::syscall_return<::ssize_t> linuxpp::splice(std::nothrow_t,
+                                                   const int fd_in,
+                                                   ::loff_t * const off_in,
+                                                   const int fd_out,
+                                                   ::loff_t * const off_out,
+                                                   const std::size_t length,
+                                                   const unsigned int flags) noexcept
+{
+    const ::ssize_t ret = ::splice(fd_in, off_in, fd_out, off_out, length, flags);
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
+std::size_t linuxpp::splice(const int fd_in,
+                            ::loff_t * const off_in,
+                            const int fd_out,
+                            ::loff_t * const off_out,
+                            const std::size_t length,
+                            const unsigned int flags)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::splice(std::nothrow,
+                                                                            fd_in,
+                                                                            off_in,
+                                                                            fd_out,
+                                                                            off_out,
+                                                                            length,
+                                                                            flags),
+                                                            "splice failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::splice(std::nothrow_t,
+                                                   const int fd_in,
+                                                   const int fd_out,
+                                                   const std::size_t length,
+                                                   const unsigned int flags) noexcept
+{
+    return linuxpp::splice(std::nothrow, fd_in, nullptr, fd_out, nullptr, length, flags);
+}
+
+std::size_t linuxpp::splice(const int fd_in,
+                            const int fd_out,
+                            const std::size_t length,
+                            const unsigned int flags)
+{
+    return linuxpp::splice(fd_in, nullptr, fd_out, nullptr, length, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::splice(std::nothrow_t,
+                                                   const int fd_in,
+                                                   linuxpp::pipe & out,
+                                                   const std::size_t length,
+                                                   const unsigned int flags) noexcept
+{
+    return linuxpp::splice(std::nothrow, fd_in, out.write_fd().get(), length, flags);
+}
+
+std::size_t linuxpp::splice(const int fd_in,
+                            linuxpp::pipe & out,
+                            const std::size_t length,
+                            const unsigned int flags)
+{
+    return linuxpp::splice(fd_in, out.write_fd().get(), length, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::splice(std::nothrow_t,
+                                                   linuxpp::pipe & in,
+                                                   const int fd_out,
+                                                   const std::size_t length,
+                                                   const unsigned int flags) noexcept
+{
+    return linuxpp::splice(std::nothrow, in.read_fd().get(), fd_out, length, flags);
+}
+
+std::size_t linuxpp::splice(linuxpp::pipe & in,
+                            const int fd_out,
+                            const std::size_t length,
+                            const unsigned int flags)
+{
+    return linuxpp::splice(in.read_fd().get(), fd_out, length, flags);
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::tee(std::nothrow_t,
+                                                linuxpp::pipe & in,
+                                                linuxpp::pipe & out,
+                                                const std::size_t length,
+                                                const unsigned int flags) noexcept
+{
+    const ::ssize_t ret = ::tee(in.read_fd().get(), out.write_fd().get(), length, flags);
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
+std::size_t linuxpp::tee(linuxpp::pipe & in,
+                         linuxpp::pipe & out,
+                         const std::size_t length,
+                         const unsigned int flags)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::tee(std::nothrow, in, out, length, flags),
+                                                            "tee failed"));
+}
+
+linuxpp::syscall_return<::ssize_t> linuxpp::vmsplice(std::nothrow_t,
+                                                     linuxpp::pipe & out,
+                                                     struct ::iovec const * const buffers,
+                                                     const std::size_t size_buffers,
+                                                     const unsigned int flags) noexcept
+{
+    const ::ssize_t ret = ::vmsplice(out.write_fd().get(), buffers, size_buffers, flags);
+    if (ret == -1)
+    {
+        return linuxpp::syscall_return<::ssize_t> {errno, ret};
+    }
+
+    return linuxpp::syscall_return<::ssize_t> {ret};
+}
+
+std::size_t linuxpp::vmsplice(linuxpp::pipe & out,
+                              struct ::iovec const * const buffers,
+                              const std::size_t size_buffers,
+                              const unsigned int flags)
+{
+    return static_cast<std::size_t>(linuxpp::value_or_throw(linuxpp::vmsplice(std::nothrow,
+                                                                              out,
+                                                                              buffers,
+                                                                              size_buffers,
+                                                                              flags),
+                                                            "vmsplice failed"));
+}
@@ -0,0 +1,264 @@
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <stdexcept>
+
+#include <libndgpp/error.hpp>
+#include <liblinuxpp/thread_tuning.hpp>
+
+static std::size_t page_size()
+{
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+/// Touches each page of size bytes of the stack below the caller's frame
+static void __attribute__((noinline)) prefault_stack(const std::size_t size)
+{
+    volatile char * const stack = static_cast<volatile char *>(::alloca(size));
+    for (std::size_t i = 0; i < size; i += ::page_size())
+    {
+        stack[i] = 0;
+    }
+
+    stack[size - 1] = 0;
+}
+
+/** Faults in each page of a buffer without writing to it
+ *
+ *  MADV_POPULATE_WRITE populates the pages as if they were written,
+ *  without changing their contents, so it's safe while other threads
+ *  use the buffer.  Kernels before 5.14 fall back to reading each
+ *  page, which may only map an anonymous page to the zero page.
+ */
+static void prefault_buffer(void * const buffer, const std::size_t size)
+{
+#ifdef MADV_POPULATE_WRITE
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer);
+    const std::uintptr_t begin = address & ~(::page_size() - 1);
+    if (::madvise(reinterpret_cast<void *>(begin), address + size - begin, MADV_POPULATE_WRITE) == 0)
+    {
+        return;
+    }
+#endif
+
+    volatile char const * const bytes = static_cast<volatile char const *>(buffer);
+    for (std::size_t i = 0; i < size; i += ::page_size())
+    {
+        static_cast<void>(bytes[i]);
+    }
+
+    static_cast<void>(bytes[size - 1]);
+}
+
+bool
+linuxpp::thread_tuning_result::all_applied() const noexcept
+{
+    for (const auto status : {this->affinity,
+                              this->scheduler,
+                              this->timer_slack,
+                              this->memory_lock,
+                              this->prefault})
+    {
+        if (status.requested && !status.applied)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+linuxpp::thread_tuning::set_affinity(const std::vector<int> & cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            throw ndgpp_error(std::invalid_argument, "invalid CPU number");
+        }
+
+        CPU_SET(cpu, &set);
+    }
+
+    this->set_affinity(set);
+}
+
+void
+linuxpp::thread_tuning::set_affinity(const cpu_set_t & cpus)
+{
+    this->affinity_ = cpus;
+    this->affinity_requested_ = true;
+}
+
+void
+linuxpp::thread_tuning::set_scheduler(const int policy,
+                                      const int priority)
+{
+    this->policy_ = policy;
+    this->priority_ = priority;
+    this->scheduler_requested_ = true;
+}
+
+void
+linuxpp::thread_tuning::set_timer_slack(const std::chrono::nanoseconds slack)
+{
+    if (slack.count() < 0)
+    {
+        throw ndgpp_error(std::invalid_argument, "timer slack cannot be negative");
+    }
+
+    this->timer_slack_ = slack;
+    this->timer_slack_requested_ = true;
+}
+
+void
+linuxpp::thread_tuning::set_memory_lock(const int flags)
+{
+    this->memory_lock_flags_ = flags;
+    this->memory_lock_requested_ = true;
+}
+
+void
+linuxpp::thread_tuning::set_stack_prefault(const std::size_t size)
+{
+    this->stack_prefault_size_ = size;
+}
+
+void
+linuxpp::thread_tuning::add_prefault_buffer(void * const buffer,
+                                            const std::size_t size)
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return;
+    }
+
+    this->prefault_buffers_.push_back(prefault_buffer {buffer, size});
+}
+
+linuxpp::thread_tuning_result
+linuxpp::thread_tuning::apply() const
+{
+    linuxpp::thread_tuning_result result;
+
+    if (this->affinity_requested_)
+    {
+        result.affinity.requested = true;
+        if (::sched_setaffinity(0, sizeof(this->affinity_), &this->affinity_) == -1)
+        {
+            result.affinity.errno_value = errno;
+        }
+        else
+        {
+            // The kernel silently drops offline CPUs, so read back
+            // the mask to see what took effect
+            cpu_set_t actual;
+            CPU_ZERO(&actual);
+            if (::sched_getaffinity(0, sizeof(actual), &actual) == -1)
+            {
+                result.affinity.errno_value = errno;
+            }
+            else
+            {
+                result.affinity.applied = CPU_EQUAL(&actual, &this->affinity_);
+            }
+        }
+    }
+
+    if (this->scheduler_requested_)
+    {
+        result.scheduler.requested = true;
+        sched_param param {};
+        param.sched_priority = this->priority_;
+
+        // pthread functions return the error number instead of
+        // setting errno
+        const int ret = ::pthread_setschedparam(::pthread_self(), this->policy_, &param);
+        if (ret != 0)
+        {
+            result.scheduler.errno_value = ret;
+        }
+        else
+        {
+            int actual_policy = 0;
+            sched_param actual_param {};
+            const int get_ret = ::pthread_getschedparam(::pthread_self(), &actual_policy, &actual_param);
+            if (get_ret != 0)
+            {
+                result.scheduler.errno_value = get_ret;
+            }
+            else
+            {
+                result.scheduler.applied =
+                    actual_policy == this->policy_ &&
+                    actual_param.sched_priority == this->priority_;
+            }
+        }
+    }
+
+    if (this->timer_slack_requested_)
+    {
+        result.timer_slack.requested = true;
+        const unsigned long slack = static_cast<unsigned long>(this->timer_slack_.count());
+        if (::prctl(PR_SET_TIMERSLACK, slack, 0, 0, 0) == -1)
+        {
+            result.timer_slack.errno_value = errno;
+        }
+        else
+        {
+            // A slack of 0 resets the thread to its default slack
+            const int actual = ::prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+            if (actual == -1)
+            {
+                result.timer_slack.errno_value = errno;
+            }
+            else
+            {
+                result.timer_slack.applied = slack == 0 || static_cast<unsigned long>(actual) == slack;
+            }
+        }
+    }
+
+    if (this->memory_lock_requested_)
+    {
+        result.memory_lock.requested = true;
+        if (::mlockall(this->memory_lock_flags_) == -1)
+        {
+            result.memory_lock.errno_value = errno;
+        }
+        else
+        {
+            result.memory_lock.applied = true;
+        }
+    }
+
+    if (this->stack_prefault_size_ != 0 || !this->prefault_buffers_.empty())
+    {
+        result.prefault.requested = true;
+        if (this->stack_prefault_size_ != 0)
+        {
+            ::prefault_stack(this->stack_prefault_size_);
+        }
+
+        for (const auto & buffer : this->prefault_buffers_)
+        {
+            ::prefault_buffer(buffer.buffer, buffer.size);
+        }
+
+        result.prefault.applied = true;
+    }
+
+    return result;
+}
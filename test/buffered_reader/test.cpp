@@ -0,0 +1,198 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/buffered_reader.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/pipe.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+#include <liblinuxpp/write.hpp>
+
+struct buffered_reader_test: public ::testing::Test
+{
+    protected:
+
+    buffered_reader_test():
+        fds(linuxpp::pipe_unique_fd(O_CLOEXEC))
+    {}
+
+    void write(const std::string & data)
+    {
+        linuxpp::write(fds[1].get(), data.data(), data.size());
+    }
+
+    linuxpp::buffered_reader::record_handler collect()
+    {
+        return [this] (char const * record, std::size_t length) { records.emplace_back(record, length); };
+    }
+
+    std::array<linuxpp::unique_fd<>, 2> fds;
+    std::vector<std::string> records;
+};
+
+TEST_F(buffered_reader_test, invalid_arguments)
+{
+    EXPECT_THROW(linuxpp::buffered_reader(fds[0].get(), '\n', 0), std::invalid_argument);
+    EXPECT_THROW(linuxpp::buffered_reader(fds[0].get(), '\n', 64, 32), std::invalid_argument);
+}
+
+TEST_F(buffered_reader_test, records)
+{
+    linuxpp::buffered_reader reader {fds[0].get()};
+    write("first\nsecond\n\nthird");
+    EXPECT_EQ(19, reader.read(collect()).return_value());
+    EXPECT_EQ((std::vector<std::string> {"first", "second", ""}), records);
+    EXPECT_EQ(5u, reader.buffered());
+
+    // The record continues in the next read
+    write(" part\n");
+    EXPECT_EQ(6, reader.read(collect()).return_value());
+    EXPECT_EQ("third part", records.back());
+    EXPECT_EQ(0u, reader.buffered());
+}
+
+TEST_F(buffered_reader_test, delimiter)
+{
+    linuxpp::buffered_reader reader {fds[0].get(), '\0'};
+    write(std::string {"a\0b\0", 4});
+    reader.read(collect());
+    EXPECT_EQ((std::vector<std::string> {"a", "b"}), records);
+}
+
+TEST_F(buffered_reader_test, end_of_file)
+{
+    linuxpp::buffered_reader reader {fds[0].get()};
+    write("first\nlast");
+    fds[1].reset();
+
+    reader.read(collect());
+    EXPECT_FALSE(reader.eof());
+    EXPECT_EQ(0, reader.read(collect()).return_value());
+    EXPECT_TRUE(reader.eof());
+    EXPECT_EQ((std::vector<std::string> {"first", "last"}), records);
+    EXPECT_EQ(0, reader.read(collect()).return_value());
+    EXPECT_EQ(2u, records.size());
+}
+
+TEST_F(buffered_reader_test, grows_to_max_record_size)
+{
+    linuxpp::buffered_reader reader {fds[0].get(), '\n', 8, 32};
+    const std::string record (20, 'x');
+    write(record + "\n");
+
+    while (records.empty())
+    {
+        ASSERT_TRUE(static_cast<bool>(reader.read(collect())));
+    }
+
+    EXPECT_EQ(record, records[0]);
+
+    // A record larger than the maximum fails the read
+    write(std::string (40, 'x') + "\n");
+    int error = 0;
+    while (error == 0)
+    {
+        const auto ret = reader.read(collect());
+        if (!ret)
+        {
+            error = ret.errno_value();
+        }
+    }
+
+    EXPECT_EQ(EMSGSIZE, error);
+}
+
+TEST_F(buffered_reader_test, discards_oversized_record)
+{
+    linuxpp::buffered_reader reader {fds[0].get(), '\n', 16};
+    write(std::string (16, 'x'));
+    EXPECT_EQ(16, reader.read(collect()).return_value());
+
+    const auto ret = reader.read(collect());
+    ASSERT_FALSE(static_cast<bool>(ret));
+    EXPECT_EQ(EMSGSIZE, ret.errno_value());
+
+    // The rest of the oversized record is skipped across reads
+    write(std::string (16, 'y'));
+    EXPECT_EQ(16, reader.read(collect()).return_value());
+    write("yy\nnext\nla");
+    EXPECT_EQ(10, reader.read(collect()).return_value());
+    EXPECT_EQ((std::vector<std::string> {"next"}), records);
+    EXPECT_EQ(2u, reader.buffered());
+
+    write("st\n");
+    reader.read(collect());
+    EXPECT_EQ((std::vector<std::string> {"next", "last"}), records);
+}
+
+TEST_F(buffered_reader_test, discards_oversized_record_at_end_of_file)
+{
+    linuxpp::buffered_reader reader {fds[0].get(), '\n', 8};
+    write(std::string (12, 'x'));
+    fds[1].reset();
+
+    int error = 0;
+    while (error == 0)
+    {
+        const auto ret = reader.read(collect());
+        if (!ret)
+        {
+            error = ret.errno_value();
+        }
+    }
+
+    EXPECT_EQ(EMSGSIZE, error);
+    while (!reader.eof())
+    {
+        ASSERT_TRUE(static_cast<bool>(reader.read(collect())));
+    }
+
+    EXPECT_TRUE(records.empty());
+}
+
+TEST_F(buffered_reader_test, nonblocking)
+{
+    linuxpp::buffered_reader reader {fds[0].get()};
+    ASSERT_EQ(0, ::fcntl(fds[0].get(), F_SETFL, O_NONBLOCK));
+    const auto ret = reader.read(collect());
+    EXPECT_FALSE(static_cast<bool>(ret));
+    EXPECT_EQ(EAGAIN, ret.errno_value());
+}
+
+TEST_F(buffered_reader_test, ioloop)
+{
+    linuxpp::ioloop loop;
+    linuxpp::buffered_reader reader {fds[0].get()};
+    int result = -1;
+    reader.attach(loop, collect(), [&] (int errno_value) {
+        result = errno_value;
+        loop.stop();
+    });
+
+    EXPECT_THROW(reader.attach(loop, nullptr, nullptr), std::logic_error);
+
+    std::string data;
+    for (int i = 0; i < 1000; ++i)
+    {
+        data += "record " + std::to_string(i) + "\n";
+    }
+
+    write(data);
+    fds[1].reset();
+    loop.start();
+
+    EXPECT_EQ(0, result);
+    ASSERT_EQ(1000u, records.size());
+    EXPECT_EQ("record 0", records.front());
+    EXPECT_EQ("record 999", records.back());
+}
@@ -0,0 +1,245 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/buffered_writer.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/pipe.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+namespace
+{
+    std::array<linuxpp::unique_fd<>, 2> make_socketpair()
+    {
+        int fds[2];
+        EXPECT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds));
+        return {{linuxpp::unique_fd<> {fds[0]}, linuxpp::unique_fd<> {fds[1]}}};
+    }
+
+    std::string read_all(const int fd)
+    {
+        std::string data;
+        std::array<char, 4096> buf;
+        while (true)
+        {
+            const ::ssize_t ret = ::recv(fd, buf.data(), buf.size(), MSG_DONTWAIT);
+            if (ret <= 0)
+            {
+                return data;
+            }
+
+            data.append(buf.data(), static_cast<std::size_t>(ret));
+        }
+    }
+
+    std::string make_data(const std::size_t length)
+    {
+        std::string data(length, '\0');
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            data[i] = static_cast<char>('a' + i % 26);
+        }
+
+        return data;
+    }
+}
+
+TEST(buffered_writer, invalid_arguments)
+{
+    auto fds = make_socketpair();
+    EXPECT_THROW(linuxpp::buffered_writer(fds[0].get(), 10, 20), std::invalid_argument);
+    EXPECT_THROW(linuxpp::buffered_writer(fds[0].get(), 10, 5, 0), std::invalid_argument);
+}
+
+TEST(buffered_writer, coalesces)
+{
+    auto fds = make_socketpair();
+    linuxpp::buffered_writer writer {fds[0].get(), 1024, 512, 8};
+
+    const std::string data = make_data(100);
+    for (const char c : data)
+    {
+        EXPECT_TRUE(writer.write(&c, 1));
+    }
+
+    EXPECT_EQ(data.size(), writer.buffered());
+
+    // One system call sends every chunk
+    const auto ret = writer.flush();
+    ASSERT_TRUE(static_cast<bool>(ret));
+    EXPECT_EQ(static_cast<::ssize_t>(data.size()), ret.return_value());
+    EXPECT_EQ(0u, writer.buffered());
+    EXPECT_EQ(data, read_all(fds[1].get()));
+}
+
+TEST(buffered_writer, pipe)
+{
+    auto fds = linuxpp::pipe_unique_fd(O_CLOEXEC);
+    linuxpp::buffered_writer writer {fds[1].get()};
+
+    const std::string data = make_data(40000);
+    writer.write(data.data(), data.size());
+    ASSERT_EQ(static_cast<::ssize_t>(data.size()), writer.flush().return_value());
+
+    std::string received(data.size(), '\0');
+    std::size_t offset = 0;
+    while (offset < received.size())
+    {
+        const ::ssize_t ret = ::read(fds[0].get(), &received[offset], received.size() - offset);
+        ASSERT_GT(ret, 0);
+        offset += static_cast<std::size_t>(ret);
+    }
+
+    EXPECT_EQ(data, received);
+}
+
+TEST(buffered_writer, iov_max)
+{
+    auto fds = make_socketpair();
+    linuxpp::buffered_writer writer {fds[0].get(), 1 << 20, 0, 4};
+
+    const std::string data = make_data(4 * (IOV_MAX + 10));
+    writer.write(data.data(), data.size());
+    EXPECT_EQ(4 * IOV_MAX, writer.flush().return_value());
+    EXPECT_EQ(40u, writer.buffered());
+    EXPECT_EQ(40, writer.flush().return_value());
+    EXPECT_EQ(data, read_all(fds[1].get()));
+}
+
+TEST(buffered_writer, watermarks)
+{
+    auto fds = make_socketpair();
+    linuxpp::buffered_writer writer {fds[0].get(), 100, 20, 16};
+    std::size_t drained = 0;
+    writer.set_drain_handler([&drained] () { ++drained; });
+
+    const std::string data = make_data(60);
+    EXPECT_TRUE(writer.write(data.data(), data.size()));
+    EXPECT_FALSE(writer.write(data.data(), data.size()));
+    EXPECT_TRUE(writer.above_high_watermark());
+
+    ASSERT_TRUE(static_cast<bool>(writer.flush()));
+    EXPECT_FALSE(writer.above_high_watermark());
+    EXPECT_EQ(1u, drained);
+
+    // Staying below the high watermark doesn't drain again
+    EXPECT_TRUE(writer.write(data.data(), data.size()));
+    ASSERT_TRUE(static_cast<bool>(writer.flush()));
+    EXPECT_EQ(1u, drained);
+}
+
+TEST(buffered_writer, throwing_drain_handler)
+{
+    auto fds = make_socketpair();
+    linuxpp::buffered_writer writer {fds[0].get(), 100, 20, 16};
+    writer.set_drain_handler([] () { throw std::runtime_error {"drained"}; });
+
+    const std::string data = make_data(120);
+    EXPECT_FALSE(writer.write(data.data(), data.size()));
+    EXPECT_THROW(writer.flush(), std::runtime_error);
+
+    // The backlog was consumed before the handler threw
+    EXPECT_EQ(0u, writer.buffered());
+    EXPECT_FALSE(writer.above_high_watermark());
+    EXPECT_EQ(data, read_all(fds[1].get()));
+}
+
+TEST(buffered_writer, ioloop_backpressure)
+{
+    auto fds = make_socketpair();
+    const int sndbuf = 4096;
+    ASSERT_EQ(0, ::setsockopt(fds[0].get(), SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)));
+
+    linuxpp::ioloop loop;
+    linuxpp::buffered_writer writer {fds[0].get()};
+    int error = 0;
+    writer.attach(loop, [&error] (int errno_value) { error = errno_value; });
+    EXPECT_THROW(writer.attach(loop, nullptr), std::logic_error);
+
+    // More than the socket buffers hold, so the writer blocks
+    const std::string data = make_data(1 << 20);
+    loop.add_callback([&] () { writer.write(data.data(), data.size()); });
+
+    bool blocked = false;
+    std::string received;
+    const std::function<void ()> check = [&] () {
+        if (writer.blocked())
+        {
+            blocked = true;
+            loop.add_handler(fds[1].get(), linuxpp::ioloop::event_enum::read, [&] (int fd, uint32_t) {
+                received += read_all(fd);
+                if (received.size() == data.size())
+                {
+                    loop.stop();
+                }
+            });
+
+            return;
+        }
+
+        loop.add_timeout(std::chrono::milliseconds {1}, check);
+    };
+
+    loop.add_timeout(std::chrono::milliseconds {1}, check);
+    loop.start();
+
+    EXPECT_TRUE(blocked);
+    EXPECT_EQ(0, error);
+    EXPECT_EQ(0u, writer.buffered());
+    EXPECT_FALSE(writer.blocked());
+    EXPECT_TRUE(data == received);
+}
+
+TEST(buffered_writer, ioloop_events_handler)
+{
+    auto fds = make_socketpair();
+    linuxpp::ioloop loop;
+    linuxpp::buffered_writer writer {fds[0].get()};
+
+    // Echo what's read through the writer
+    writer.attach(loop, nullptr, [&writer] (int fd, uint32_t) {
+        const std::string data = read_all(fd);
+        writer.write(data.data(), data.size());
+    });
+
+    loop.add_handler(fds[1].get(), linuxpp::ioloop::event_enum::read, [&loop] (int, uint32_t) { loop.stop(); });
+    ASSERT_EQ(5, ::send(fds[1].get(), "hello", 5, 0));
+    loop.start();
+    loop.remove_handler(fds[1].get());
+
+    EXPECT_EQ("hello", read_all(fds[1].get()));
+}
+
+TEST(buffered_writer, ioloop_error)
+{
+    auto fds = make_socketpair();
+    linuxpp::ioloop loop;
+    linuxpp::buffered_writer writer {fds[0].get()};
+    int error = 0;
+    writer.attach(loop, [&] (int errno_value) {
+        error = errno_value;
+        loop.stop();
+    });
+
+    fds[1].reset();
+    writer.write("hello", 5);
+    loop.start();
+
+    EXPECT_EQ(EPIPE, error);
+    EXPECT_EQ(EPIPE, writer.error());
+    EXPECT_EQ(0u, writer.buffered());
+    EXPECT_FALSE(writer.write("hello", 5));
+}
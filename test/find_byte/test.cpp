@@ -0,0 +1,74 @@
+#include <cstddef>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/find_byte.hpp>
+
+namespace
+{
+    std::vector<linuxpp::find_byte_isa> supported_isas()
+    {
+        std::vector<linuxpp::find_byte_isa> isas {linuxpp::find_byte_isa::scalar};
+        if (linuxpp::find_byte_supported() != linuxpp::find_byte_isa::scalar)
+        {
+            isas.push_back(linuxpp::find_byte_isa::sse2);
+        }
+
+        if (linuxpp::find_byte_supported() == linuxpp::find_byte_isa::avx2)
+        {
+            isas.push_back(linuxpp::find_byte_isa::avx2);
+        }
+
+        return isas;
+    }
+}
+
+TEST(find_byte, every_position)
+{
+    // Covers the vector bodies, the tails, and unaligned starts
+    for (const auto isa : supported_isas())
+    {
+        for (std::size_t length = 0; length < 100; ++length)
+        {
+            for (std::size_t offset = 0; offset < 4; ++offset)
+            {
+                std::string data(offset + length, 'a');
+                char const * const first = data.data() + offset;
+                char const * const last = first + length;
+                EXPECT_EQ(last, linuxpp::find_byte(isa, first, last, '\n'));
+
+                for (std::size_t position = 0; position < length; ++position)
+                {
+                    data[offset + position] = '\n';
+                    EXPECT_EQ(first + position, linuxpp::find_byte(isa, first, last, '\n'));
+                    data[offset + position] = 'a';
+                }
+            }
+        }
+    }
+}
+
+TEST(find_byte, first_occurrence)
+{
+    const std::string data = std::string(70, 'x') + "\n" + std::string(10, 'x') + "\n";
+    for (const auto isa : supported_isas())
+    {
+        EXPECT_EQ(data.data() + 70, linuxpp::find_byte(isa, data.data(), data.data() + data.size(), '\n'));
+    }
+
+    EXPECT_EQ(data.data() + 70, linuxpp::find_byte(data.data(), data.data() + data.size(), '\n'));
+}
+
+TEST(find_byte, high_byte)
+{
+    // Bytes with the sign bit set compare correctly
+    const std::string data = std::string(40, 'x') + "\xff";
+    for (const auto isa : supported_isas())
+    {
+        EXPECT_EQ(data.data() + 40, linuxpp::find_byte(isa, data.data(), data.data() + data.size(), '\xff'));
+    }
+}
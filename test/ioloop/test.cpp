@@ -1,13 +1,21 @@
 #include <gtest/gtest.h>
 
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
 #include <cstdint>
 
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <liblinuxpp/eventfd.hpp>
 #include <liblinuxpp/ioloop.hpp>
@@ -82,9 +90,9 @@ TEST_F(test_ioloop, add_handler)
 
     std::promise<std::pair<int, uint32_t>> handler_called_promise;
     auto handler = [&handler_called_promise] (int fd, uint32_t events) {
-        handler_called_promise.set_value(std::make_pair(fd, events));
         uint64_t value;
         linuxpp::read(fd, &value, sizeof(value));
+        handler_called_promise.set_value(std::make_pair(fd, events));
     };
 
     this->ioloop.add_handler(eventfd.fd(),
@@ -173,6 +181,123 @@ TEST_F(test_ioloop, remove_handler_in_handler_callback)
     this->stop_ioloop_thread();
 }
 
+TEST_F(test_ioloop, modify_handler)
+{
+    linuxpp::eventfd eventfd;
+
+    // An eventfd is always writable, so the handler is only called
+    // once it monitors write events
+    std::promise<uint32_t> handler_called_promise;
+    auto handler = [&handler_called_promise, this] (int fd, uint32_t events) {
+        this->ioloop.remove_handler(fd);
+        handler_called_promise.set_value(events);
+        this->ioloop.stop();
+    };
+
+    this->ioloop.add_handler(eventfd.fd(),
+                             linuxpp::ioloop::event_enum::read,
+                             handler);
+
+    this->ioloop.modify_handler(eventfd.fd(), linuxpp::ioloop::event_enum::write);
+    EXPECT_THROW(this->ioloop.modify_handler(-1, linuxpp::ioloop::event_enum::write),
+                 ndgpp::error<std::runtime_error>);
+
+    this->start_ioloop_thread();
+
+    auto future = handler_called_promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(future.get(), static_cast<uint32_t>(linuxpp::ioloop::event_enum::write));
+
+    this->stop_ioloop_thread();
+}
+
+TEST_F(test_ioloop, readd_handler_in_handler_callback)
+{
+    std::unique_ptr<linuxpp::eventfd> eventfd {new linuxpp::eventfd};
+    std::promise<void> handler_called_promise;
+
+    // The handler replaces its eventfd, which usually gets the same
+    // descriptor number, while the removal of its handler is postponed
+    auto second_handler = [&handler_called_promise, this] (int fd, uint32_t events) {
+        this->ioloop.remove_handler(fd);
+        handler_called_promise.set_value();
+        this->ioloop.stop();
+    };
+
+    auto first_handler = [&eventfd, &second_handler, this] (int fd, uint32_t events) {
+        this->ioloop.remove_handler(fd);
+        eventfd.reset();
+        eventfd.reset(new linuxpp::eventfd);
+        this->ioloop.add_handler(eventfd->fd(),
+                                 linuxpp::ioloop::event_enum::read,
+                                 second_handler);
+        eventfd->write();
+    };
+
+    this->ioloop.add_handler(eventfd->fd(),
+                             linuxpp::ioloop::event_enum::read,
+                             first_handler);
+
+    this->start_ioloop_thread();
+    eventfd->write();
+
+    auto future = handler_called_promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+
+    this->stop_ioloop_thread();
+}
+
+TEST_F(test_ioloop, remove_handler_again_in_iteration_handler)
+{
+    linuxpp::eventfd eventfd;
+    std::promise<void> handler_called_promise;
+
+    auto second_handler = [&handler_called_promise, this] (int fd, uint32_t events) {
+        this->ioloop.remove_handler(fd);
+        handler_called_promise.set_value();
+        this->ioloop.stop();
+    };
+
+    // The first handler's removal is postponed, and the iteration
+    // handler removes and replaces it before it's pruned
+    auto readd = std::make_shared<bool>(false);
+    auto first_handler = [readd, this] (int fd, uint32_t events) {
+        uint64_t value;
+        linuxpp::read(fd, &value, sizeof(value));
+        this->ioloop.remove_handler(fd);
+        *readd = true;
+    };
+
+    this->ioloop.add_iteration_handler([&eventfd, &second_handler, readd, this] () {
+            if (!*readd)
+            {
+                return;
+            }
+
+            *readd = false;
+            this->ioloop.remove_handler(eventfd.fd());
+            this->ioloop.add_handler(eventfd.fd(),
+                                     linuxpp::ioloop::event_enum::read,
+                                     second_handler);
+            eventfd.write();
+        },
+        [readd] () {
+            return *readd;
+        });
+
+    this->ioloop.add_handler(eventfd.fd(),
+                             linuxpp::ioloop::event_enum::read,
+                             first_handler);
+
+    this->start_ioloop_thread();
+    eventfd.write();
+
+    auto future = handler_called_promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+
+    this->stop_ioloop_thread();
+}
+
 TEST_F(test_ioloop, add_callback)
 {
     std::promise<void> promise;
@@ -389,3 +514,315 @@ TEST_F(test_ioloop, add_time_point_timeout_from_timeout_callback)
         EXPECT_EQ(ret, std::future_status::ready);
     }
 }
+
+TEST_F(test_ioloop, add_iteration_handler)
+{
+    // The handler's state is shared because the handler runs until
+    // the ioloop is stopped by the fixture
+    auto handler_called_promise = std::make_shared<std::promise<void>>();
+    auto called = std::make_shared<bool>(false);
+    this->ioloop.add_iteration_handler([handler_called_promise, called] () {
+            if (!*called)
+            {
+                *called = true;
+                handler_called_promise->set_value();
+            }
+        },
+        [called] () {
+            return !*called;
+        });
+
+    auto future = handler_called_promise->get_future();
+    this->start_ioloop_thread();
+
+    const auto ret = future.wait_for(std::chrono::seconds{10});
+    EXPECT_EQ(ret, std::future_status::ready);
+}
+
+TEST_F(test_ioloop, remove_iteration_handler)
+{
+    std::atomic<int> calls {0};
+    const auto handle = this->ioloop.add_iteration_handler([&calls] () {
+            ++calls;
+        },
+        [] () {
+            return false;
+        });
+
+    this->ioloop.remove_iteration_handler(handle);
+
+    std::promise<void> callback_promise;
+    this->start_ioloop_thread();
+    this->ioloop.add_callback([&callback_promise] () {
+            callback_promise.set_value();
+        });
+
+    auto future = callback_promise.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(calls.load(), 0);
+}
+
+TEST_F(test_ioloop, wakeup)
+{
+    auto work = std::make_shared<std::atomic<bool>>(false);
+    auto handler_called_promise = std::make_shared<std::promise<void>>();
+    this->ioloop.add_iteration_handler([work, handler_called_promise] () {
+            if (work->exchange(false))
+            {
+                handler_called_promise->set_value();
+            }
+        },
+        [work] () {
+            return work->load();
+        });
+
+    auto future = handler_called_promise->get_future();
+    this->start_ioloop_thread();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (!this->ioloop.sleeping() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_TRUE(this->ioloop.sleeping());
+
+    *work = true;
+    this->ioloop.wakeup();
+
+    const auto ret = future.wait_for(std::chrono::seconds{10});
+    EXPECT_EQ(ret, std::future_status::ready);
+}
+
+TEST_F(test_ioloop, add_signal_handler)
+{
+    auto handler_called_promise = std::make_shared<std::promise<signalfd_siginfo>>();
+    this->ioloop.add_signal_handler(SIGUSR1, [handler_called_promise] (const signalfd_siginfo & info) {
+            handler_called_promise->set_value(info);
+        });
+
+    // The signal is blocked in this thread before the ioloop thread
+    // is started, so the ioloop thread inherits the blocked signal
+    auto future = handler_called_promise->get_future();
+    this->start_ioloop_thread();
+
+    ASSERT_EQ(::kill(::getpid(), SIGUSR1), 0);
+
+    const auto ret = future.wait_for(std::chrono::seconds{10});
+    ASSERT_EQ(ret, std::future_status::ready);
+    const auto info = future.get();
+    EXPECT_EQ(info.ssi_signo, static_cast<uint32_t>(SIGUSR1));
+    EXPECT_EQ(info.ssi_pid, static_cast<uint32_t>(::getpid()));
+}
+
+TEST_F(test_ioloop, add_duplicate_signal_handler)
+{
+    auto handler = [] (const signalfd_siginfo &) {};
+    this->ioloop.add_signal_handler(SIGUSR2, handler);
+    EXPECT_THROW(this->ioloop.add_signal_handler(SIGUSR2, handler),
+                 ndgpp::error<std::runtime_error>);
+    this->ioloop.remove_signal_handler(SIGUSR2);
+    EXPECT_NO_THROW(this->ioloop.add_signal_handler(SIGUSR2, handler));
+}
+
+TEST_F(test_ioloop, queued_signals)
+{
+    // Real time signals are queued, so every one of them should be
+    // passed to the handler even though they're read in batches
+    constexpr int signal_count = 100;
+    const int signo = SIGRTMIN;
+
+    auto received = std::make_shared<int>(0);
+    auto handler_called_promise = std::make_shared<std::promise<void>>();
+    this->ioloop.add_signal_handler(signo, [received, handler_called_promise] (const signalfd_siginfo & info) {
+            if (info.ssi_int != *received)
+            {
+                return;
+            }
+
+            if (++(*received) == signal_count)
+            {
+                handler_called_promise->set_value();
+            }
+        });
+
+    auto future = handler_called_promise->get_future();
+    this->start_ioloop_thread();
+
+    for (int i = 0; i < signal_count; ++i)
+    {
+        sigval value;
+        value.sival_int = i;
+        ASSERT_EQ(::sigqueue(::getpid(), signo, value), 0);
+    }
+
+    const auto ret = future.wait_for(std::chrono::seconds{10});
+    EXPECT_EQ(ret, std::future_status::ready);
+}
+
+TEST_F(test_ioloop, batch_group)
+{
+    constexpr std::size_t fd_count = 3;
+    linuxpp::eventfd eventfds[fd_count];
+    int user_data[fd_count] = {0, 1, 2};
+
+    auto batches = std::make_shared<std::promise<std::vector<linuxpp::ioloop::batch_event>>>();
+    auto group = this->ioloop.add_batch_group([batches] (const linuxpp::ioloop::batch_event * events,
+                                                         std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                uint64_t value;
+                linuxpp::read(events[i].fd, &value, sizeof(value));
+            }
+
+            batches->set_value(std::vector<linuxpp::ioloop::batch_event> (events, events + count));
+        });
+
+    for (std::size_t i = 0; i < fd_count; ++i)
+    {
+        this->ioloop.add_batch_handler(group,
+                                       eventfds[i].fd(),
+                                       linuxpp::ioloop::event_enum::read,
+                                       &user_data[i]);
+        eventfds[i].write();
+    }
+
+    auto future = batches->get_future();
+    this->start_ioloop_thread();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    const auto events = future.get();
+    ASSERT_EQ(events.size(), fd_count);
+    for (const auto & event : events)
+    {
+        const int index = *static_cast<int *>(event.user_data);
+        EXPECT_EQ(event.fd, eventfds[index].fd());
+        EXPECT_EQ(event.events, linuxpp::ioloop::event_enum::read);
+    }
+
+    this->stop_ioloop_thread();
+}
+
+TEST_F(test_ioloop, remove_batch_group)
+{
+    linuxpp::eventfd eventfd;
+    auto group = this->ioloop.add_batch_group([] (const linuxpp::ioloop::batch_event *, std::size_t) {});
+    this->ioloop.add_batch_handler(group, eventfd.fd(), linuxpp::ioloop::event_enum::read, nullptr);
+
+    EXPECT_THROW(this->ioloop.add_handler(eventfd.fd(),
+                                          linuxpp::ioloop::event_enum::read,
+                                          [] (int, uint32_t) {}),
+                 ndgpp::error<std::runtime_error>);
+
+    this->ioloop.remove_batch_group(group);
+
+    EXPECT_THROW(this->ioloop.add_batch_handler(group, eventfd.fd(), linuxpp::ioloop::event_enum::read, nullptr),
+                 ndgpp::error<std::runtime_error>);
+    EXPECT_NO_THROW(this->ioloop.add_handler(eventfd.fd(),
+                                             linuxpp::ioloop::event_enum::read,
+                                             [] (int, uint32_t) {}));
+}
+
+TEST_F(test_ioloop, add_precise_timeout)
+{
+    auto called_promise = std::make_shared<std::promise<linuxpp::ioloop::time_type>>();
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+    this->ioloop.add_timeout(linuxpp::precise, timeout, [called_promise] () {
+            called_promise->set_value(std::chrono::steady_clock::now());
+        });
+
+    auto future = called_promise->get_future();
+    this->start_ioloop_thread();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_GE(future.get(), timeout);
+    EXPECT_GT(this->ioloop.precise_timeout_margin().count(), 0);
+}
+
+TEST_F(test_ioloop, precise_timeout_order)
+{
+    // The precise timeouts fall within the margin of the regular
+    // timeouts, so the ioloop wakes up for them first, but they must
+    // still be called in timeout order
+    auto order = std::make_shared<std::vector<int>>();
+    auto done_promise = std::make_shared<std::promise<void>>();
+    const auto now = std::chrono::steady_clock::now();
+
+    this->ioloop.add_timeout(now + std::chrono::microseconds{20000}, [order] () {
+            order->push_back(0);
+        });
+    this->ioloop.add_timeout(linuxpp::precise, now + std::chrono::microseconds{20010}, [order] () {
+            order->push_back(1);
+        });
+    this->ioloop.add_timeout(now + std::chrono::microseconds{20020}, [order] () {
+            order->push_back(2);
+        });
+    this->ioloop.add_timeout(linuxpp::precise, now + std::chrono::microseconds{20030}, [order, done_promise] () {
+            order->push_back(3);
+            done_promise->set_value();
+        });
+
+    auto future = done_promise->get_future();
+    this->start_ioloop_thread();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(*order, (std::vector<int> {0, 1, 2, 3}));
+}
+
+TEST_F(test_ioloop, regular_timeout_before_precise_timeout)
+{
+    // The regular timeout is due after the ioloop wakes up early for
+    // the precise timeout, so it's spun on as well instead of the
+    // timer firing again until it's due
+    auto iterations = std::make_shared<std::size_t>(0);
+    this->ioloop.add_iteration_handler([iterations] () {
+            ++*iterations;
+        },
+        [] () {
+            return false;
+        });
+
+    auto order = std::make_shared<std::vector<int>>();
+    auto done_promise = std::make_shared<std::promise<std::size_t>>();
+    auto schedule = [this, iterations, order, done_promise] () {
+        const auto margin = this->ioloop.precise_timeout_margin();
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+        const std::size_t scheduled = *iterations;
+        this->ioloop.add_timeout(timeout - margin / 10, [order] () {
+                order->push_back(0);
+            });
+        this->ioloop.add_timeout(linuxpp::precise, timeout, [order, iterations, scheduled, done_promise] () {
+                order->push_back(1);
+                done_promise->set_value(*iterations - scheduled);
+            });
+    };
+
+    // Lets the margin adapt to the timer's lateness, so the early
+    // wakeup comes before the regular timeout
+    auto remaining = std::make_shared<int>(20);
+    auto warm_up = std::make_shared<std::function<void ()>>();
+    const std::weak_ptr<std::function<void ()>> weak_warm_up = warm_up;
+    *warm_up = [this, remaining, weak_warm_up, schedule] () {
+        if (--*remaining == 0)
+        {
+            schedule();
+            return;
+        }
+
+        const auto next = weak_warm_up.lock();
+        this->ioloop.add_timeout(linuxpp::precise,
+                                 std::chrono::steady_clock::now() + std::chrono::milliseconds{2},
+                                 [next] () { (*next)(); });
+    };
+
+    this->ioloop.add_timeout(linuxpp::precise,
+                             std::chrono::steady_clock::now() + std::chrono::milliseconds{2},
+                             [warm_up] () { (*warm_up)(); });
+
+    auto future = done_promise->get_future();
+    this->start_ioloop_thread();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_LT(future.get(), 10u);
+    EXPECT_EQ(*order, (std::vector<int> {0, 1}));
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/ioloop_mesh.hpp>
+
+class test_ioloop_mesh: public testing::Test
+{
+    public:
+
+    static constexpr std::size_t loop_count = 3;
+
+    test_ioloop_mesh()
+    {
+        for (std::size_t i = 0; i < loop_count; ++i)
+        {
+            this->loops.emplace_back(new linuxpp::ioloop);
+        }
+    }
+
+    ~test_ioloop_mesh()
+    {
+        this->stop_loops();
+    }
+
+    void stop_loops()
+    {
+        for (std::size_t i = 0; i < this->threads.size(); ++i)
+        {
+            linuxpp::ioloop * loop = this->loops[i].get();
+            loop->add_callback([loop] () { loop->stop(); });
+            this->threads[i].join();
+        }
+
+        this->threads.clear();
+    }
+
+    std::vector<linuxpp::ioloop *> loop_pointers() const
+    {
+        std::vector<linuxpp::ioloop *> pointers;
+        for (const auto & loop : this->loops)
+        {
+            pointers.push_back(loop.get());
+        }
+
+        return pointers;
+    }
+
+    void start_loops()
+    {
+        for (auto & loop : this->loops)
+        {
+            linuxpp::ioloop * l = loop.get();
+            this->threads.emplace_back([l] () { l->start(); });
+        }
+    }
+
+    std::vector<std::unique_ptr<linuxpp::ioloop>> loops;
+    std::vector<std::thread> threads;
+};
+
+constexpr std::size_t test_ioloop_mesh::loop_count;
+
+TEST_F(test_ioloop_mesh, invalid_arguments)
+{
+    auto handler = [] (std::size_t, std::size_t, int &) {};
+    EXPECT_THROW(linuxpp::ioloop_mesh<int>({}, 8, handler),
+                 ndgpp::error<std::invalid_argument>);
+    EXPECT_THROW(linuxpp::ioloop_mesh<int>({nullptr}, 8, handler),
+                 ndgpp::error<std::invalid_argument>);
+}
+
+TEST_F(test_ioloop_mesh, try_send_full)
+{
+    linuxpp::ioloop_mesh<int> mesh {this->loop_pointers(), 2, [] (std::size_t, std::size_t, int &) {}};
+
+    EXPECT_EQ(mesh.size(), loop_count);
+    EXPECT_TRUE(mesh.try_send(0, 1, 1));
+    EXPECT_TRUE(mesh.try_send(0, 1, 2));
+    EXPECT_FALSE(mesh.try_send(0, 1, 3));
+    EXPECT_EQ(mesh.pending(0, 1), 2u);
+    EXPECT_EQ(mesh.pending(1, 0), 0u);
+}
+
+TEST_F(test_ioloop_mesh, send_between_loops)
+{
+    constexpr int message_count = 10000;
+    std::atomic<int> received {0};
+    std::promise<void> done_promise;
+    std::vector<int> last_value(loop_count * loop_count, -1);
+    std::atomic<bool> in_order {true};
+
+    linuxpp::ioloop_mesh<int> mesh {this->loop_pointers(), 64,
+            [&] (std::size_t destination, std::size_t source, int & message) {
+                int & last = last_value[source * loop_count + destination];
+                if (message != last + 1)
+                {
+                    in_order = false;
+                }
+
+                last = message;
+                if (++received == message_count * static_cast<int>(loop_count - 1))
+                {
+                    done_promise.set_value();
+                }
+            }};
+
+    this->start_loops();
+
+    // every loop except 0 sends message_count messages to loop 0,
+    // retrying from its own loop when the channel is full
+    std::vector<std::function<void ()>> senders(loop_count);
+    std::vector<int> next(loop_count, 0);
+    for (std::size_t source = 1; source < loop_count; ++source)
+    {
+        linuxpp::ioloop * loop = this->loops[source].get();
+        senders[source] = [&mesh, &senders, &next, loop, source] () {
+            while (next[source] < message_count && mesh.try_send(source, 0, next[source]))
+            {
+                ++next[source];
+            }
+
+            if (next[source] < message_count)
+            {
+                loop->add_callback(senders[source]);
+            }
+        };
+
+        loop->add_callback(senders[source]);
+    }
+
+    auto future = done_promise.get_future();
+    const auto ret = future.wait_for(std::chrono::seconds{30});
+
+    // the mesh must outlive the running ioloops
+    this->stop_loops();
+
+    ASSERT_EQ(ret, std::future_status::ready);
+    EXPECT_TRUE(in_order);
+}
@@ -0,0 +1,127 @@
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <array>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/mirror_buffer.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+namespace
+{
+    std::array<linuxpp::unique_fd<>, 2> make_socketpair()
+    {
+        int fds[2];
+        EXPECT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds));
+        return {{linuxpp::unique_fd<> {fds[0]}, linuxpp::unique_fd<> {fds[1]}}};
+    }
+
+    void write(linuxpp::mirror_buffer & buffer, const std::string & data)
+    {
+        std::memcpy(buffer.write_data(), data.data(), data.size());
+        buffer.commit(data.size());
+    }
+}
+
+TEST(mirror_buffer, capacity)
+{
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    linuxpp::mirror_buffer buffer {1};
+    EXPECT_EQ(page_size, buffer.capacity());
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(page_size, buffer.available());
+
+    EXPECT_THROW(linuxpp::mirror_buffer {0}, std::invalid_argument);
+}
+
+TEST(mirror_buffer, mirrored)
+{
+    linuxpp::mirror_buffer buffer {1};
+
+    // Writing past the end of the first mapping writes the start of the buffer
+    buffer.write_data()[0] = 'a';
+    EXPECT_EQ('a', buffer.write_data()[buffer.capacity()]);
+    buffer.write_data()[buffer.capacity() + 1] = 'b';
+    EXPECT_EQ('b', buffer.write_data()[1]);
+}
+
+TEST(mirror_buffer, wrapped_data_is_contiguous)
+{
+    linuxpp::mirror_buffer buffer {1};
+    const std::size_t capacity = buffer.capacity();
+
+    write(buffer, std::string (capacity - 10, 'x'));
+    buffer.consume(capacity - 20);
+    EXPECT_EQ(10u, buffer.size());
+
+    // The message wraps around the end of the ring
+    const std::string message = "a message that wraps around the end";
+    write(buffer, message);
+    EXPECT_EQ(std::string (10, 'x') + message, std::string (buffer.read_data(), buffer.size()));
+
+    buffer.consume(10);
+    const struct ::iovec readable = buffer.read_iovec();
+    EXPECT_EQ(message, std::string (static_cast<char const *>(readable.iov_base), readable.iov_len));
+
+    const struct ::iovec writable = buffer.write_iovec();
+    EXPECT_EQ(capacity - message.size(), writable.iov_len);
+
+    buffer.consume(message.size());
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(mirror_buffer, full)
+{
+    auto fds = make_socketpair();
+    linuxpp::mirror_buffer buffer {1};
+    write(buffer, std::string (buffer.capacity(), 'x'));
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(0u, buffer.available());
+
+    // A full buffer isn't reported as the end of file
+    ASSERT_EQ(1, ::send(fds[1].get(), "x", 1, 0));
+    const auto ret = buffer.recv(std::nothrow, fds[0].get());
+    EXPECT_FALSE(static_cast<bool>(ret));
+    EXPECT_EQ(ENOBUFS, ret.errno_value());
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(mirror_buffer, recv_and_send)
+{
+    auto fds = make_socketpair();
+    linuxpp::mirror_buffer buffer {1};
+    const std::size_t capacity = buffer.capacity();
+
+    // Move the read position near the end so the received data wraps
+    write(buffer, std::string (capacity - 4, 'x'));
+    buffer.consume(capacity - 4);
+
+    ASSERT_EQ(10, ::send(fds[1].get(), "0123456789", 10, 0));
+    const auto received = buffer.recv(std::nothrow, fds[0].get());
+    ASSERT_TRUE(static_cast<bool>(received));
+    EXPECT_EQ(10, received.return_value());
+    EXPECT_EQ("0123456789", std::string (buffer.read_data(), buffer.size()));
+
+    const auto sent = buffer.send(std::nothrow, fds[0].get());
+    ASSERT_TRUE(static_cast<bool>(sent));
+    EXPECT_EQ(10, sent.return_value());
+    EXPECT_TRUE(buffer.empty());
+
+    std::array<char, 10> echoed;
+    ASSERT_EQ(10, ::recv(fds[1].get(), echoed.data(), echoed.size(), 0));
+    EXPECT_EQ("0123456789", std::string (echoed.data(), echoed.size()));
+
+    const auto again = buffer.recv(std::nothrow, fds[0].get(), MSG_DONTWAIT);
+    EXPECT_FALSE(static_cast<bool>(again));
+    EXPECT_EQ(EAGAIN, again.errno_value());
+}
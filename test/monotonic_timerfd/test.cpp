@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <sys/timerfd.h>
+
+#include <cerrno>
+#include <cstdint>
+
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <liblinuxpp/monotonic_timerfd.hpp>
+
+static std::chrono::nanoseconds to_duration(const struct ::timespec & spec)
+{
+    return std::chrono::seconds {spec.tv_sec} + std::chrono::nanoseconds {spec.tv_nsec};
+}
+
+TEST(monotonic_timerfd, nonblocking_read_unexpired)
+{
+    linuxpp::monotonic_timerfd timer {TFD_NONBLOCK};
+    const auto ret = timer.read(std::nothrow);
+    EXPECT_FALSE(ret);
+    EXPECT_EQ(ret.errno_value(), EAGAIN);
+}
+
+TEST(monotonic_timerfd, oneshot_absolute)
+{
+    linuxpp::monotonic_timerfd timer;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds {5};
+    timer.set_oneshot(deadline);
+
+    EXPECT_EQ(timer.read(), 1u);
+    EXPECT_GE(std::chrono::steady_clock::now(), deadline);
+}
+
+TEST(monotonic_timerfd, oneshot_past)
+{
+    linuxpp::monotonic_timerfd timer;
+    timer.set_oneshot(std::chrono::steady_clock::now() - std::chrono::seconds {1});
+    EXPECT_EQ(timer.read(), 1u);
+
+    timer.set_oneshot(std::chrono::nanoseconds {0});
+    EXPECT_EQ(timer.read(), 1u);
+}
+
+TEST(monotonic_timerfd, periodic_overrun)
+{
+    linuxpp::monotonic_timerfd timer {TFD_NONBLOCK};
+    timer.set_periodic(std::chrono::milliseconds {1});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {20});
+
+    const auto ret = timer.read(std::nothrow);
+    ASSERT_TRUE(ret);
+    EXPECT_GT(ret.return_value(), 1u);
+
+    const auto spec = timer.gettime();
+    EXPECT_EQ(to_duration(spec.it_interval), std::chrono::milliseconds {1});
+}
+
+TEST(monotonic_timerfd, periodic_invalid)
+{
+    linuxpp::monotonic_timerfd timer;
+    EXPECT_THROW(timer.set_periodic(std::chrono::milliseconds {0}),
+                 ndgpp::error<std::invalid_argument>);
+}
+
+TEST(monotonic_timerfd, disarm)
+{
+    linuxpp::monotonic_timerfd timer {TFD_NONBLOCK};
+    timer.set_oneshot(std::chrono::milliseconds {5});
+    EXPECT_GT(to_duration(timer.gettime().it_value).count(), 0);
+
+    const auto old_spec = timer.disarm();
+    EXPECT_GT(to_duration(old_spec.it_value).count(), 0);
+    EXPECT_EQ(to_duration(timer.gettime().it_value).count(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+    EXPECT_FALSE(timer.read(std::nothrow));
+}
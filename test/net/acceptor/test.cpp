@@ -0,0 +1,158 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstddef>
+
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/acceptor.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/tcp_options.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+
+struct acceptor_test: public ::testing::Test
+{
+    protected:
+
+    acceptor_test():
+        server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback}
+    {
+        server.listen(16);
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+    }
+
+    void connect_clients(const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            clients.emplace_back(AF_INET);
+            clients.back().connect(addr, port);
+        }
+    }
+
+    linuxpp::net::tcp_socket server;
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    std::vector<linuxpp::net::tcp_socket> clients;
+};
+
+TEST_F(acceptor_test, batches)
+{
+    linuxpp::net::acceptor acceptor {server.descriptor(), 2};
+    connect_clients(5);
+
+    std::vector<std::size_t> batches;
+    std::vector<linuxpp::net::tcp_socket> connections;
+    const auto handler = [&] (linuxpp::net::tcp_socket * sockets, std::size_t count) {
+        batches.push_back(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            connections.push_back(std::move(sockets[i]));
+        }
+    };
+
+    EXPECT_EQ(5u, acceptor.accept_pending(handler));
+    EXPECT_EQ((std::vector<std::size_t> {2, 2, 1}), batches);
+    for (const auto & connection : connections)
+    {
+        EXPECT_TRUE(linuxpp::fcntl(connection.descriptor(), F_GETFL) & O_NONBLOCK);
+        EXPECT_EQ(FD_CLOEXEC, linuxpp::fcntl(connection.descriptor(), F_GETFD));
+    }
+
+    // Nothing is pending
+    EXPECT_EQ(0u, acceptor.accept_pending(handler));
+    EXPECT_EQ(3u, batches.size());
+}
+
+TEST_F(acceptor_test, tuning)
+{
+    linuxpp::net::acceptor acceptor {server.descriptor()};
+    linuxpp::net::socket_tuning tuning;
+    tuning.set_tcp_nodelay(true);
+    acceptor.set_tuning(tuning);
+    connect_clients(1);
+
+    int nodelay = 0;
+    acceptor.accept_pending([&nodelay] (linuxpp::net::tcp_socket * sockets, std::size_t) {
+        nodelay = linuxpp::net::getsockopt<linuxpp::net::so::tcp_nodelay>(sockets[0].descriptor()).option_value;
+    });
+
+    EXPECT_EQ(1, nodelay);
+}
+
+TEST_F(acceptor_test, ioloop)
+{
+    linuxpp::net::acceptor acceptor {server.descriptor()};
+    linuxpp::ioloop loop;
+    std::size_t accepted = 0;
+    acceptor.attach(loop, [&] (linuxpp::net::tcp_socket *, std::size_t count) {
+        accepted += count;
+        loop.stop();
+    }, true);
+
+    EXPECT_THROW(acceptor.attach(loop, nullptr), std::logic_error);
+
+    connect_clients(3);
+    loop.start();
+    acceptor.detach();
+
+    EXPECT_EQ(3u, accepted);
+}
+
+TEST_F(acceptor_test, descriptor_limit)
+{
+    linuxpp::net::acceptor acceptor {server.descriptor()};
+    connect_clients(1);
+
+    struct ::rlimit limit;
+    ASSERT_EQ(0, ::getrlimit(RLIMIT_NOFILE, &limit));
+
+    // Use up every descriptor below a lowered limit
+    struct ::rlimit lowered = limit;
+    lowered.rlim_cur = 64;
+    ASSERT_EQ(0, ::setrlimit(RLIMIT_NOFILE, &lowered));
+
+    std::vector<int> fillers;
+    while (true)
+    {
+        const int fd = ::dup(server.descriptor());
+        if (fd == -1)
+        {
+            break;
+        }
+
+        fillers.push_back(fd);
+    }
+
+    bool handler_called = false;
+    const std::size_t accepted = acceptor.accept_pending([&handler_called] (linuxpp::net::tcp_socket *, std::size_t) {
+        handler_called = true;
+    });
+
+    for (const int fd : fillers)
+    {
+        ::close(fd);
+    }
+
+    ASSERT_EQ(0, ::setrlimit(RLIMIT_NOFILE, &limit));
+
+    EXPECT_EQ(0u, accepted);
+    EXPECT_FALSE(handler_called);
+    EXPECT_EQ(1u, acceptor.rejected());
+
+    // The rejected client sees its connection closed
+    char byte;
+    EXPECT_EQ(0, ::recv(clients[0].descriptor(), &byte, 1, 0));
+}
@@ -0,0 +1,139 @@
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <cstdint>
+
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/net/bpf.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+struct bpf_filter_test: public ::testing::Test
+{
+    protected:
+
+    bpf_filter_test():
+        sender {AF_INET},
+        receiver {AF_INET}
+    {
+        receiver.bind(linuxpp::net::inaddr_loopback);
+        std::tie(std::ignore, port) = linuxpp::net::getsockname_ipv4(receiver.descriptor());
+    }
+
+    void send(const std::vector<std::uint8_t> & payload)
+    {
+        sender.send(payload.data(), payload.size(), linuxpp::net::inaddr_loopback, port);
+    }
+
+    // Returns the first byte of every queued datagram
+    std::string drain()
+    {
+        std::string received;
+        struct ::pollfd pfd = {receiver.descriptor(), POLLIN, 0};
+        while (::poll(&pfd, 1, 0) == 1)
+        {
+            std::uint8_t buf[16];
+            if (receiver.recv(buf, sizeof(buf)) > 0)
+            {
+                received.push_back(static_cast<char>('0' + buf[0]));
+            }
+        }
+
+        return received;
+    }
+
+    linuxpp::net::udp_socket sender;
+    linuxpp::net::udp_socket receiver;
+    ndgpp::net::port port;
+};
+
+TEST_F(bpf_filter_test, match_byte_values)
+{
+    receiver.attach_filter(linuxpp::net::bpf::filter {}
+                           .match_byte(linuxpp::net::bpf::udp_payload_offset, {1, 3})
+                           .build());
+
+    for (std::uint8_t type = 0; type < 5; ++type)
+    {
+        send({type, 0xaa});
+    }
+
+    EXPECT_EQ("13", drain());
+}
+
+TEST_F(bpf_filter_test, match_all_conditions)
+{
+    receiver.attach_filter(linuxpp::net::bpf::filter {}
+                           .match_byte(linuxpp::net::bpf::udp_payload_offset, 0x10, 0xf0)
+                           .match_u16(linuxpp::net::bpf::udp_payload_offset + 1, 0x0102)
+                           .build());
+
+    send({0x1, 0x01, 0x02});
+    send({0x12, 0x01, 0x02});
+    send({0x13, 0x01, 0x03});
+    send({0x14, 0x01});
+    send({0x15, 0x01, 0x02, 0xff});
+
+    // Only the first byte's high nibble is compared
+    std::string received = drain();
+    ASSERT_EQ(2u, received.size());
+    EXPECT_EQ('0' + 0x12, received[0]);
+    EXPECT_EQ('0' + 0x15, received[1]);
+}
+
+TEST_F(bpf_filter_test, match_u32)
+{
+    receiver.attach_filter(linuxpp::net::bpf::filter {}
+                           .match_u32(linuxpp::net::bpf::udp_payload_offset, 0x01020304)
+                           .build());
+
+    send({1, 2, 3, 4});
+    send({4, 3, 2, 1});
+
+    EXPECT_EQ("1", drain());
+}
+
+TEST_F(bpf_filter_test, detach)
+{
+    receiver.attach_filter(linuxpp::net::bpf::filter {}
+                           .match_byte(linuxpp::net::bpf::udp_payload_offset, 1)
+                           .build());
+    send({2});
+    EXPECT_EQ("", drain());
+
+    receiver.detach_filter();
+    send({2});
+    EXPECT_EQ("2", drain());
+}
+
+TEST_F(bpf_filter_test, lock)
+{
+    receiver.attach_filter(linuxpp::net::bpf::filter {}.build());
+    linuxpp::net::bpf::lock_filter(receiver.descriptor());
+
+    EXPECT_THROW(receiver.detach_filter(), std::system_error);
+
+    send({7});
+    EXPECT_EQ("7", drain());
+}
+
+TEST(bpf_filter, empty_accepts)
+{
+    const auto program = linuxpp::net::bpf::filter {}.build();
+    ASSERT_EQ(2u, program.size());
+    EXPECT_EQ(BPF_RET | BPF_K, program[0].code);
+    EXPECT_NE(0u, program[0].k);
+}
+
+TEST(bpf_filter, invalid_mask)
+{
+    linuxpp::net::bpf::filter filter;
+    EXPECT_THROW(filter.match_byte(0, 0x11, 0xf0), std::invalid_argument);
+}
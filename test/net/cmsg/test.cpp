@@ -0,0 +1,171 @@
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include <array>
+#include <stdexcept>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/net/cmsg.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/net/sockaddr.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+namespace cmsg = linuxpp::net::cmsg;
+
+TEST(space, sum)
+{
+    EXPECT_EQ(0u, cmsg::space<>::value);
+    EXPECT_EQ(CMSG_SPACE(sizeof(std::uint16_t)), cmsg::space<cmsg::udp_segment>::value);
+    EXPECT_EQ(CMSG_SPACE(sizeof(std::uint16_t)) + CMSG_SPACE(sizeof(struct ::in_pktinfo)),
+              (cmsg::space<cmsg::udp_segment, cmsg::pktinfo>::value));
+    EXPECT_EQ((cmsg::space<cmsg::rights, cmsg::rxq_ovfl>::value), (cmsg::buffer_for<cmsg::rights, cmsg::rxq_ovfl>::size()));
+}
+
+TEST(builder, round_trip)
+{
+    cmsg::buffer_for<cmsg::udp_segment, cmsg::rxq_ovfl> buffer;
+    cmsg::builder builder {buffer};
+    builder.add<cmsg::udp_segment>(1400).add<cmsg::rxq_ovfl>(7);
+    EXPECT_EQ(buffer.size(), builder.length());
+    EXPECT_THROW(builder.add<cmsg::rights>(0), std::length_error);
+
+    struct ::msghdr msg = {};
+    builder.apply(msg);
+    EXPECT_EQ(buffer.data(), msg.msg_control);
+
+    const cmsg::parser parser {msg};
+    EXPECT_FALSE(parser.truncated());
+
+    std::size_t count = 0;
+    for (const auto message : parser)
+    {
+        EXPECT_EQ(count == 0, message.is<cmsg::udp_segment>());
+        EXPECT_EQ(count == 1, message.is<cmsg::rxq_ovfl>());
+        ++count;
+    }
+
+    EXPECT_EQ(2u, count);
+
+    std::uint16_t segment_size = 0;
+    std::uint32_t drops = 0;
+    int fd = 0;
+    EXPECT_TRUE(parser.get<cmsg::udp_segment>(segment_size));
+    EXPECT_TRUE(parser.get<cmsg::rxq_ovfl>(drops));
+    EXPECT_FALSE(parser.get<cmsg::rights>(fd));
+    EXPECT_EQ(1400, segment_size);
+    EXPECT_EQ(7u, drops);
+}
+
+TEST(builder, empty)
+{
+    cmsg::buffer_for<cmsg::rights> buffer;
+    const cmsg::builder builder {buffer};
+
+    struct ::msghdr msg = {};
+    builder.apply(msg);
+    EXPECT_EQ(nullptr, msg.msg_control);
+    EXPECT_EQ(0u, msg.msg_controllen);
+
+    const cmsg::parser parser {msg};
+    EXPECT_TRUE(parser.begin() == parser.end());
+}
+
+TEST(parser, unpadded_last_message)
+{
+    cmsg::buffer_for<cmsg::rxq_ovfl, cmsg::udp_segment> buffer;
+    cmsg::builder builder {buffer};
+    builder.add<cmsg::rxq_ovfl>(7).add<cmsg::udp_segment>(1400);
+
+    // Ends the buffer at the last message's CMSG_LEN, like a hand
+    // built or truncated buffer
+    struct ::msghdr msg = {};
+    builder.apply(msg);
+    msg.msg_controllen -= CMSG_SPACE(sizeof(std::uint16_t)) - CMSG_LEN(sizeof(std::uint16_t));
+
+    const cmsg::parser parser {msg};
+    std::size_t count = 0;
+    for (auto it = parser.begin(); it != parser.end() && count < 3; ++it)
+    {
+        ++count;
+    }
+
+    EXPECT_EQ(2u, count);
+
+    std::uint16_t segment_size = 0;
+    EXPECT_TRUE(parser.get<cmsg::udp_segment>(segment_size));
+    EXPECT_EQ(1400, segment_size);
+}
+
+TEST(send_recv, rights)
+{
+    // Passes a file descriptor over a unix socket pair
+
+    int sockets[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sockets));
+
+    int pipe_fds[2];
+    ASSERT_EQ(0, ::pipe(pipe_fds));
+
+    cmsg::buffer_for<cmsg::rights> send_buffer;
+    cmsg::builder builder {send_buffer};
+    builder.add<cmsg::rights>(pipe_fds[1]);
+
+    const char byte = 'x';
+    ASSERT_EQ(1u, linuxpp::net::send(sockets[0], &byte, 1, builder));
+
+    cmsg::buffer_for<cmsg::rights> recv_buffer;
+    cmsg::parser parser {recv_buffer};
+    char recv_byte = 0;
+    ASSERT_EQ(1u, linuxpp::net::recv(sockets[1], &recv_byte, 1, parser));
+    EXPECT_EQ(byte, recv_byte);
+
+    int fd = -1;
+    ASSERT_TRUE(parser.get<cmsg::rights>(fd));
+    EXPECT_NE(pipe_fds[1], fd);
+
+    // The received descriptor refers to the pipe's write end
+    ASSERT_EQ(1, ::write(fd, &byte, 1));
+    ASSERT_EQ(1, ::read(pipe_fds[0], &recv_byte, 1));
+
+    for (const int open_fd : {sockets[0], sockets[1], pipe_fds[0], pipe_fds[1], fd})
+    {
+        ::close(open_fd);
+    }
+}
+
+TEST(send_recv, pktinfo)
+{
+    // Receives the destination address of a datagram with IP_PKTINFO
+
+    linuxpp::net::udp_socket receiver {AF_INET};
+    receiver.bind(linuxpp::net::inaddr_any);
+    const int enable = 1;
+    linuxpp::net::setsockopt(receiver.descriptor(), IPPROTO_IP, IP_PKTINFO, &enable, sizeof(enable));
+
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    std::tie(addr, port) = linuxpp::net::getsockname_ipv4(receiver.descriptor());
+
+    linuxpp::net::udp_socket sender {AF_INET};
+    const char byte = 'x';
+    sender.send(&byte, 1, linuxpp::net::inaddr_loopback, port);
+
+    cmsg::buffer_for<cmsg::pktinfo> buffer;
+    cmsg::parser parser {buffer};
+    char recv_byte = 0;
+    struct ::sockaddr_in sockaddr;
+    ASSERT_EQ(1u, linuxpp::net::recv(receiver.descriptor(), &recv_byte, 1, sockaddr, parser));
+
+    struct ::in_pktinfo pktinfo = {};
+    ASSERT_TRUE(parser.get<cmsg::pktinfo>(pktinfo));
+    EXPECT_EQ(htonl(INADDR_LOOPBACK), pktinfo.ipi_addr.s_addr);
+    EXPECT_NE(0, pktinfo.ipi_ifindex);
+}
@@ -0,0 +1,144 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/file_descriptor.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/connection_pool.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+
+struct connection_pool_test: public ::testing::Test
+{
+    protected:
+
+    connection_pool_test():
+        server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback}
+    {
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+    }
+
+    /// Runs the loop until the condition holds, or for at most a second
+    bool run_until(const std::function<bool ()> & condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {1};
+        bool met = false;
+        std::function<void ()> check;
+        check = [&] () {
+            met = condition();
+            if (met || std::chrono::steady_clock::now() > deadline)
+            {
+                loop.stop();
+                return;
+            }
+
+            loop.add_timeout(std::chrono::milliseconds {1}, check);
+        };
+
+        loop.add_timeout(std::chrono::milliseconds {0}, check);
+        loop.start();
+        return met;
+    }
+
+    linuxpp::net::tcp_socket server;
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    linuxpp::ioloop loop;
+};
+
+TEST_F(connection_pool_test, invalid_size)
+{
+    EXPECT_THROW(linuxpp::net::connection_pool(loop, addr, port, 0), std::invalid_argument);
+}
+
+TEST_F(connection_pool_test, fill_and_acquire)
+{
+    server.listen(16);
+    linuxpp::net::connection_pool pool {loop, addr, port, 3};
+    EXPECT_EQ(3u, pool.connecting());
+    EXPECT_FALSE(static_cast<bool>(pool.acquire()));
+
+    ASSERT_TRUE(run_until([&pool] () { return pool.idle() == 3; }));
+    EXPECT_EQ(0u, pool.connecting());
+
+    // Taking a connection starts its replacement
+    linuxpp::net::tcp_socket connection = pool.acquire();
+    EXPECT_TRUE(static_cast<bool>(connection));
+    EXPECT_EQ(2u, pool.idle());
+    EXPECT_EQ(1u, pool.connecting());
+
+    ASSERT_TRUE(run_until([&pool] () { return pool.idle() == 3; }));
+    EXPECT_EQ(0u, pool.failures());
+}
+
+TEST_F(connection_pool_test, release)
+{
+    server.listen(16);
+    linuxpp::net::connection_pool pool {loop, addr, port, 1};
+    ASSERT_TRUE(run_until([&pool] () { return pool.idle() == 1; }));
+
+    linuxpp::net::tcp_socket first = pool.acquire();
+    ASSERT_TRUE(run_until([&pool] () { return pool.idle() == 1; }));
+
+    // The pool is full, so the connection is closed
+    pool.release(std::move(first));
+    EXPECT_EQ(1u, pool.idle());
+
+    linuxpp::net::tcp_socket second = pool.acquire();
+    EXPECT_EQ(0u, pool.idle());
+    pool.release(std::move(second));
+    EXPECT_EQ(0u, pool.idle());
+}
+
+TEST_F(connection_pool_test, upstream_close)
+{
+    server.listen(16);
+    linuxpp::net::connection_pool pool {loop, addr, port, 2};
+    ASSERT_TRUE(run_until([&pool] () { return pool.idle() == 2; }));
+
+    // The upstream closes one of the idle connections
+    linuxpp::fcntl(server.descriptor(), F_SETFL, O_NONBLOCK);
+    {
+        linuxpp::net::tcp_socket accepted {linuxpp::file_descriptor {server.accept()}};
+    }
+
+    // The pool replaces it, so the other connection and the
+    // replacement are waiting to be accepted
+    linuxpp::net::tcp_socket second {linuxpp::file_descriptor {server.accept()}};
+    int third = -1;
+    ASSERT_TRUE(run_until([this, &third] () {
+        third = ::accept4(server.descriptor(), nullptr, nullptr, SOCK_NONBLOCK);
+        return third != -1;
+    }));
+
+    linuxpp::file_descriptor replacement {third};
+    EXPECT_EQ(2u, pool.idle());
+}
+
+TEST_F(connection_pool_test, retry)
+{
+    // The server is bound but not listening, so every connect is refused
+    linuxpp::net::connection_pool pool {loop,
+                                        addr,
+                                        port,
+                                        2,
+                                        linuxpp::net::socket_tuning {},
+                                        std::chrono::seconds {1},
+                                        std::chrono::milliseconds {10}};
+
+    ASSERT_TRUE(run_until([&pool] () { return pool.failures() >= 4; }));
+    EXPECT_EQ(0u, pool.idle());
+
+    server.listen(16);
+    ASSERT_TRUE(run_until([&pool] () { return pool.idle() == 2; }));
+}
@@ -0,0 +1,101 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+
+#include <chrono>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/file_descriptor.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/connector.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/tcp_options.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+
+struct connector_test: public ::testing::Test
+{
+    protected:
+
+    connector_test():
+        server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback},
+        connector {loop}
+    {
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+    }
+
+    /// Starts an attempt to the server whose outcome stops the loop
+    void connect(const std::chrono::milliseconds timeout)
+    {
+        connector.connect(addr, port, timeout, [this] (int errno_value, linuxpp::net::tcp_socket socket) {
+            result = errno_value;
+            connected = std::move(socket);
+            loop.stop();
+        });
+    }
+
+    linuxpp::net::tcp_socket server;
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+
+    linuxpp::ioloop loop;
+    linuxpp::net::connector connector;
+
+    int result = -1;
+    linuxpp::net::tcp_socket connected;
+};
+
+TEST_F(connector_test, connect)
+{
+    server.listen(1);
+    linuxpp::net::socket_tuning tuning;
+    tuning.set_tcp_nodelay(true);
+    connector.set_tuning(tuning);
+
+    connect(std::chrono::seconds {5});
+    EXPECT_EQ(1u, connector.pending());
+    loop.start();
+
+    EXPECT_EQ(0, result);
+    ASSERT_TRUE(static_cast<bool>(connected));
+    EXPECT_EQ(0u, connector.pending());
+    EXPECT_TRUE(linuxpp::fcntl(connected.descriptor(), F_GETFL) & O_NONBLOCK);
+    EXPECT_EQ(1, linuxpp::net::getsockopt<linuxpp::net::so::tcp_nodelay>(connected.descriptor()).option_value);
+
+    linuxpp::net::tcp_socket accepted {linuxpp::file_descriptor {server.accept()}};
+    EXPECT_EQ(1, connected.send(std::nothrow, "a", 1).return_value());
+}
+
+TEST_F(connector_test, refused)
+{
+    // The server is bound but not listening
+    connect(std::chrono::seconds {5});
+    loop.start();
+
+    EXPECT_EQ(ECONNREFUSED, result);
+    EXPECT_FALSE(static_cast<bool>(connected));
+    EXPECT_EQ(0u, connector.pending());
+}
+
+TEST_F(connector_test, timeout)
+{
+    // Fill the accept queue so that the handshake of the next
+    // connection isn't answered
+    server.listen(0);
+    linuxpp::net::tcp_socket queued {AF_INET};
+    queued.connect(addr, port);
+
+    connect(std::chrono::milliseconds {50});
+    loop.start();
+
+    EXPECT_EQ(ETIMEDOUT, result);
+    EXPECT_FALSE(static_cast<bool>(connected));
+    EXPECT_EQ(0u, connector.pending());
+}
@@ -0,0 +1,217 @@
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cstdint>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/epoll.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/ip_options.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/multicast_subscriber.hpp>
+#include <liblinuxpp/net/sockaddr.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+namespace
+{
+    bool handler_destroyed = false;
+    bool destroyed_in_handler = false;
+
+    struct destroy_sentinel
+    {
+        ~destroy_sentinel()
+        {
+            handler_destroyed = true;
+        }
+    };
+}
+
+struct multicast_subscriber_test: public ::testing::Test
+{
+    protected:
+
+    multicast_subscriber_test():
+        sender {AF_INET},
+        subscriber {port}
+    {
+        sender.bind(linuxpp::net::inaddr_loopback);
+
+        struct ::ip_mreqn mreqn = {};
+        mreqn.imr_address.s_addr = htonl(INADDR_LOOPBACK);
+        linuxpp::net::setsockopt(sender.descriptor(), IPPROTO_IP, IP_MULTICAST_IF, &mreqn, sizeof(mreqn));
+        linuxpp::net::setsockopt<linuxpp::net::so::multicast_loop>(sender.descriptor(), 1);
+        std::tie(sender_addr, std::ignore) = linuxpp::net::getsockname_ipv4(sender.descriptor());
+
+        epoll.add(subscriber.descriptor(), EPOLLIN);
+    }
+
+    void send(const char * const group, const std::string & payload)
+    {
+        sender.send(payload.data(), payload.size(), ndgpp::net::ipv4_address {group}, port);
+    }
+
+    const ndgpp::net::port port {45679};
+    linuxpp::net::udp_socket sender;
+    ndgpp::net::ipv4_address sender_addr;
+    linuxpp::net::multicast_subscriber subscriber;
+    linuxpp::epoll epoll;
+};
+
+TEST_F(multicast_subscriber_test, demultiplex)
+{
+    std::map<std::uint32_t, std::string> received;
+    const auto handler = [&received] (const linuxpp::net::multicast_subscriber::datagram & dgram) {
+        received[dgram.group.to_uint32()] += std::string(static_cast<char const *>(dgram.data), dgram.size);
+    };
+
+    subscriber.subscribe(ndgpp::net::multicast_ipv4_address {"239.1.2.3"}, "lo", handler);
+    subscriber.subscribe(ndgpp::net::multicast_ipv4_address {"239.1.2.4"}, "lo", handler);
+    EXPECT_EQ(2u, subscriber.group_count());
+
+    // Joined by another socket on the host, which the subscriber
+    // must not receive with IP_MULTICAST_ALL disabled
+    linuxpp::net::udp_socket other {AF_INET};
+    other.bind(linuxpp::net::inaddr_any, port, true);
+    other.join_group(ndgpp::net::multicast_ipv4_address {"239.1.2.5"}, "lo");
+
+    send("239.1.2.5", "x");
+    send("239.1.2.3", "a");
+    send("239.1.2.4", "b");
+    send("239.1.2.3", "c");
+
+    std::size_t total = 0;
+    while (total < 3)
+    {
+        ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+        total += subscriber.receive();
+    }
+
+    EXPECT_EQ(3u, total);
+    EXPECT_EQ(2u, received.size());
+    EXPECT_EQ("ac", received[ndgpp::net::ipv4_address {"239.1.2.3"}.to_uint32()]);
+    EXPECT_EQ("b", received[ndgpp::net::ipv4_address {"239.1.2.4"}.to_uint32()]);
+}
+
+TEST_F(multicast_subscriber_test, source_specific)
+{
+    std::size_t count = 0;
+    ndgpp::net::ipv4_address source;
+    const auto handler = [&] (const linuxpp::net::multicast_subscriber::datagram & dgram) {
+        ++count;
+        source = dgram.source;
+    };
+
+    subscriber.subscribe(ndgpp::net::multicast_ipv4_address {"232.1.2.3"}, sender_addr, "lo", handler);
+    send("232.1.2.3", "a");
+
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+    EXPECT_EQ(1u, subscriber.receive());
+    EXPECT_EQ(1u, count);
+    EXPECT_EQ(sender_addr, source);
+
+    subscriber.unsubscribe(ndgpp::net::multicast_ipv4_address {"232.1.2.3"}, sender_addr, "lo");
+    EXPECT_EQ(0u, subscriber.group_count());
+}
+
+TEST_F(multicast_subscriber_test, unsubscribe_in_handler)
+{
+    const ndgpp::net::multicast_ipv4_address group {"239.1.2.3"};
+    {
+        auto sentinel = std::make_shared<destroy_sentinel>();
+        subscriber.subscribe(group, "lo", [this, group, sentinel] (const linuxpp::net::multicast_subscriber::datagram &) {
+            subscriber.unsubscribe(group, "lo");
+            destroyed_in_handler = handler_destroyed;
+        });
+    }
+
+    send("239.1.2.3", "a");
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+    EXPECT_EQ(1u, subscriber.receive());
+    EXPECT_FALSE(destroyed_in_handler);
+    EXPECT_TRUE(handler_destroyed);
+    EXPECT_EQ(0u, subscriber.group_count());
+}
+
+TEST_F(multicast_subscriber_test, unsubscribe_in_handler_uses_captures)
+{
+    // A closure of two pointers is stored inside the std::function,
+    // so its captures are only valid while the handler isn't
+    // destroyed or moved
+    linuxpp::net::multicast_subscriber * const subscriber_ptr = &subscriber;
+    int total = 0;
+    int * const total_ptr = &total;
+    subscriber.subscribe(ndgpp::net::multicast_ipv4_address {"239.1.2.3"}, "lo",
+                         [subscriber_ptr, total_ptr] (const linuxpp::net::multicast_subscriber::datagram &) {
+                             subscriber_ptr->unsubscribe(ndgpp::net::multicast_ipv4_address {"239.1.2.3"}, "lo");
+                             *total_ptr += 42;
+                         });
+
+    send("239.1.2.3", "a");
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+    EXPECT_EQ(1u, subscriber.receive());
+    EXPECT_EQ(42, total);
+    EXPECT_EQ(0u, subscriber.group_count());
+}
+
+TEST_F(multicast_subscriber_test, throwing_handler_releases_retired_handlers)
+{
+    handler_destroyed = false;
+    const ndgpp::net::multicast_ipv4_address group {"239.1.2.3"};
+    {
+        auto sentinel = std::make_shared<destroy_sentinel>();
+        subscriber.subscribe(group, "lo", [this, group, sentinel] (const linuxpp::net::multicast_subscriber::datagram &) {
+            subscriber.unsubscribe(group, "lo");
+            throw std::runtime_error {"handler failed"};
+        });
+    }
+
+    send("239.1.2.3", "a");
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+    EXPECT_THROW(subscriber.receive(), std::runtime_error);
+    EXPECT_TRUE(handler_destroyed);
+    EXPECT_EQ(0u, subscriber.group_count());
+}
+
+TEST_F(multicast_subscriber_test, invalid_interface)
+{
+    EXPECT_THROW(subscriber.subscribe(ndgpp::net::multicast_ipv4_address {"239.1.2.3"},
+                                      "not an interface",
+                                      [] (const linuxpp::net::multicast_subscriber::datagram &) {}),
+                 std::system_error);
+    EXPECT_EQ(0u, subscriber.group_count());
+}
+
+TEST_F(multicast_subscriber_test, ioloop)
+{
+    linuxpp::ioloop loop;
+    std::size_t count = 0;
+    subscriber.subscribe(ndgpp::net::multicast_ipv4_address {"239.1.2.3"}, "lo",
+                         [&] (const linuxpp::net::multicast_subscriber::datagram &) {
+                             if (++count == 10)
+                             {
+                                 loop.stop();
+                             }
+                         });
+
+    subscriber.attach(loop);
+    for (int i = 0; i < 10; ++i)
+    {
+        send("239.1.2.3", "a");
+    }
+
+    std::thread thread {[&loop] () { loop.start(); }};
+    thread.join();
+    subscriber.detach();
+
+    EXPECT_EQ(10u, count);
+}
@@ -0,0 +1,200 @@
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <sys/epoll.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/epoll.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/packet_socket.hpp>
+
+namespace
+{
+    // The IEEE local experimental ethertype
+    constexpr std::uint16_t test_protocol = 0x88b5;
+
+    linuxpp::net::packet_ring_config rx_config()
+    {
+        linuxpp::net::packet_ring_config config;
+        config.block_size = 1 << 16;
+        config.block_count = 4;
+        config.block_timeout = std::chrono::milliseconds {5};
+        return config;
+    }
+
+    linuxpp::net::packet_ring_config tx_config()
+    {
+        linuxpp::net::packet_ring_config config;
+        config.block_size = 1 << 16;
+        config.block_count = 1;
+        return config;
+    }
+
+    std::vector<unsigned char> make_frame(const std::string & payload)
+    {
+        std::vector<unsigned char> frame(ETH_HLEN + payload.size(), 0);
+        const std::uint16_t protocol = htons(test_protocol);
+        std::memcpy(frame.data() + 2 * ETH_ALEN, &protocol, sizeof(protocol));
+        std::memcpy(frame.data() + ETH_HLEN, payload.data(), payload.size());
+        return frame;
+    }
+
+    std::string payload(const linuxpp::net::packet_frame & frame)
+    {
+        return std::string(static_cast<char const *>(frame.data) + ETH_HLEN, frame.length - ETH_HLEN);
+    }
+}
+
+struct packet_socket_test: public ::testing::Test
+{
+    protected:
+
+    void SetUp() override
+    {
+        try
+        {
+            sender.reset(new linuxpp::net::packet_socket {"lo", {}, tx_config(), 0});
+        }
+        catch (const std::system_error & error)
+        {
+            if (error.code().value() == EPERM)
+            {
+                GTEST_SKIP() << "packet sockets require CAP_NET_RAW";
+            }
+
+            throw;
+        }
+    }
+
+    void send(const std::vector<std::string> & payloads)
+    {
+        for (const auto & p : payloads)
+        {
+            const auto frame = make_frame(p);
+            ASSERT_TRUE(sender->queue(frame.data(), frame.size()));
+        }
+
+        sender->flush();
+    }
+
+    std::unique_ptr<linuxpp::net::packet_socket> sender;
+};
+
+TEST_F(packet_socket_test, send_receive)
+{
+    linuxpp::net::packet_socket receiver {"lo", rx_config(), {}, test_protocol};
+    EXPECT_EQ(sender->ifindex(), receiver.ifindex());
+    EXPECT_FALSE(receiver.rx_ready());
+
+    send({"a", "bb", "ccc"});
+
+    linuxpp::epoll epoll;
+    epoll.add(receiver.descriptor(), EPOLLIN);
+
+    std::vector<std::string> received;
+    while (received.size() < 3)
+    {
+        ASSERT_FALSE(epoll.wait(std::chrono::seconds {5}).empty());
+        receiver.receive([&received] (const linuxpp::net::packet_frame & frame) {
+            EXPECT_EQ(frame.length, frame.wire_length);
+            EXPECT_NE(0, frame.timestamp.tv_sec);
+            received.push_back(payload(frame));
+        });
+    }
+
+    EXPECT_EQ((std::vector<std::string> {"a", "bb", "ccc"}), received);
+}
+
+TEST_F(packet_socket_test, zero_copy_tx)
+{
+    linuxpp::net::packet_socket receiver {"lo", rx_config(), {}, test_protocol};
+
+    const auto frame = make_frame("xyz");
+    void * const buffer = sender->tx_frame();
+    ASSERT_NE(nullptr, buffer);
+    std::memcpy(buffer, frame.data(), frame.size());
+    sender->commit_tx_frame(frame.size());
+    sender->flush();
+
+    EXPECT_THROW(sender->commit_tx_frame(sender->tx_frame_capacity() + 1), std::invalid_argument);
+
+    linuxpp::epoll epoll;
+    epoll.add(receiver.descriptor(), EPOLLIN);
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds {5}).empty());
+    ASSERT_TRUE(receiver.rx_ready());
+
+    const auto block = receiver.rx_block();
+    ASSERT_EQ(1u, block.size());
+    EXPECT_TRUE(block.timed_out());
+    EXPECT_EQ("xyz", payload(*block.begin()));
+    EXPECT_EQ(PACKET_HOST, (*block.begin()).packet_type);
+    receiver.release_rx_block();
+
+    EXPECT_EQ(1u, receiver.statistics().tp_packets);
+}
+
+TEST_F(packet_socket_test, fanout)
+{
+    linuxpp::net::packet_socket first {"lo", rx_config(), {}, test_protocol};
+    linuxpp::net::packet_socket second {"lo", rx_config(), {}, test_protocol};
+    first.join_fanout(0x4242, PACKET_FANOUT_LB);
+    second.join_fanout(0x4242, PACKET_FANOUT_LB);
+
+    send({"1", "2", "3", "4", "5", "6"});
+
+    std::set<std::string> first_received;
+    std::set<std::string> second_received;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    while (first_received.size() + second_received.size() < 6 &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        first.receive([&] (const linuxpp::net::packet_frame & frame) { first_received.insert(payload(frame)); });
+        second.receive([&] (const linuxpp::net::packet_frame & frame) { second_received.insert(payload(frame)); });
+        std::this_thread::sleep_for(std::chrono::milliseconds {1});
+    }
+
+    // Round robin fanout splits the frames evenly
+    EXPECT_EQ(3u, first_received.size());
+    EXPECT_EQ(3u, second_received.size());
+}
+
+TEST_F(packet_socket_test, ioloop)
+{
+    linuxpp::net::packet_socket receiver {"lo", rx_config(), {}, test_protocol};
+
+    linuxpp::ioloop loop;
+    std::size_t count = 0;
+    receiver.attach(loop, [&] (const linuxpp::net::packet_frame &) {
+        if (++count == 10)
+        {
+            loop.stop();
+        }
+    });
+
+    send({"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"});
+
+    std::thread thread {[&loop] () { loop.start(); }};
+    thread.join();
+    receiver.detach();
+
+    EXPECT_EQ(10u, count);
+}
+
+TEST_F(packet_socket_test, no_rings)
+{
+    EXPECT_THROW((linuxpp::net::packet_socket {"lo", {}, {}}), std::invalid_argument);
+}
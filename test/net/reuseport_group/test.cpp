@@ -0,0 +1,181 @@
+#include <poll.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/reuseport_group.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+namespace
+{
+    bool readable(const int fd)
+    {
+        struct ::pollfd pfd = {fd, POLLIN, 0};
+        return ::poll(&pfd, 1, 0) == 1;
+    }
+
+    // Returns the source ports of the datagrams queued on each of the group's sockets
+    std::vector<std::vector<ndgpp::net::port>> drain(linuxpp::net::udp_reuseport_group & group)
+    {
+        std::vector<std::vector<ndgpp::net::port>> ports(group.size());
+        for (std::size_t i = 0; i < group.size(); ++i)
+        {
+            while (readable(group.socket(i).descriptor()))
+            {
+                char buf[16];
+                ndgpp::net::ipv4_address addr;
+                ndgpp::net::port port;
+                group.socket(i).recv(buf, sizeof(buf), addr, port);
+                ports[i].push_back(port);
+            }
+        }
+
+        return ports;
+    }
+}
+
+TEST(reuseport_program, invalid)
+{
+    EXPECT_THROW(linuxpp::net::reuseport_program(linuxpp::net::reuseport_steering::kernel, 4),
+                 std::invalid_argument);
+    EXPECT_THROW(linuxpp::net::reuseport_program(linuxpp::net::reuseport_steering::cpu, 0),
+                 std::invalid_argument);
+}
+
+TEST(reuseport_program, cpu)
+{
+    const auto program = linuxpp::net::reuseport_program(linuxpp::net::reuseport_steering::cpu, 4);
+    ASSERT_EQ(3u, program.size());
+    EXPECT_EQ(4u, program[1].k);
+    EXPECT_EQ(program.size(), program.fprog().len);
+}
+
+TEST(udp_reuseport_group, kernel_steering)
+{
+    linuxpp::net::udp_reuseport_group group {linuxpp::net::inaddr_loopback,
+                                             ndgpp::net::port {0},
+                                             3,
+                                             linuxpp::net::reuseport_steering::kernel};
+    EXPECT_EQ(3u, group.size());
+    EXPECT_NE(ndgpp::net::port {0}, group.port());
+
+    linuxpp::net::udp_socket sender {AF_INET};
+    for (int i = 0; i < 8; ++i)
+    {
+        sender.send("a", 1, linuxpp::net::inaddr_loopback, group.port());
+    }
+
+    std::size_t total = 0;
+    for (const auto & ports : drain(group))
+    {
+        total += ports.size();
+    }
+
+    EXPECT_EQ(8u, total);
+}
+
+TEST(udp_reuseport_group, cpu_steering)
+{
+    // Loopback packets are processed on the sending CPU
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(0, &cpus);
+    ASSERT_EQ(0, ::sched_setaffinity(0, sizeof(cpus), &cpus));
+
+    linuxpp::net::udp_reuseport_group group {linuxpp::net::inaddr_loopback,
+                                             ndgpp::net::port {0},
+                                             4,
+                                             linuxpp::net::reuseport_steering::cpu};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        linuxpp::net::udp_socket sender {AF_INET};
+        sender.send("a", 1, linuxpp::net::inaddr_loopback, group.port());
+    }
+
+    const auto ports = drain(group);
+    EXPECT_EQ(4u, ports[0].size());
+    EXPECT_TRUE(ports[1].empty());
+    EXPECT_TRUE(ports[2].empty());
+    EXPECT_TRUE(ports[3].empty());
+}
+
+TEST(udp_reuseport_group, hash_steering)
+{
+    linuxpp::net::udp_reuseport_group group {linuxpp::net::inaddr_loopback,
+                                             ndgpp::net::port {0},
+                                             4,
+                                             linuxpp::net::reuseport_steering::hash};
+
+    std::vector<linuxpp::net::udp_socket> senders;
+    for (int i = 0; i < 8; ++i)
+    {
+        senders.emplace_back(AF_INET);
+        senders.back().bind(linuxpp::net::inaddr_loopback);
+    }
+
+    for (int round = 0; round < 4; ++round)
+    {
+        for (auto & sender : senders)
+        {
+            sender.send("a", 1, linuxpp::net::inaddr_loopback, group.port());
+        }
+    }
+
+    // Every flow sticks to one socket
+    const auto ports = drain(group);
+    std::map<ndgpp::net::port, std::set<std::size_t>> sockets;
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < ports.size(); ++i)
+    {
+        total += ports[i].size();
+        for (const auto port : ports[i])
+        {
+            sockets[port].insert(i);
+        }
+    }
+
+    EXPECT_EQ(32u, total);
+    EXPECT_EQ(senders.size(), sockets.size());
+    for (const auto & flow : sockets)
+    {
+        EXPECT_EQ(1u, flow.second.size());
+    }
+}
+
+TEST(tcp_reuseport_group, accept)
+{
+    linuxpp::net::tcp_reuseport_group group {linuxpp::net::inaddr_loopback,
+                                             ndgpp::net::port {0},
+                                             2,
+                                             linuxpp::net::reuseport_steering::hash};
+    group.listen(8);
+
+    linuxpp::net::tcp_socket client {linuxpp::net::connect_socket, linuxpp::net::inaddr_loopback, group.port()};
+
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < group.size(); ++i)
+    {
+        if (readable(group.socket(i).descriptor()))
+        {
+            const int conn = group.socket(i).accept();
+            ASSERT_NE(-1, conn);
+            ::close(conn);
+            ++accepted;
+        }
+    }
+
+    EXPECT_EQ(1u, accepted);
+}
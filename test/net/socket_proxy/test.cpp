@@ -0,0 +1,183 @@
+#include <sys/socket.h>
+
+#include <cstddef>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/send.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/socket_proxy.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+
+struct socket_proxy_test: public ::testing::Test
+{
+    protected:
+
+    socket_proxy_test():
+        server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback},
+        first_client {AF_INET},
+        second_client {AF_INET}
+    {
+        server.listen(2);
+
+        ndgpp::net::ipv4_address addr;
+        ndgpp::net::port port;
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+        first_client.connect(addr, port);
+        first_accepted = linuxpp::net::tcp_socket {linuxpp::file_descriptor {server.accept()}};
+        second_client.connect(addr, port);
+        second_accepted = linuxpp::net::tcp_socket {linuxpp::file_descriptor {server.accept()}};
+    }
+
+    /// Reads from a socket until the end of file
+    static std::string receive_all(const int sd)
+    {
+        std::string data;
+        char buffer[4096];
+        while (true)
+        {
+            const std::size_t received = linuxpp::net::recv(sd, buffer, sizeof(buffer));
+            if (received == 0)
+            {
+                return data;
+            }
+
+            data.append(buffer, received);
+        }
+    }
+
+    linuxpp::net::tcp_socket server;
+    linuxpp::net::tcp_socket first_client;
+    linuxpp::net::tcp_socket second_client;
+    linuxpp::net::tcp_socket first_accepted;
+    linuxpp::net::tcp_socket second_accepted;
+};
+
+TEST_F(socket_proxy_test, both_directions)
+{
+    linuxpp::net::socket_proxy proxy {std::move(first_accepted), std::move(second_accepted)};
+
+    const std::string request {"request"};
+    const std::string response {"response"};
+    linuxpp::net::send(first_client.descriptor(), request.data(), request.size());
+    first_client.shutdown(SHUT_WR);
+    linuxpp::net::send(second_client.descriptor(), response.data(), response.size());
+    second_client.shutdown(SHUT_WR);
+
+    linuxpp::ioloop loop;
+    int result = -1;
+    proxy.attach(loop, [&] (int errno_value) {
+        result = errno_value;
+        loop.stop();
+    });
+
+    loop.start();
+
+    EXPECT_EQ(0, result);
+    EXPECT_TRUE(proxy.done());
+    EXPECT_EQ(request.size(), proxy.first_to_second());
+    EXPECT_EQ(response.size(), proxy.second_to_first());
+
+    // The end of file is forwarded after the data
+    EXPECT_EQ(request, receive_all(second_client.descriptor()));
+    EXPECT_EQ(response, receive_all(first_client.descriptor()));
+}
+
+TEST_F(socket_proxy_test, backpressure)
+{
+    // A single page pipe and a slow reader make the proxy wait for
+    // the destination many times
+    linuxpp::net::socket_proxy proxy {std::move(first_accepted), std::move(second_accepted), 4096};
+    second_client.shutdown(SHUT_WR);
+
+    std::string sent;
+    for (std::size_t i = 0; sent.size() < (4u << 20); ++i)
+    {
+        sent += std::to_string(i);
+    }
+
+    std::thread writer {[&] {
+        std::size_t offset = 0;
+        while (offset < sent.size())
+        {
+            offset += linuxpp::net::send(first_client.descriptor(), sent.data() + offset, sent.size() - offset);
+        }
+
+        first_client.shutdown(SHUT_WR);
+    }};
+
+    std::string received;
+    std::thread reader {[&] {
+        char buffer[1024];
+        while (true)
+        {
+            const std::size_t length = linuxpp::net::recv(second_client.descriptor(), buffer, sizeof(buffer));
+            if (length == 0)
+            {
+                break;
+            }
+
+            received.append(buffer, length);
+        }
+    }};
+
+    linuxpp::ioloop loop;
+    int result = -1;
+    proxy.attach(loop, [&] (int errno_value) {
+        result = errno_value;
+        loop.stop();
+    });
+
+    loop.start();
+    writer.join();
+    reader.join();
+
+    EXPECT_EQ(0, result);
+    EXPECT_EQ(sent.size(), proxy.first_to_second());
+    EXPECT_EQ(0u, proxy.second_to_first());
+    EXPECT_TRUE(sent == received);
+}
+
+TEST_F(socket_proxy_test, reset)
+{
+    linuxpp::net::socket_proxy proxy {std::move(first_accepted), std::move(second_accepted)};
+
+    // The data forwarded to the closed client is answered with a reset
+    const std::string data {"data"};
+    linuxpp::net::send(first_client.descriptor(), data.data(), data.size());
+    linuxpp::net::send(second_client.descriptor(), data.data(), data.size());
+    {
+        const linuxpp::net::tcp_socket closed {std::move(second_client)};
+    }
+
+    linuxpp::ioloop loop;
+    int result = 0;
+    proxy.attach(loop, [&] (int errno_value) {
+        result = errno_value;
+        loop.stop();
+    });
+
+    loop.start();
+
+    EXPECT_TRUE(proxy.done());
+    EXPECT_NE(0, result);
+    EXPECT_EQ(result, proxy.error());
+}
+
+TEST_F(socket_proxy_test, attach_twice)
+{
+    linuxpp::net::socket_proxy proxy {std::move(first_accepted), std::move(second_accepted)};
+
+    linuxpp::ioloop loop;
+    proxy.attach(loop, nullptr);
+    EXPECT_THROW(proxy.attach(loop, nullptr), std::logic_error);
+    proxy.detach();
+}
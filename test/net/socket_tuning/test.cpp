@@ -0,0 +1,141 @@
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <cstdint>
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/net/ip_options.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/socket_options.hpp>
+#include <liblinuxpp/net/socket_tuning.hpp>
+#include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/tcp_options.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+
+TEST(socket_tuning, nothing_requested)
+{
+    linuxpp::net::udp_socket socket {AF_INET};
+    linuxpp::net::socket_tuning tuning;
+
+    const auto result = tuning.apply(socket.descriptor());
+    EXPECT_FALSE(result.receive_buffer.requested);
+    EXPECT_FALSE(result.tcp_nodelay.requested);
+    EXPECT_TRUE(result.all_applied());
+}
+
+TEST(socket_tuning, invalid_arguments)
+{
+    linuxpp::net::socket_tuning tuning;
+    EXPECT_THROW(tuning.set_busy_poll(std::chrono::microseconds {-1}), ndgpp::error<std::invalid_argument>);
+    EXPECT_THROW(tuning.set_incoming_cpu(-1), ndgpp::error<std::invalid_argument>);
+    EXPECT_THROW(tuning.set_tos(0x100), ndgpp::error<std::invalid_argument>);
+    EXPECT_THROW(tuning.set_tcp_fastopen(-1), ndgpp::error<std::invalid_argument>);
+    EXPECT_THROW(tuning.set_receive_buffer(static_cast<std::size_t>(1) << 32), ndgpp::error<std::invalid_argument>);
+}
+
+TEST(socket_tuning, udp)
+{
+    linuxpp::net::udp_socket socket {AF_INET};
+    linuxpp::net::socket_tuning tuning;
+    tuning.set_receive_buffer(1 << 16);
+    tuning.set_send_buffer(1 << 16);
+    tuning.set_receive_low_watermark(1);
+    tuning.set_zerocopy(true);
+    tuning.set_max_pacing_rate(1000000);
+    tuning.set_priority(3);
+    tuning.set_tos(0x10);
+
+    const auto result = tuning.apply(socket.descriptor());
+    EXPECT_TRUE(result.receive_buffer.applied);
+    EXPECT_TRUE(result.send_buffer.applied);
+    EXPECT_TRUE(result.receive_low_watermark.applied);
+    EXPECT_TRUE(result.zerocopy.applied);
+    EXPECT_TRUE(result.max_pacing_rate.applied);
+    EXPECT_TRUE(result.priority.applied);
+    EXPECT_TRUE(result.tos.applied);
+    EXPECT_TRUE(result.all_applied());
+
+    namespace so = linuxpp::net::so;
+    const int sd = socket.descriptor();
+    EXPECT_EQ(2 << 16, linuxpp::net::getsockopt<so::rcv_buf>(sd).option_value);
+    EXPECT_EQ(1, linuxpp::net::getsockopt<so::zerocopy>(sd).option_value);
+    EXPECT_EQ(1000000u, linuxpp::net::getsockopt<so::max_pacing_rate>(sd).option_value);
+    EXPECT_EQ(3, linuxpp::net::getsockopt<so::priority>(sd).option_value);
+    EXPECT_EQ(0x10, linuxpp::net::getsockopt<so::tos>(sd).option_value);
+}
+
+TEST(socket_tuning, busy_poll)
+{
+    linuxpp::net::udp_socket socket {AF_INET};
+    linuxpp::net::socket_tuning tuning;
+    tuning.set_busy_poll(std::chrono::microseconds {50});
+    tuning.set_prefer_busy_poll(true);
+
+    // Raising the busy poll time may be refused, but the result must
+    // agree with the socket
+    const auto result = tuning.apply(socket.descriptor());
+    EXPECT_TRUE(result.busy_poll.requested);
+
+    const int busy_poll = linuxpp::net::getsockopt<linuxpp::net::so::busy_poll>(socket.descriptor()).option_value;
+    EXPECT_EQ(result.busy_poll.applied, busy_poll == 50);
+    EXPECT_EQ(result.busy_poll.applied, result.busy_poll.errno_value == 0);
+}
+
+TEST(socket_tuning, capped_receive_buffer)
+{
+    std::ifstream sysctl {"/proc/sys/net/core/rmem_max"};
+    int rmem_max = 0;
+    if (!(sysctl >> rmem_max) || rmem_max >= (1 << 29))
+    {
+        GTEST_SKIP() << "net.core.rmem_max is unavailable or too large";
+    }
+
+    // The kernel silently caps the buffer, which the read back catches
+    linuxpp::net::udp_socket socket {AF_INET};
+    linuxpp::net::socket_tuning tuning;
+    tuning.set_receive_buffer(static_cast<std::size_t>(rmem_max) * 2);
+
+    const auto result = tuning.apply(socket.descriptor());
+    EXPECT_TRUE(result.receive_buffer.requested);
+    EXPECT_FALSE(result.receive_buffer.applied);
+    EXPECT_EQ(0, result.receive_buffer.errno_value);
+    EXPECT_FALSE(result.all_applied());
+}
+
+TEST(socket_tuning, tcp_listener)
+{
+    linuxpp::net::tcp_socket socket {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback};
+    linuxpp::net::socket_tuning tuning;
+    tuning.set_tcp_nodelay(true);
+    tuning.set_tcp_cork(true);
+    tuning.set_tcp_notsent_lowat(1 << 14);
+    tuning.set_tcp_defer_accept(std::chrono::seconds {5});
+    tuning.set_tcp_fastopen(16);
+    tuning.set_tcp_quickack(true);
+
+    const auto result = tuning.apply(socket.descriptor());
+    EXPECT_TRUE(result.all_applied());
+    socket.listen(1);
+
+    namespace so = linuxpp::net::so;
+    const int sd = socket.descriptor();
+    EXPECT_EQ(1, linuxpp::net::getsockopt<so::tcp_nodelay>(sd).option_value);
+    EXPECT_EQ(1, linuxpp::net::getsockopt<so::tcp_cork>(sd).option_value);
+    EXPECT_EQ(1 << 14, linuxpp::net::getsockopt<so::tcp_notsent_lowat>(sd).option_value);
+    EXPECT_GE(linuxpp::net::getsockopt<so::tcp_defer_accept>(sd).option_value, 5);
+    EXPECT_EQ(16, linuxpp::net::getsockopt<so::tcp_fastopen>(sd).option_value);
+}
+
+TEST(socket_options, incoming_napi_id)
+{
+    // Loopback traffic has no NAPI context
+    linuxpp::net::udp_socket socket {AF_INET};
+    EXPECT_EQ(0u, linuxpp::net::getsockopt<linuxpp::net::so::incoming_napi_id>(socket.descriptor()).option_value);
+}
@@ -2,15 +2,21 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <time.h>
+
+#include <cerrno>
 
 #include <chrono>
+#include <fstream>
 #include <iostream>
+#include <new>
 #include <tuple>
 
 #include <gtest/gtest.h>
 
 #include <liblinuxpp/epoll.hpp>
 #include <liblinuxpp/fcntl.hpp>
+#include <liblinuxpp/file_descriptor.hpp>
 #include <liblinuxpp/net/ipv4_address.hpp>
 #include <liblinuxpp/net/recv.hpp>
 #include <liblinuxpp/net/send.hpp>
@@ -104,6 +110,30 @@ TEST_F(connect_test, member_function)
                           std::get<ndgpp::net::port>(server.sockaddr));
 }
 
+TEST(connect, nothrow_refused)
+{
+    // A bound socket that isn't listening refuses connections
+    linuxpp::net::tcp_socket bound_socket{linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback};
+    const auto sockaddr = linuxpp::net::getsockname_ipv4(bound_socket.descriptor());
+
+    linuxpp::net::tcp_socket client_socket{AF_INET};
+    const auto ret = client_socket.connect(std::nothrow,
+                                           std::get<ndgpp::net::ipv4_address>(sockaddr),
+                                           std::get<ndgpp::net::port>(sockaddr));
+    EXPECT_TRUE(ret.fail());
+    EXPECT_EQ(ECONNREFUSED, ret.errno_value());
+}
+
+TEST(accept, nothrow_eagain)
+{
+    server_socket server;
+    linuxpp::fcntl(server.socket.descriptor(), F_SETFL, O_NONBLOCK);
+
+    const auto ret = server.socket.accept(std::nothrow);
+    EXPECT_TRUE(ret.fail());
+    EXPECT_EQ(EAGAIN, ret.errno_value());
+}
+
 struct accept_test: public ::testing::Test
 {
     accept_test():
@@ -276,3 +306,108 @@ TEST_F(send_recv_test, send_test_iovec)
     ASSERT_EQ(recv_buf.size(), ret);
     EXPECT_EQ(send_buf, recv_buf);
 }
+
+TEST_F(send_recv_test, recv_test_timestamp)
+{
+    client_socket.set_timestamps(true);
+
+    struct ::timespec before;
+    ::clock_gettime(CLOCK_REALTIME, &before);
+    linuxpp::net::send(server_client_sd, send_buf.data(), send_buf.size());
+    const auto events = epoll.wait(std::chrono::seconds(5));
+    ASSERT_EQ(1U, events.size());
+
+    struct ::timespec timestamp = {};
+    const std::size_t ret = client_socket.recv(recv_buf.data(), recv_buf.size(), timestamp, MSG_WAITALL);
+    ASSERT_EQ(recv_buf.size(), ret);
+    EXPECT_EQ(send_buf, recv_buf);
+    EXPECT_GE(timestamp.tv_sec, before.tv_sec);
+}
+
+struct fastopen_test: public ::testing::Test
+{
+    protected:
+
+    void SetUp() override
+    {
+        // Both the client (1) and server (2) sides must be enabled
+        std::ifstream sysctl {"/proc/sys/net/ipv4/tcp_fastopen"};
+        int value = 0;
+        if (!(sysctl >> value) || (value & 3) != 3)
+        {
+            GTEST_SKIP() << "net.ipv4.tcp_fastopen doesn't enable the client and server";
+        }
+
+        server.bind(linuxpp::net::inaddr_loopback);
+        server.set_fastopen(16);
+        server.listen(16);
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+    }
+
+    /// Accepts a connection, checks it received a byte, and echoes it
+    bool echo(const char expected)
+    {
+        linuxpp::net::tcp_socket accepted {linuxpp::file_descriptor {server.accept()}};
+        char byte = 0;
+        accepted.recv(&byte, 1);
+        accepted.send(&byte, 1);
+        syn_data = accepted.fastopen_accepted();
+        return byte == expected;
+    }
+
+    linuxpp::net::tcp_socket server {AF_INET};
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    bool syn_data = false;
+};
+
+TEST_F(fastopen_test, send_fastopen)
+{
+    // The first connection gets the cookie the second one uses
+    for (const char byte : {'a', 'b'})
+    {
+        linuxpp::net::tcp_socket client {AF_INET};
+        EXPECT_EQ(1u, client.send_fastopen(&byte, 1, addr, port));
+        ASSERT_TRUE(echo(byte));
+
+        char reply = 0;
+        EXPECT_EQ(1u, client.recv(&reply, 1));
+        if (byte == 'b')
+        {
+            EXPECT_TRUE(client.fastopen_accepted());
+            EXPECT_TRUE(syn_data);
+        }
+    }
+}
+
+TEST_F(fastopen_test, fastopen_connect)
+{
+    for (const char byte : {'a', 'b'})
+    {
+        linuxpp::net::tcp_socket client {AF_INET};
+        client.set_fastopen_connect(true);
+        client.connect(addr, port);
+        EXPECT_EQ(1u, client.send(&byte, 1));
+        ASSERT_TRUE(echo(byte));
+
+        char reply = 0;
+        EXPECT_EQ(1u, client.recv(&reply, 1));
+        if (byte == 'b')
+        {
+            EXPECT_TRUE(client.fastopen_accepted());
+            EXPECT_TRUE(syn_data);
+        }
+    }
+}
+
+TEST(fastopen, not_accepted_without_fastopen)
+{
+    linuxpp::net::tcp_socket server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback};
+    server.listen(1);
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+
+    linuxpp::net::tcp_socket client {linuxpp::net::connect_socket, addr, port};
+    EXPECT_FALSE(client.fastopen_accepted());
+}
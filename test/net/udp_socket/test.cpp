@@ -1,19 +1,30 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <time.h>
 
+#include <cerrno>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <iostream>
+#include <new>
+#include <stdexcept>
 #include <tuple>
 
 #include <gtest/gtest.h>
 
 #include <liblinuxpp/epoll.hpp>
 #include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/message_batch.hpp>
+#include <liblinuxpp/net/recv.hpp>
 #include <liblinuxpp/net/send.hpp>
 #include <liblinuxpp/net/sockaddr.hpp>
 #include <liblinuxpp/net/socket.hpp>
 #include <liblinuxpp/net/sockopt.hpp>
+#include <liblinuxpp/net/udp_segments.hpp>
 #include <liblinuxpp/net/udp_socket.hpp>
 
 TEST(ctor, default_ctor)
@@ -243,6 +254,290 @@ TEST_F(send_recv_test, recv_test6)
 }
 
 
+TEST_F(send_recv_test, batch_send_recv)
+{
+    // Tests sendmmsg and recvmmsg with a message_batch
+
+    linuxpp::net::message_batch send_batch {4, send_buf.size()};
+    const auto destination = linuxpp::net::make_sockaddr(receiver_addr, receiver_port);
+    for (std::size_t i = 0; i < send_batch.size(); ++i)
+    {
+        unsigned char * const buf = static_cast<unsigned char *>(send_batch.buffer(i));
+        std::copy(send_buf.begin(), send_buf.end(), buf);
+        buf[0] = static_cast<unsigned char>(i);
+        send_batch.set_length(i, i + 1);
+        send_batch.set_address(i, destination);
+    }
+
+    const std::size_t messages_sent = send_socket.send(send_batch, send_batch.size());
+    ASSERT_EQ(send_batch.size(), messages_sent);
+    for (std::size_t i = 0; i < messages_sent; ++i)
+    {
+        EXPECT_EQ(i + 1, send_batch.length(i));
+    }
+
+    const auto events = epoll.wait(std::chrono::seconds{5});
+    ASSERT_FALSE(events.empty());
+
+    linuxpp::net::message_batch recv_batch {8, send_buf.size()};
+    const std::size_t messages_recv = recv_socket.recv(recv_batch, MSG_WAITFORONE);
+    ASSERT_EQ(messages_sent, messages_recv);
+
+    for (std::size_t i = 0; i < messages_recv; ++i)
+    {
+        EXPECT_EQ(i + 1, recv_batch.length(i));
+        EXPECT_EQ(0, recv_batch.flags(i));
+        EXPECT_EQ(i, static_cast<unsigned char const *>(recv_batch.buffer(i))[0]);
+
+        ndgpp::net::ipv4_address addr;
+        ndgpp::net::port port;
+        std::tie(addr, port) = linuxpp::net::parse_sockaddr(recv_batch.address(i));
+        EXPECT_EQ(sender_addr, addr);
+        EXPECT_EQ(sender_port, port);
+    }
+}
+
+TEST_F(send_recv_test, batch_recv_truncated)
+{
+    // Tests that a datagram larger than a batch buffer is flagged
+
+    send_socket.send(send_buf.data(), send_buf.size(), receiver_addr, receiver_port);
+    const auto events = epoll.wait(std::chrono::seconds{5});
+    ASSERT_FALSE(events.empty());
+
+    linuxpp::net::message_batch recv_batch {2, 2};
+    ASSERT_EQ(1u, recv_socket.recv(recv_batch, MSG_WAITFORONE));
+    EXPECT_EQ(2u, recv_batch.length(0));
+    EXPECT_NE(0, recv_batch.flags(0) & MSG_TRUNC);
+}
+
+TEST_F(send_recv_test, batch_recv_timeout)
+{
+    // Tests that MSG_WAITFORONE and a timeout return a partial batch
+
+    std::array<struct ::mmsghdr, 2> msgs {};
+    std::array<struct ::iovec, 2> buffers {{{&send_buf[0], 2}, {&send_buf[2], 3}}};
+    for (std::size_t i = 0; i < msgs.size(); ++i)
+    {
+        msgs[i].msg_hdr.msg_iov = &buffers[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto destination = linuxpp::net::make_sockaddr(receiver_addr, receiver_port);
+    ASSERT_EQ(0, ::connect(send_socket.descriptor(),
+                           reinterpret_cast<const struct ::sockaddr *>(&destination),
+                           sizeof(destination)));
+
+    ASSERT_EQ(msgs.size(), send_socket.send(msgs.data(), msgs.size()));
+    const auto events = epoll.wait(std::chrono::seconds{5});
+    ASSERT_FALSE(events.empty());
+
+    linuxpp::net::message_batch recv_batch {8, send_buf.size()};
+    const std::size_t messages_recv = recv_socket.recv(recv_batch,
+                                                       MSG_WAITFORONE,
+                                                       std::chrono::milliseconds {100});
+    ASSERT_EQ(msgs.size(), messages_recv);
+    EXPECT_EQ(2u, recv_batch.length(0));
+    EXPECT_EQ(3u, recv_batch.length(1));
+}
+
+TEST_F(send_recv_test, send_recv_segments)
+{
+    // Tests that a UDP_SEGMENT send is received as the original
+    // datagrams, whether or not the kernel coalesces them
+
+    constexpr std::size_t segment_size = 100;
+    constexpr std::size_t segment_count = 10;
+    std::array<unsigned char, segment_size * segment_count - 1> send_data;
+    for (std::size_t i = 0; i < send_data.size(); ++i)
+    {
+        send_data[i] = static_cast<unsigned char>(i / segment_size);
+    }
+
+    recv_socket.set_gro(true);
+    const std::size_t bytes_sent = send_socket.send_segments(send_data.data(),
+                                                             send_data.size(),
+                                                             segment_size,
+                                                             receiver_addr,
+                                                             receiver_port);
+    ASSERT_EQ(send_data.size(), bytes_sent);
+
+    std::array<unsigned char, 65536> recv_data;
+    std::size_t segments_recv = 0;
+    while (segments_recv < segment_count)
+    {
+        const auto events = epoll.wait(std::chrono::seconds{5});
+        ASSERT_FALSE(events.empty());
+
+        struct ::sockaddr_in sockaddr;
+        const linuxpp::net::udp_segments segments = recv_socket.recv_segments(recv_data.data(),
+                                                                              recv_data.size(),
+                                                                              sockaddr);
+
+        ndgpp::net::ipv4_address addr;
+        ndgpp::net::port port;
+        std::tie(addr, port) = linuxpp::net::parse_sockaddr(sockaddr);
+        EXPECT_EQ(sender_port, port);
+
+        for (const auto segment : segments)
+        {
+            const std::size_t expected_size = segments_recv == segment_count - 1 ? segment_size - 1 : segment_size;
+            ASSERT_EQ(expected_size, segment.size);
+            EXPECT_EQ(segments_recv, static_cast<unsigned char const *>(segment.data)[0]);
+            ++segments_recv;
+        }
+    }
+
+    EXPECT_EQ(segment_count, segments_recv);
+}
+
+static std::chrono::nanoseconds to_duration(const struct ::timespec & ts)
+{
+    return std::chrono::seconds {ts.tv_sec} + std::chrono::nanoseconds {ts.tv_nsec};
+}
+
+TEST_F(send_recv_test, recv_timestamp)
+{
+    // Tests that the kernel receive timestamp falls between the send
+    // and the receive
+
+    struct ::timespec timestamp = {};
+    send_socket.send(send_buf.data(), send_buf.size(), receiver_addr, receiver_port);
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+    recv_socket.recv(recv_buf.data(), recv_buf.size(), timestamp);
+    EXPECT_EQ(0, timestamp.tv_sec);
+    EXPECT_EQ(0, timestamp.tv_nsec);
+
+    recv_socket.set_timestamps(true);
+
+    struct ::timespec before;
+    ::clock_gettime(CLOCK_REALTIME, &before);
+    send_socket.send(send_buf.data(), send_buf.size(), receiver_addr, receiver_port);
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+
+    struct ::sockaddr_in sockaddr;
+    const std::size_t bytes_recv = recv_socket.recv(recv_buf.data(), recv_buf.size(), sockaddr, timestamp);
+    struct ::timespec after;
+    ::clock_gettime(CLOCK_REALTIME, &after);
+
+    ASSERT_EQ(send_buf.size(), bytes_recv);
+    EXPECT_EQ(send_buf, recv_buf);
+    EXPECT_LE(to_duration(before), to_duration(timestamp));
+    EXPECT_GE(to_duration(after), to_duration(timestamp));
+}
+
+TEST_F(send_recv_test, batch_recv_timestamp)
+{
+    // Tests per message timestamps in a message_batch
+
+    recv_socket.set_timestamps(true);
+
+    struct ::timespec before;
+    ::clock_gettime(CLOCK_REALTIME, &before);
+    send_socket.send(send_buf.data(), send_buf.size(), receiver_addr, receiver_port);
+    send_socket.send(send_buf.data(), send_buf.size(), receiver_addr, receiver_port);
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+
+    linuxpp::net::message_batch batch {4, send_buf.size(), linuxpp::net::timestamp_control_size};
+    const std::size_t messages_recv = recv_socket.recv(batch, MSG_WAITFORONE);
+    ASSERT_LE(1u, messages_recv);
+
+    for (std::size_t i = 0; i < messages_recv; ++i)
+    {
+        EXPECT_LE(to_duration(before), to_duration(batch.timestamp(i)));
+    }
+}
+
+TEST_F(send_recv_test, nothrow_recv_eagain)
+{
+    const auto ret = recv_socket.recv(std::nothrow, recv_buf.data(), recv_buf.size(), MSG_DONTWAIT);
+    EXPECT_TRUE(ret.fail());
+    EXPECT_EQ(EAGAIN, ret.errno_value());
+    EXPECT_EQ(-1, ret.return_value());
+}
+
+TEST_F(send_recv_test, nothrow_send_recv)
+{
+    const auto sent = send_socket.send(std::nothrow,
+                                       send_buf.data(),
+                                       send_buf.size(),
+                                       receiver_addr,
+                                       receiver_port);
+    ASSERT_TRUE(sent);
+    ASSERT_EQ(static_cast<::ssize_t>(send_buf.size()), sent.return_value());
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds{5}).empty());
+
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    const auto received = recv_socket.recv(std::nothrow, recv_buf.data(), recv_buf.size(), addr, port);
+    ASSERT_TRUE(received);
+    EXPECT_EQ(sent.return_value(), received.return_value());
+    EXPECT_EQ(send_buf, recv_buf);
+    EXPECT_EQ(sender_addr, addr);
+    EXPECT_EQ(sender_port, port);
+}
+
+TEST_F(send_recv_test, nothrow_batch_send_invalid_count)
+{
+    linuxpp::net::message_batch batch {2, 16};
+    const auto ret = send_socket.send(std::nothrow, batch, 3);
+    EXPECT_TRUE(ret.fail());
+    EXPECT_EQ(EINVAL, ret.errno_value());
+}
+
+TEST(udp_segments, iteration)
+{
+    const std::array<unsigned char, 10> data {{0, 0, 0, 1, 1, 1, 2, 2, 2, 3}};
+
+    const linuxpp::net::udp_segments segments {data.data(), data.size(), 3};
+    EXPECT_EQ(4u, segments.count());
+
+    std::size_t i = 0;
+    for (const auto segment : segments)
+    {
+        EXPECT_EQ(i == 3 ? 1u : 3u, segment.size);
+        EXPECT_EQ(i, static_cast<unsigned char const *>(segment.data)[0]);
+        ++i;
+    }
+
+    EXPECT_EQ(4u, i);
+
+    const linuxpp::net::udp_segments single {data.data(), data.size(), 0};
+    EXPECT_EQ(1u, single.count());
+    EXPECT_EQ(data.size(), (*single.begin()).size);
+
+    const linuxpp::net::udp_segments empty {data.data(), 0, 3};
+    EXPECT_EQ(0u, empty.count());
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(message_batch, invalid_sizes)
+{
+    EXPECT_THROW(linuxpp::net::message_batch(0, 1), std::invalid_argument);
+    EXPECT_THROW(linuxpp::net::message_batch(1, 0), std::invalid_argument);
+
+    linuxpp::net::message_batch batch {2, 16, 8};
+    EXPECT_THROW(batch.set_length(0, 17), std::invalid_argument);
+    EXPECT_THROW(batch.set_control_length(0, 9), std::invalid_argument);
+    EXPECT_NE(nullptr, batch.control(1));
+
+    linuxpp::net::udp_socket socket {AF_INET};
+    EXPECT_THROW(socket.send(batch, 3), std::invalid_argument);
+    EXPECT_THROW(socket.send_segments(batch.buffer(0), 16, 0, linuxpp::net::inaddr_loopback, ndgpp::net::port {9}),
+                 std::invalid_argument);
+}
+
+TEST(message_batch, control_alignment)
+{
+    linuxpp::net::message_batch batch {3, 16, 5};
+    EXPECT_EQ(CMSG_ALIGN(5), batch.control_size());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(batch.control(i)) % alignof(struct ::cmsghdr));
+        EXPECT_EQ(batch.control_size(), batch.data()[i].msg_hdr.msg_controllen);
+    }
+}
+
 struct join_group_test: public ::testing::Test
 {
     protected:
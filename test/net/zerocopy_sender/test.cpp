@@ -0,0 +1,152 @@
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <cstddef>
+
+#include <chrono>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <liblinuxpp/epoll.hpp>
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/net/connect.hpp>
+#include <liblinuxpp/net/ipv4_address.hpp>
+#include <liblinuxpp/net/recv.hpp>
+#include <liblinuxpp/net/socket.hpp>
+#include <liblinuxpp/net/tcp_socket.hpp>
+#include <liblinuxpp/net/udp_socket.hpp>
+#include <liblinuxpp/net/zerocopy_sender.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+
+struct tcp_zerocopy_test: public ::testing::Test
+{
+    protected:
+
+    tcp_zerocopy_test():
+        server {linuxpp::net::bind_socket, linuxpp::net::inaddr_loopback},
+        client {AF_INET}
+    {
+        server.listen(1);
+
+        ndgpp::net::ipv4_address addr;
+        ndgpp::net::port port;
+        std::tie(addr, port) = linuxpp::net::getsockname_ipv4(server.descriptor());
+        client.connect(addr, port);
+        accepted.reset(server.accept());
+    }
+
+    /// Reads length bytes from the accepted socket
+    void receive(const std::size_t length)
+    {
+        std::vector<char> buffer(length);
+        std::size_t received = 0;
+        while (received < length)
+        {
+            received += linuxpp::net::recv(accepted.get(), buffer.data() + received, length - received);
+        }
+    }
+
+    linuxpp::net::tcp_socket server;
+    linuxpp::net::tcp_socket client;
+    linuxpp::unique_fd<> accepted;
+};
+
+TEST_F(tcp_zerocopy_test, completion)
+{
+    linuxpp::net::zerocopy_sender sender {client.descriptor(), 4096};
+    EXPECT_EQ(4096u, sender.threshold());
+
+    std::vector<char> buffer(1 << 16, 'z');
+    int completions = 0;
+    const auto ret = sender.send(buffer.data(), buffer.size(), [&completions] (bool) { ++completions; });
+    ASSERT_TRUE(ret);
+    EXPECT_EQ(1u, sender.pending());
+    receive(static_cast<std::size_t>(ret.return_value()));
+
+    // The completion is queued on the error queue, which reports EPOLLERR
+    linuxpp::epoll epoll;
+    epoll.add(client.descriptor(), EPOLLERR);
+    ASSERT_FALSE(epoll.wait(std::chrono::seconds {5}).empty());
+
+    EXPECT_EQ(1u, sender.process_completions());
+    EXPECT_EQ(1, completions);
+    EXPECT_EQ(0u, sender.pending());
+    EXPECT_EQ(0u, sender.process_completions());
+}
+
+TEST_F(tcp_zerocopy_test, copy_below_threshold)
+{
+    linuxpp::net::zerocopy_sender sender {client.descriptor(), 4096};
+
+    std::vector<char> buffer(100, 'c');
+    bool copied = false;
+    const auto ret = sender.send(buffer.data(), buffer.size(), [&copied] (bool c) { copied = c; });
+    ASSERT_TRUE(ret);
+
+    // The handler is called before send returns
+    EXPECT_TRUE(copied);
+    EXPECT_EQ(0u, sender.pending());
+    receive(buffer.size());
+}
+
+TEST_F(tcp_zerocopy_test, many_sends)
+{
+    linuxpp::net::zerocopy_sender sender {client.descriptor(), 4096};
+
+    std::vector<char> buffer(8192, 'm');
+    int completions = 0;
+    std::size_t sent = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        const auto ret = sender.send(buffer.data(), buffer.size(), [&completions] (bool) { ++completions; });
+        ASSERT_TRUE(ret);
+        sent += static_cast<std::size_t>(ret.return_value());
+    }
+
+    receive(sent);
+
+    // Consecutive completions may be coalesced into one range
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+    while (sender.pending() != 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        sender.process_completions();
+        std::this_thread::sleep_for(std::chrono::milliseconds {1});
+    }
+
+    EXPECT_EQ(10, completions);
+}
+
+TEST(udp_zerocopy, ioloop)
+{
+    linuxpp::net::udp_socket receiver {AF_INET};
+    receiver.bind(linuxpp::net::inaddr_loopback);
+
+    ndgpp::net::ipv4_address addr;
+    ndgpp::net::port port;
+    std::tie(addr, port) = linuxpp::net::getsockname_ipv4(receiver.descriptor());
+
+    linuxpp::net::udp_socket sender_socket {AF_INET};
+    linuxpp::net::connect(sender_socket.descriptor(), addr, port);
+    linuxpp::net::zerocopy_sender sender {sender_socket.descriptor(), 1024};
+
+    linuxpp::ioloop loop;
+    sender.attach(loop);
+
+    std::vector<char> buffer(8192, 'u');
+    bool copied = false;
+    ASSERT_TRUE(sender.send(buffer.data(), buffer.size(), [&] (bool c) {
+        copied = c;
+        loop.stop();
+    }));
+
+    loop.start();
+    sender.detach();
+
+    // Loopback delivers a copy of the pages to the receiver
+    EXPECT_TRUE(copied);
+    EXPECT_EQ(0u, sender.pending());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <liblinuxpp/notifier.hpp>
+
+static bool readable(const int fd)
+{
+    pollfd pfd {fd, POLLIN, 0};
+    return ::poll(&pfd, 1, 0) == 1;
+}
+
+TEST(notifier, notify_without_waiter)
+{
+    linuxpp::notifier notifier;
+    EXPECT_FALSE(notifier.sleeping());
+    EXPECT_FALSE(notifier.notify());
+    EXPECT_FALSE(readable(notifier.fd()));
+    EXPECT_EQ(notifier.consume(), 0u);
+}
+
+TEST(notifier, notify_with_waiter)
+{
+    linuxpp::notifier notifier;
+    notifier.prepare_wait();
+    EXPECT_TRUE(notifier.sleeping());
+    EXPECT_TRUE(notifier.notify());
+
+    // The first notification hasn't been consumed, so the second
+    // one is coalesced with it
+    EXPECT_FALSE(notifier.notify());
+    EXPECT_TRUE(readable(notifier.fd()));
+    EXPECT_EQ(notifier.wait(), 1u);
+
+    // Once consumed, the next notification is written
+    EXPECT_TRUE(notifier.notify());
+    EXPECT_EQ(notifier.consume(), 1u);
+    notifier.finish_wait();
+
+    EXPECT_FALSE(notifier.sleeping());
+    EXPECT_FALSE(readable(notifier.fd()));
+}
+
+TEST(notifier, semaphore)
+{
+    linuxpp::notifier notifier {EFD_SEMAPHORE};
+    notifier.prepare_wait();
+    notifier.prepare_wait();
+    EXPECT_TRUE(notifier.notify());
+    EXPECT_TRUE(notifier.notify());
+
+    EXPECT_EQ(notifier.consume(), 1u);
+    notifier.finish_wait();
+    EXPECT_EQ(notifier.consume(), 1u);
+    notifier.finish_wait();
+    EXPECT_EQ(notifier.consume(), 0u);
+}
+
+TEST(notifier, threaded)
+{
+    constexpr unsigned int count = 100000;
+    linuxpp::notifier notifier;
+    std::atomic<unsigned int> produced {0};
+
+    std::thread producer([&] () {
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                produced.fetch_add(1, std::memory_order_relaxed);
+                notifier.notify();
+            }
+        });
+
+    // The consumer must never block while work is available, or the
+    // test would hang once the producer is done
+    unsigned int consumed = 0;
+    while (consumed < count)
+    {
+        notifier.prepare_wait();
+        if (produced.load(std::memory_order_relaxed) == consumed)
+        {
+            notifier.wait();
+        }
+
+        notifier.finish_wait();
+        consumed = produced.load(std::memory_order_relaxed);
+    }
+
+    producer.join();
+    EXPECT_EQ(consumed, count);
+}
@@ -0,0 +1,117 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cerrno>
+
+#include <array>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+#include <libndgpp/error.hpp>
+
+#include <liblinuxpp/pipe.hpp>
+#include <liblinuxpp/sendfile.hpp>
+#include <liblinuxpp/splice.hpp>
+#include <liblinuxpp/unique_fd.hpp>
+#include <liblinuxpp/write.hpp>
+
+namespace
+{
+    const std::string contents {"the quick brown fox jumps over the lazy dog"};
+
+    linuxpp::unique_fd<> make_file()
+    {
+        linuxpp::unique_fd<> fd {::memfd_create("liblinuxpp-splice-test", MFD_CLOEXEC)};
+        linuxpp::write(fd.get(), contents.data(), contents.size());
+        return fd;
+    }
+
+    std::string read_pipe(linuxpp::pipe & pipe, const std::size_t length)
+    {
+        std::string data(length, '\0');
+        EXPECT_EQ(length, pipe.read(&data[0], data.size()));
+        return data;
+    }
+}
+
+TEST(splice, file_to_pipe_with_offset)
+{
+    linuxpp::unique_fd<> file = ::make_file();
+    linuxpp::pipe pipe;
+
+    ::loff_t offset = 4;
+    EXPECT_EQ(5u, linuxpp::splice(file.get(), &offset, pipe.write_fd().get(), nullptr, 5));
+    EXPECT_EQ(9, offset);
+    EXPECT_EQ("quick", ::read_pipe(pipe, 5));
+}
+
+TEST(splice, pipe_to_pipe)
+{
+    linuxpp::pipe in;
+    linuxpp::pipe out;
+    in.write(contents.data(), contents.size());
+
+    EXPECT_EQ(contents.size(), linuxpp::splice(in, out.write_fd().get(), contents.size()));
+    EXPECT_EQ(contents, ::read_pipe(out, contents.size()));
+}
+
+TEST(splice, nothrow_eagain)
+{
+    linuxpp::pipe in {O_NONBLOCK};
+    linuxpp::pipe out {O_NONBLOCK};
+
+    const auto ret = linuxpp::splice(std::nothrow, in, out.write_fd().get(), 16, SPLICE_F_NONBLOCK);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(EAGAIN, ret.errno_value());
+
+    EXPECT_THROW(linuxpp::splice(in, out.write_fd().get(), 16, SPLICE_F_NONBLOCK),
+                 ndgpp::error<std::system_error>);
+}
+
+TEST(tee, duplicates)
+{
+    linuxpp::pipe in;
+    linuxpp::pipe out;
+    in.write(contents.data(), contents.size());
+
+    EXPECT_EQ(contents.size(), linuxpp::tee(in, out, contents.size()));
+
+    // The data is still in the input pipe
+    EXPECT_EQ(contents, ::read_pipe(out, contents.size()));
+    EXPECT_EQ(contents, ::read_pipe(in, contents.size()));
+}
+
+TEST(vmsplice, to_pipe)
+{
+    linuxpp::pipe pipe;
+    std::array<char, 3> first {{'a', 'b', 'c'}};
+    std::array<char, 2> second {{'d', 'e'}};
+    const std::array<struct ::iovec, 2> buffers {{{first.data(), first.size()},
+                                                  {second.data(), second.size()}}};
+
+    EXPECT_EQ(5u, linuxpp::vmsplice(pipe, buffers.data(), buffers.size()));
+    EXPECT_EQ("abcde", ::read_pipe(pipe, 5));
+}
+
+TEST(sendfile, file_to_pipe)
+{
+    linuxpp::unique_fd<> file = ::make_file();
+    linuxpp::pipe pipe;
+
+    ::off_t offset = 10;
+    EXPECT_EQ(contents.size() - 10, linuxpp::sendfile(pipe.write_fd().get(), file.get(), &offset, contents.size()));
+    EXPECT_EQ(static_cast<::off_t>(contents.size()), offset);
+    EXPECT_EQ(contents.substr(10), ::read_pipe(pipe, contents.size() - 10));
+}
+
+TEST(sendfile, nothrow_bad_descriptor)
+{
+    linuxpp::pipe pipe;
+    const auto ret = linuxpp::sendfile(std::nothrow, pipe.write_fd().get(), -1, nullptr, 1);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(EBADF, ret.errno_value());
+}
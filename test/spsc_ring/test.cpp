@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <liblinuxpp/spsc_ring.hpp>
+
+TEST(spsc_ring, zero_capacity)
+{
+    EXPECT_THROW(linuxpp::spsc_ring<int> {0}, ndgpp::error<std::invalid_argument>);
+}
+
+TEST(spsc_ring, capacity_rounded)
+{
+    linuxpp::spsc_ring<int> ring {5};
+    EXPECT_EQ(ring.capacity(), 8u);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(spsc_ring, push_pop)
+{
+    linuxpp::spsc_ring<int> ring {4};
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+
+    EXPECT_FALSE(ring.try_push(4));
+    EXPECT_EQ(ring.size(), 4u);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int value = -1;
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+
+    int value = -1;
+    EXPECT_FALSE(ring.try_pop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(spsc_ring, consume)
+{
+    linuxpp::spsc_ring<std::unique_ptr<int>> ring {8};
+    for (int i = 0; i < 6; ++i)
+    {
+        EXPECT_TRUE(ring.try_emplace(new int {i}));
+    }
+
+    std::vector<int> values;
+    const auto consumed = ring.consume([&values] (std::unique_ptr<int> & value) {
+            values.push_back(*value);
+        },
+        4);
+
+    EXPECT_EQ(consumed, 4u);
+    EXPECT_EQ(values, (std::vector<int> {0, 1, 2, 3}));
+    EXPECT_EQ(ring.size(), 2u);
+}
+
+TEST(spsc_ring, consume_throws)
+{
+    linuxpp::spsc_ring<int> ring {4};
+    ring.try_push(1);
+    ring.try_push(2);
+    ring.try_push(3);
+
+    EXPECT_THROW(ring.consume([] (int value) {
+                if (value == 2)
+                {
+                    throw std::runtime_error("test");
+                }
+            },
+            4),
+        std::runtime_error);
+
+    int value = 0;
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 3);
+}
+
+TEST(spsc_ring, threaded)
+{
+    constexpr std::size_t count = 1000000;
+    linuxpp::spsc_ring<std::size_t> ring {64};
+
+    std::thread producer([&ring] () {
+            for (std::size_t i = 0; i < count;)
+            {
+                if (ring.try_push(i))
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    std::size_t expected = 0;
+    bool in_order = true;
+    while (expected < count)
+    {
+        const auto consumed = ring.consume([&expected, &in_order] (std::size_t value) {
+                in_order = in_order && value == expected;
+                ++expected;
+            },
+            count);
+
+        if (consumed == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(ring.empty());
+}
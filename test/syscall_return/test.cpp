@@ -1,6 +1,7 @@
 #include <cerrno>
 
 #include <stdexcept>
+#include <system_error>
 
 #include <unistd.h>
 #include <gtest/gtest.h>
@@ -37,3 +38,21 @@ TEST(ctor, bad_errno)
     auto throws = [] () {linuxpp::syscall_return<int> {linuxpp::seterrno, 0};};
     EXPECT_THROW(throws(), ndgpp::error<std::logic_error>);
 }
+
+TEST(value_or_throw, good)
+{
+    EXPECT_EQ(3, linuxpp::value_or_throw(linuxpp::syscall_return<int> {3}, "failed"));
+}
+
+TEST(value_or_throw, fail)
+{
+    try
+    {
+        linuxpp::value_or_throw(linuxpp::syscall_return<int> {EAGAIN, -1}, "failed");
+        FAIL();
+    }
+    catch (const std::system_error & error)
+    {
+        EXPECT_EQ(EAGAIN, error.code().value());
+    }
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <liblinuxpp/ioloop.hpp>
+#include <liblinuxpp/thread_tuning.hpp>
+
+TEST(thread_tuning, nothing_requested)
+{
+    linuxpp::thread_tuning tuning;
+    const auto result = tuning.apply();
+    EXPECT_FALSE(result.affinity.requested);
+    EXPECT_FALSE(result.scheduler.requested);
+    EXPECT_FALSE(result.timer_slack.requested);
+    EXPECT_FALSE(result.memory_lock.requested);
+    EXPECT_FALSE(result.prefault.requested);
+    EXPECT_TRUE(result.all_applied());
+}
+
+TEST(thread_tuning, invalid_cpu)
+{
+    linuxpp::thread_tuning tuning;
+    EXPECT_THROW(tuning.set_affinity(std::vector<int> {-1}), ndgpp::error<std::invalid_argument>);
+}
+
+TEST(thread_tuning, affinity_and_timer_slack)
+{
+    std::thread thread([] () {
+            cpu_set_t current;
+            CPU_ZERO(&current);
+            ASSERT_EQ(::sched_getaffinity(0, sizeof(current), &current), 0);
+
+            int cpu = 0;
+            while (!CPU_ISSET(cpu, &current))
+            {
+                ++cpu;
+            }
+
+            linuxpp::thread_tuning tuning;
+            tuning.set_affinity(std::vector<int> {cpu});
+            tuning.set_timer_slack(std::chrono::nanoseconds {1000});
+
+            const auto result = tuning.apply();
+            EXPECT_TRUE(result.affinity.requested);
+            EXPECT_TRUE(result.affinity.applied);
+            EXPECT_TRUE(result.timer_slack.requested);
+            EXPECT_TRUE(result.timer_slack.applied);
+            EXPECT_EQ(::prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0), 1000);
+            EXPECT_TRUE(result.all_applied());
+        });
+
+    thread.join();
+}
+
+TEST(thread_tuning, scheduler)
+{
+    std::thread thread([] () {
+            linuxpp::thread_tuning tuning;
+            tuning.set_scheduler(SCHED_FIFO, 1);
+
+            // Real time scheduling may be refused, but the result
+            // must agree with the thread's actual policy
+            const auto result = tuning.apply();
+            EXPECT_TRUE(result.scheduler.requested);
+
+            int policy = 0;
+            sched_param param {};
+            ASSERT_EQ(::pthread_getschedparam(::pthread_self(), &policy, &param), 0);
+            EXPECT_EQ(result.scheduler.applied, policy == SCHED_FIFO);
+            EXPECT_EQ(result.scheduler.applied, result.scheduler.errno_value == 0);
+        });
+
+    thread.join();
+}
+
+TEST(thread_tuning, prefault)
+{
+    std::vector<char> buffer(1 << 20, 'a');
+
+    linuxpp::thread_tuning tuning;
+    tuning.set_stack_prefault(64 * 1024);
+    tuning.add_prefault_buffer(buffer.data(), buffer.size());
+
+    const auto result = tuning.apply();
+    EXPECT_TRUE(result.prefault.requested);
+    EXPECT_TRUE(result.prefault.applied);
+    EXPECT_EQ(buffer.front(), 'a');
+    EXPECT_EQ(buffer.back(), 'a');
+}
+
+TEST(thread_tuning, prefault_populates)
+{
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t size = 64 * page_size;
+    void * const buffer = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, buffer);
+
+    linuxpp::thread_tuning tuning;
+    tuning.add_prefault_buffer(buffer, size);
+    EXPECT_TRUE(tuning.apply().prefault.applied);
+
+    std::vector<unsigned char> resident(size / page_size);
+    ASSERT_EQ(0, ::mincore(buffer, size, resident.data()));
+    for (const unsigned char page : resident)
+    {
+        EXPECT_NE(0, page & 1);
+    }
+
+    ::munmap(buffer, size);
+}
+
+TEST(thread_tuning, memory_lock)
+{
+    linuxpp::thread_tuning tuning;
+    tuning.set_memory_lock(MCL_CURRENT);
+
+    const auto result = tuning.apply();
+    EXPECT_TRUE(result.memory_lock.requested);
+    EXPECT_EQ(result.memory_lock.applied, result.memory_lock.errno_value == 0);
+    ::munlockall();
+}
+
+TEST(thread_tuning, ioloop_start)
+{
+    linuxpp::ioloop ioloop;
+    linuxpp::thread_tuning tuning;
+    tuning.set_timer_slack(std::chrono::nanoseconds {2000});
+
+    std::promise<linuxpp::thread_tuning_result> result_promise;
+    std::thread thread([&] () {
+            ioloop.start(tuning, [&result_promise] (const linuxpp::thread_tuning_result & result) {
+                    result_promise.set_value(result);
+                });
+        });
+
+    auto future = result_promise.get_future();
+    const auto ret = future.wait_for(std::chrono::seconds{10});
+    ioloop.add_callback([&ioloop] () { ioloop.stop(); });
+    thread.join();
+
+    ASSERT_EQ(ret, std::future_status::ready);
+    const auto result = future.get();
+    EXPECT_TRUE(result.timer_slack.applied);
+}
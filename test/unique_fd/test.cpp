@@ -124,6 +124,16 @@ TEST(move, assignment)
     check_move(dst, src, 5);
 }
 
+TEST(move, assignment_closes_destination)
+{
+    test_closer assignment_closer;
+    linuxpp::unique_fd<test_closer&> src(5, assignment_closer);
+    linuxpp::unique_fd<test_closer&> dst(7, assignment_closer);
+    dst = std::move(src);
+    EXPECT_EQ(assignment_closer.check, 7);
+    check_move(dst, src, 5);
+}
+
 TEST_F(member_test, reset)
 {
     const int fd2_fd = fd2.get();